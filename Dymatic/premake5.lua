@@ -48,8 +48,7 @@ project "Dymatic"
 		"GLFW",
 		"Glad",
 		"ImGui",
-		"yaml-cpp",
-		"opengl32.lib"
+		"yaml-cpp"
 	}
 
 	filter "files:vendor/ImGuizmo/**.cpp"
@@ -62,6 +61,24 @@ project "Dymatic"
 		{
 		}
 
+		links
+		{
+			"opengl32.lib"
+		}
+
+		removefiles
+		{
+			"src/Platform/Linux/**"
+		}
+
+	filter "system:linux"
+		pic "On"
+
+		removefiles
+		{
+			"src/Platform/Windows/**"
+		}
+
 	filter "configurations:Debug"
 		defines "DY_DEBUG"
 		runtime "Debug"
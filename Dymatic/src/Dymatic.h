@@ -10,6 +10,8 @@
 #include "Dymatic/Core/Assert.h"
 
 #include "Dymatic/Core/Timestep.h"
+#include "Dymatic/Core/Timer.h"
+#include "Dymatic/Core/JobSystem.h"
 
 #include "Dymatic/Core/Input.h"
 #include "Dymatic/Core/KeyCodes.h"
@@ -18,20 +20,32 @@
 
 #include "Dymatic/ImGui/ImGuiLayer.h"
 
+#include "Dymatic/Asset/AssetManager.h"
+#include "Dymatic/Asset/TextureCooker.h"
+
 #include "Dymatic/Scene/Scene.h"
 #include "Dymatic/Scene/Entity.h"
 #include "Dymatic/Scene/ScriptableEntity.h"
 #include "Dymatic/Scene/Components.h"
+#include "Dymatic/Scene/Prefab.h"
+#include "Dymatic/Scene/SpriteGrid.h"
 
 // ---Renderer------------------------
 #include "Dymatic/Renderer/Renderer.h"
 #include "Dymatic/Renderer/Renderer2D.h"
 #include "Dymatic/Renderer/RenderCommand.h"
+#include "Dymatic/Renderer/GPUProfiler.h"
 
 #include "Dymatic/Renderer/Buffer.h"
+#include "Dymatic/Renderer/UniformBuffer.h"
+#include "Dymatic/Renderer/StorageBuffer.h"
 #include "Dymatic/Renderer/Shader.h"
 #include "Dymatic/Renderer/Framebuffer.h"
 #include "Dymatic/Renderer/Texture.h"
+#include "Dymatic/Renderer/SubTexture2D.h"
+#include "Dymatic/Renderer/TextureAtlas.h"
+#include "Dymatic/Renderer/ParticleSystem.h"
+#include "Dymatic/Renderer/GPUParticleSystem.h"
 #include "Dymatic/Renderer/VertexArray.h"
 
 #include "Dymatic/Renderer/OrthographicCamera.h"
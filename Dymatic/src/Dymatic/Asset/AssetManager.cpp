@@ -0,0 +1,362 @@
+#include "dypch.h"
+#include "Dymatic/Asset/AssetManager.h"
+
+#include <filesystem>
+
+namespace Dymatic {
+
+	struct AssetSlot
+	{
+		AssetType Type = AssetType::None;
+		uint32_t Generation = 1;
+		uint32_t RefCount = 0;
+		uint64_t LastUsed = 0;
+		uint64_t MemorySize = 0;
+
+		std::string Path;
+		Ref<Texture2D> TextureAsset;
+		Ref<Shader> ShaderAsset;
+
+		bool IsLoaded() const { return Type != AssetType::None; }
+
+		// The asset can go once no handle owns it and nobody else holds on to the Ref
+		bool IsUnused() const
+		{
+			switch (Type)
+			{
+			case AssetType::Texture2D: return RefCount == 0 && TextureAsset.use_count() == 1;
+			case AssetType::Shader:    return RefCount == 0 && ShaderAsset.use_count() == 1;
+			default:                   return false;
+			}
+		}
+	};
+
+	struct AssetManagerData
+	{
+		std::vector<AssetSlot> Slots;
+		std::vector<uint32_t> FreeSlots;
+		std::unordered_map<std::string, uint32_t> PathToSlot;
+
+		uint64_t MemoryBudget = 0;
+		uint64_t UseCounter = 0;
+
+		AssetManager::Statistics Stats;
+	};
+
+	static AssetManagerData* s_AssetData = nullptr;
+	static const std::string s_EmptyPath;
+
+	static std::string NormalizePath(const std::string& path)
+	{
+		return std::filesystem::path(path).lexically_normal().generic_string();
+	}
+
+	static AssetSlot* GetSlot(AssetHandle handle)
+	{
+		if (!s_AssetData || !handle.IsValid() || handle.Index >= s_AssetData->Slots.size())
+			return nullptr;
+
+		AssetSlot& slot = s_AssetData->Slots[handle.Index];
+		if (slot.Generation != handle.Generation || !slot.IsLoaded())
+			return nullptr;
+
+		return &slot;
+	}
+
+	static uint64_t EstimateTextureMemory(const Ref<Texture2D>& texture)
+	{
+		// Async loads report their size once uploaded
+		return texture->GetMemorySize();
+	}
+
+	static void EvictSlot(uint32_t index)
+	{
+		AssetSlot& slot = s_AssetData->Slots[index];
+
+		s_AssetData->PathToSlot.erase(slot.Path);
+		s_AssetData->Stats.MemoryUsage -= slot.MemorySize;
+		s_AssetData->Stats.AssetCount--;
+		s_AssetData->Stats.Evictions++;
+
+		slot.Type = AssetType::None;
+		slot.Generation++;
+		slot.RefCount = 0;
+		slot.MemorySize = 0;
+		slot.Path.clear();
+		slot.TextureAsset = nullptr;
+		slot.ShaderAsset = nullptr;
+
+		s_AssetData->FreeSlots.push_back(index);
+	}
+
+	// Returns the slot of an already loaded asset and marks it as used, or UINT32_MAX
+	static uint32_t FindCached(const std::string& key, AssetType type)
+	{
+		auto it = s_AssetData->PathToSlot.find(key);
+		if (it == s_AssetData->PathToSlot.end())
+			return UINT32_MAX;
+
+		AssetSlot& slot = s_AssetData->Slots[it->second];
+		DY_CORE_ASSERT(slot.Type == type, "Asset was already loaded as a different type!");
+
+		slot.LastUsed = ++s_AssetData->UseCounter;
+		s_AssetData->Stats.CacheHits++;
+		return it->second;
+	}
+
+	static uint32_t AllocateSlot(const std::string& key, AssetType type)
+	{
+		uint32_t index;
+		if (!s_AssetData->FreeSlots.empty())
+		{
+			index = s_AssetData->FreeSlots.back();
+			s_AssetData->FreeSlots.pop_back();
+		}
+		else
+		{
+			index = (uint32_t)s_AssetData->Slots.size();
+			s_AssetData->Slots.emplace_back();
+		}
+
+		AssetSlot& slot = s_AssetData->Slots[index];
+		slot.Type = type;
+		slot.RefCount = 0;
+		slot.MemorySize = 0;
+		slot.Path = key;
+		slot.LastUsed = ++s_AssetData->UseCounter;
+
+		s_AssetData->PathToSlot[key] = index;
+		s_AssetData->Stats.Loads++;
+		s_AssetData->Stats.AssetCount++;
+		return index;
+	}
+
+	// Callers take ownership of the slot before collecting garbage, a fresh slot is unused and would be evicted right away
+	static uint32_t LoadTextureSlot(const std::string& path, bool async)
+	{
+		DY_CORE_ASSERT(s_AssetData, "AssetManager not initialized!");
+
+		std::string key = NormalizePath(path);
+		uint32_t index = FindCached(key, AssetType::Texture2D);
+		if (index != UINT32_MAX)
+			return index;
+
+		index = AllocateSlot(key, AssetType::Texture2D);
+		AssetSlot& slot = s_AssetData->Slots[index];
+		if (async)
+		{
+			// The handle finds the slot directly, and goes stale if the slot was evicted meanwhile
+			AssetHandle handle = { index, slot.Generation };
+			slot.TextureAsset = Texture2D::CreateAsync(key, [handle](const Ref<Texture2D>& loaded)
+			{
+				// Account for the memory once the size is known
+				AssetSlot* loadedSlot = GetSlot(handle);
+				if (!loadedSlot || loadedSlot->TextureAsset != loaded)
+					return;
+
+				loadedSlot->MemorySize = EstimateTextureMemory(loaded);
+				s_AssetData->Stats.MemoryUsage += loadedSlot->MemorySize;
+				AssetManager::CollectGarbage();
+			});
+		}
+		else
+		{
+			slot.TextureAsset = Texture2D::Create(key);
+			slot.MemorySize = EstimateTextureMemory(slot.TextureAsset);
+			s_AssetData->Stats.MemoryUsage += slot.MemorySize;
+		}
+
+		return index;
+	}
+
+	static uint32_t LoadShaderSlot(const std::string& path)
+	{
+		DY_CORE_ASSERT(s_AssetData, "AssetManager not initialized!");
+
+		std::string key = NormalizePath(path);
+		uint32_t index = FindCached(key, AssetType::Shader);
+		if (index != UINT32_MAX)
+			return index;
+
+		Ref<Shader> shader = Shader::Create(key);
+
+		index = AllocateSlot(key, AssetType::Shader);
+		s_AssetData->Slots[index].ShaderAsset = shader;
+		return index;
+	}
+
+	void AssetManager::Init(uint64_t memoryBudget)
+	{
+		DY_PROFILE_FUNCTION();
+
+		s_AssetData = new AssetManagerData();
+		s_AssetData->MemoryBudget = memoryBudget;
+	}
+
+	void AssetManager::Shutdown()
+	{
+		DY_PROFILE_FUNCTION();
+
+		delete s_AssetData;
+		s_AssetData = nullptr;
+	}
+
+	AssetHandle AssetManager::LoadTexture(const std::string& path, bool async)
+	{
+		DY_PROFILE_FUNCTION();
+
+		uint32_t index = LoadTextureSlot(path, async);
+		AssetSlot& slot = s_AssetData->Slots[index];
+		slot.RefCount++;
+		AssetHandle handle = { index, slot.Generation };
+
+		CollectGarbage();
+		return handle;
+	}
+
+	AssetHandle AssetManager::LoadShader(const std::string& path)
+	{
+		DY_PROFILE_FUNCTION();
+
+		uint32_t index = LoadShaderSlot(path);
+		AssetSlot& slot = s_AssetData->Slots[index];
+		slot.RefCount++;
+		return { index, slot.Generation };
+	}
+
+	void AssetManager::Acquire(AssetHandle handle)
+	{
+		AssetSlot* slot = GetSlot(handle);
+		DY_CORE_ASSERT(slot, "Invalid asset handle!");
+		slot->RefCount++;
+	}
+
+	void AssetManager::Release(AssetHandle handle)
+	{
+		AssetSlot* slot = GetSlot(handle);
+		if (!slot)
+			return;
+
+		DY_CORE_ASSERT(slot->RefCount > 0, "Asset released more often than acquired!");
+		if (--slot->RefCount == 0 && s_AssetData->Stats.MemoryUsage > s_AssetData->MemoryBudget)
+			CollectGarbage();
+	}
+
+	bool AssetManager::IsValid(AssetHandle handle)
+	{
+		return GetSlot(handle) != nullptr;
+	}
+
+	AssetType AssetManager::GetType(AssetHandle handle)
+	{
+		AssetSlot* slot = GetSlot(handle);
+		return slot ? slot->Type : AssetType::None;
+	}
+
+	const std::string& AssetManager::GetPath(AssetHandle handle)
+	{
+		AssetSlot* slot = GetSlot(handle);
+		return slot ? slot->Path : s_EmptyPath;
+	}
+
+	Ref<Texture2D> AssetManager::GetTexture(AssetHandle handle)
+	{
+		AssetSlot* slot = GetSlot(handle);
+		if (!slot || slot->Type != AssetType::Texture2D)
+			return nullptr;
+
+		slot->LastUsed = ++s_AssetData->UseCounter;
+		return slot->TextureAsset;
+	}
+
+	Ref<Shader> AssetManager::GetShader(AssetHandle handle)
+	{
+		AssetSlot* slot = GetSlot(handle);
+		if (!slot || slot->Type != AssetType::Shader)
+			return nullptr;
+
+		slot->LastUsed = ++s_AssetData->UseCounter;
+		return slot->ShaderAsset;
+	}
+
+	Ref<Texture2D> AssetManager::GetTexture(const std::string& path, bool async)
+	{
+		DY_PROFILE_FUNCTION();
+
+		Ref<Texture2D> texture = s_AssetData->Slots[LoadTextureSlot(path, async)].TextureAsset;
+		CollectGarbage();
+		return texture;
+	}
+
+	Ref<Shader> AssetManager::GetShader(const std::string& path)
+	{
+		DY_PROFILE_FUNCTION();
+
+		return s_AssetData->Slots[LoadShaderSlot(path)].ShaderAsset;
+	}
+
+	void AssetManager::SetMemoryBudget(uint64_t bytes)
+	{
+		s_AssetData->MemoryBudget = bytes;
+		CollectGarbage();
+	}
+
+	uint64_t AssetManager::GetMemoryBudget()
+	{
+		return s_AssetData->MemoryBudget;
+	}
+
+	void AssetManager::CollectGarbage()
+	{
+		if (!s_AssetData || s_AssetData->Stats.MemoryUsage <= s_AssetData->MemoryBudget)
+			return;
+
+		DY_PROFILE_FUNCTION();
+
+		std::vector<uint32_t> candidates;
+		for (uint32_t i = 0; i < s_AssetData->Slots.size(); i++)
+		{
+			if (s_AssetData->Slots[i].IsUnused())
+				candidates.push_back(i);
+		}
+
+		std::sort(candidates.begin(), candidates.end(), [](uint32_t a, uint32_t b)
+		{
+			return s_AssetData->Slots[a].LastUsed < s_AssetData->Slots[b].LastUsed;
+		});
+
+		for (uint32_t index : candidates)
+		{
+			if (s_AssetData->Stats.MemoryUsage <= s_AssetData->MemoryBudget)
+				break;
+			EvictSlot(index);
+		}
+
+		if (s_AssetData->Stats.MemoryUsage > s_AssetData->MemoryBudget)
+			DY_CORE_WARN("Asset memory usage ({0} bytes) exceeds the budget ({1} bytes)", s_AssetData->Stats.MemoryUsage, s_AssetData->MemoryBudget);
+	}
+
+	void AssetManager::UnloadUnused()
+	{
+		DY_PROFILE_FUNCTION();
+
+		for (uint32_t i = 0; i < s_AssetData->Slots.size(); i++)
+		{
+			if (s_AssetData->Slots[i].IsUnused())
+				EvictSlot(i);
+		}
+	}
+
+	AssetManager::Statistics AssetManager::GetStats()
+	{
+		return s_AssetData->Stats;
+	}
+
+	void AssetManager::ResetStats()
+	{
+		s_AssetData->Stats.Loads = 0;
+		s_AssetData->Stats.CacheHits = 0;
+		s_AssetData->Stats.Evictions = 0;
+	}
+
+}
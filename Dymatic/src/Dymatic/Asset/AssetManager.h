@@ -0,0 +1,93 @@
+#pragma once
+
+#include "Dymatic/Core/Base.h"
+#include "Dymatic/Renderer/Texture.h"
+#include "Dymatic/Renderer/Shader.h"
+
+#include <string>
+
+namespace Dymatic {
+
+	enum class AssetType : uint8_t
+	{
+		None = 0, Texture2D, Shader
+	};
+
+	// Lightweight reference to an asset owned by the AssetManager.
+	// Handles are compared by value; a handle to an evicted asset is never reused
+	// because its slot generation has moved on.
+	struct AssetHandle
+	{
+		uint32_t Index = 0;
+		uint32_t Generation = 0;
+
+		bool IsValid() const { return Generation != 0; }
+		operator bool() const { return IsValid(); }
+
+		bool operator==(const AssetHandle& other) const { return Index == other.Index && Generation == other.Generation; }
+		bool operator!=(const AssetHandle& other) const { return !(*this == other); }
+	};
+
+	// Loads assets by path, deduplicates them and keeps track of how many owners each one has.
+	// Assets without owners stay cached and are only evicted (least recently used first)
+	// once the memory budget is exceeded. Must only be used from the main thread.
+	class AssetManager
+	{
+	public:
+		struct Statistics
+		{
+			uint32_t Loads = 0;
+			uint32_t CacheHits = 0;
+			uint32_t Evictions = 0;
+
+			uint32_t AssetCount = 0;
+			uint64_t MemoryUsage = 0;
+		};
+	public:
+		static void Init(uint64_t memoryBudget = 512ull * 1024 * 1024);
+		static void Shutdown();
+
+		// Each Load adds an owner to the returned handle, balance it with Release
+		static AssetHandle LoadTexture(const std::string& path, bool async = false);
+		static AssetHandle LoadShader(const std::string& path);
+
+		static void Acquire(AssetHandle handle);
+		static void Release(AssetHandle handle);
+
+		static bool IsValid(AssetHandle handle);
+		static AssetType GetType(AssetHandle handle);
+		static const std::string& GetPath(AssetHandle handle);
+
+		static Ref<Texture2D> GetTexture(AssetHandle handle);
+		static Ref<Shader> GetShader(AssetHandle handle);
+
+		// Shortcuts for callers that keep the Ref alive themselves; the asset is shared
+		// with every other load of the same path but does not count as an owner
+		static Ref<Texture2D> GetTexture(const std::string& path, bool async = false);
+		static Ref<Shader> GetShader(const std::string& path);
+
+		static void SetMemoryBudget(uint64_t bytes);
+		static uint64_t GetMemoryBudget();
+
+		// Evicts unowned assets until memory usage fits the budget
+		static void CollectGarbage();
+		static void UnloadUnused();
+
+		static Statistics GetStats();
+		static void ResetStats();
+	};
+
+}
+
+namespace std {
+
+	template<>
+	struct hash<Dymatic::AssetHandle>
+	{
+		std::size_t operator()(const Dymatic::AssetHandle& handle) const
+		{
+			return hash<uint64_t>()(((uint64_t)handle.Generation << 32) | handle.Index);
+		}
+	};
+
+}
@@ -0,0 +1,293 @@
+#include "dypch.h"
+#include "Dymatic/Asset/TextureCooker.h"
+
+#include <stb_image.h>
+#include <glm/glm.hpp>
+
+#include <filesystem>
+#include <fstream>
+#include <climits>
+
+namespace Dymatic {
+
+	namespace Utils {
+
+		struct Color565
+		{
+			uint16_t Packed;
+			glm::ivec3 Expanded;
+		};
+
+		static Color565 PackColor565(const glm::ivec3& color)
+		{
+			int r = (color.r * 31 + 127) / 255, g = (color.g * 63 + 127) / 255, b = (color.b * 31 + 127) / 255;
+			Color565 result;
+			result.Packed = (uint16_t)((r << 11) | (g << 5) | b);
+			result.Expanded = { (r << 3) | (r >> 2), (g << 2) | (g >> 4), (b << 3) | (b >> 2) };
+			return result;
+		}
+
+		// Bounding box endpoints inset by 1/16 of the range, then nearest palette entry per pixel
+		static void EncodeColorBlock(const uint8_t block[16][4], uint8_t* output)
+		{
+			glm::ivec3 min(255), max(0);
+			for (int i = 0; i < 16; i++)
+			{
+				glm::ivec3 color(block[i][0], block[i][1], block[i][2]);
+				min = glm::min(min, color);
+				max = glm::max(max, color);
+			}
+
+			glm::ivec3 inset = (max - min) / 16;
+			Color565 color0 = PackColor565(glm::clamp(max - inset, 0, 255));
+			Color565 color1 = PackColor565(glm::clamp(min + inset, 0, 255));
+			if (color0.Packed < color1.Packed)
+				std::swap(color0, color1);
+
+			glm::ivec3 palette[4] = {
+				color0.Expanded,
+				color1.Expanded,
+				(color0.Expanded * 2 + color1.Expanded) / 3,
+				(color0.Expanded + color1.Expanded * 2) / 3
+			};
+
+			uint32_t indices = 0;
+			if (color0.Packed != color1.Packed)
+			{
+				for (int i = 0; i < 16; i++)
+				{
+					glm::ivec3 color(block[i][0], block[i][1], block[i][2]);
+					int bestIndex = 0, bestDistance = INT_MAX;
+					for (int p = 0; p < 4; p++)
+					{
+						glm::ivec3 delta = color - palette[p];
+						int distance = delta.x * delta.x + delta.y * delta.y + delta.z * delta.z;
+						if (distance < bestDistance)
+						{
+							bestDistance = distance;
+							bestIndex = p;
+						}
+					}
+					indices |= bestIndex << (i * 2);
+				}
+			}
+
+			output[0] = color0.Packed & 0xff;
+			output[1] = color0.Packed >> 8;
+			output[2] = color1.Packed & 0xff;
+			output[3] = color1.Packed >> 8;
+			memcpy(output + 4, &indices, 4);
+		}
+
+		static void EncodeAlphaBlock(const uint8_t block[16][4], uint8_t* output)
+		{
+			int min = 255, max = 0;
+			for (int i = 0; i < 16; i++)
+			{
+				min = std::min(min, (int)block[i][3]);
+				max = std::max(max, (int)block[i][3]);
+			}
+
+			// 8 value mode: alpha0 > alpha1
+			int palette[8] = { max, min };
+			for (int i = 1; i < 7; i++)
+				palette[i + 1] = ((7 - i) * max + i * min) / 7;
+
+			uint64_t indices = 0;
+			if (max != min)
+			{
+				for (int i = 0; i < 16; i++)
+				{
+					int bestIndex = 0, bestDistance = INT_MAX;
+					for (int p = 0; p < 8; p++)
+					{
+						int distance = std::abs(block[i][3] - palette[p]);
+						if (distance < bestDistance)
+						{
+							bestDistance = distance;
+							bestIndex = p;
+						}
+					}
+					indices |= (uint64_t)bestIndex << (i * 3);
+				}
+			}
+
+			output[0] = (uint8_t)max;
+			output[1] = (uint8_t)min;
+			for (int i = 0; i < 6; i++)
+				output[2 + i] = (uint8_t)(indices >> (i * 8));
+		}
+
+		static void CompressLevel(const uint8_t* pixels, uint32_t width, uint32_t height, bool alpha, std::vector<uint8_t>& output)
+		{
+			const uint32_t blockSize = alpha ? 16 : 8;
+			uint8_t block[16][4];
+			for (uint32_t by = 0; by < height; by += 4)
+			{
+				for (uint32_t bx = 0; bx < width; bx += 4)
+				{
+					// Edge blocks repeat the last row/column
+					for (uint32_t y = 0; y < 4; y++)
+					{
+						for (uint32_t x = 0; x < 4; x++)
+						{
+							uint32_t sx = std::min(bx + x, width - 1), sy = std::min(by + y, height - 1);
+							memcpy(block[y * 4 + x], pixels + ((size_t)sy * width + sx) * 4, 4);
+						}
+					}
+
+					size_t offset = output.size();
+					output.resize(offset + blockSize);
+					if (alpha)
+					{
+						EncodeAlphaBlock(block, output.data() + offset);
+						EncodeColorBlock(block, output.data() + offset + 8);
+					}
+					else
+					{
+						EncodeColorBlock(block, output.data() + offset);
+					}
+				}
+			}
+		}
+
+		// 2x2 box filter, odd edges reuse the last row/column
+		static std::vector<uint8_t> Downsample(const std::vector<uint8_t>& pixels, uint32_t width, uint32_t height)
+		{
+			uint32_t newWidth = std::max(width / 2, 1u), newHeight = std::max(height / 2, 1u);
+			std::vector<uint8_t> result((size_t)newWidth * newHeight * 4);
+			for (uint32_t y = 0; y < newHeight; y++)
+			{
+				uint32_t y0 = std::min(y * 2, height - 1), y1 = std::min(y * 2 + 1, height - 1);
+				for (uint32_t x = 0; x < newWidth; x++)
+				{
+					uint32_t x0 = std::min(x * 2, width - 1), x1 = std::min(x * 2 + 1, width - 1);
+					for (uint32_t c = 0; c < 4; c++)
+					{
+						uint32_t sum = pixels[((size_t)y0 * width + x0) * 4 + c] + pixels[((size_t)y0 * width + x1) * 4 + c]
+							+ pixels[((size_t)y1 * width + x0) * 4 + c] + pixels[((size_t)y1 * width + x1) * 4 + c];
+						result[((size_t)y * newWidth + x) * 4 + c] = (uint8_t)((sum + 2) / 4);
+					}
+				}
+			}
+			return result;
+		}
+
+		static void WriteU32(std::ofstream& out, uint32_t value)
+		{
+			out.write((const char*)&value, sizeof(uint32_t));
+		}
+
+		static void WriteDDSHeader(std::ofstream& out, uint32_t width, uint32_t height, uint32_t mipCount, bool alpha, uint32_t topLevelSize)
+		{
+			const uint32_t DDSD_CAPS = 0x1, DDSD_HEIGHT = 0x2, DDSD_WIDTH = 0x4, DDSD_PIXELFORMAT = 0x1000, DDSD_MIPMAPCOUNT = 0x20000, DDSD_LINEARSIZE = 0x80000;
+			const uint32_t DDSCAPS_COMPLEX = 0x8, DDSCAPS_TEXTURE = 0x1000, DDSCAPS_MIPMAP = 0x400000;
+			const uint32_t DDPF_FOURCC = 0x4;
+
+			out.write("DDS ", 4);
+			WriteU32(out, 124);
+			WriteU32(out, DDSD_CAPS | DDSD_HEIGHT | DDSD_WIDTH | DDSD_PIXELFORMAT | DDSD_MIPMAPCOUNT | DDSD_LINEARSIZE);
+			WriteU32(out, height);
+			WriteU32(out, width);
+			WriteU32(out, topLevelSize);
+			WriteU32(out, 0); // Depth
+			WriteU32(out, mipCount);
+
+			// dwReserved1, tools put their tag here. Ours tells the loader rows are already bottom-up.
+			out.write("DYBU", 4);
+			for (int i = 0; i < 10; i++)
+				WriteU32(out, 0);
+
+			// DDS_PIXELFORMAT
+			WriteU32(out, 32);
+			WriteU32(out, DDPF_FOURCC);
+			out.write(alpha ? "DXT5" : "DXT1", 4);
+			for (int i = 0; i < 5; i++)
+				WriteU32(out, 0);
+
+			WriteU32(out, DDSCAPS_TEXTURE | (mipCount > 1 ? DDSCAPS_COMPLEX | DDSCAPS_MIPMAP : 0));
+			for (int i = 0; i < 4; i++)
+				WriteU32(out, 0);
+		}
+
+	}
+
+	bool TextureCooker::Cook(const std::string& sourcePath, const std::string& outputPath, TextureCookFormat format, bool generateMips)
+	{
+		DY_PROFILE_FUNCTION();
+
+		// Flipped like the runtime loader, so cooked rows are stored bottom-up and the header says so
+		int width, height, channels;
+		stbi_set_flip_vertically_on_load_thread(1);
+		stbi_uc* data = stbi_load(sourcePath.c_str(), &width, &height, &channels, 4);
+		if (!data)
+		{
+			DY_CORE_ERROR("Failed to load image '{0}'", sourcePath);
+			return false;
+		}
+
+		std::vector<uint8_t> pixels(data, data + (size_t)width * height * 4);
+		stbi_image_free(data);
+
+		bool alpha = format == TextureCookFormat::BC3;
+		if (format == TextureCookFormat::Auto)
+		{
+			for (size_t i = 3; i < pixels.size() && !alpha; i += 4)
+				alpha = pixels[i] != 255;
+		}
+
+		std::vector<uint8_t> compressed;
+		uint32_t levelWidth = width, levelHeight = height;
+		uint32_t mipCount = 0, topLevelSize = 0;
+		while (true)
+		{
+			Utils::CompressLevel(pixels.data(), levelWidth, levelHeight, alpha, compressed);
+			if (mipCount++ == 0)
+				topLevelSize = (uint32_t)compressed.size();
+
+			if (!generateMips || (levelWidth == 1 && levelHeight == 1))
+				break;
+
+			pixels = Utils::Downsample(pixels, levelWidth, levelHeight);
+			levelWidth = std::max(levelWidth / 2, 1u);
+			levelHeight = std::max(levelHeight / 2, 1u);
+		}
+
+		std::ofstream out(outputPath, std::ios::out | std::ios::binary);
+		if (!out)
+		{
+			DY_CORE_ERROR("Could not open file '{0}'", outputPath);
+			return false;
+		}
+
+		Utils::WriteDDSHeader(out, width, height, mipCount, alpha, topLevelSize);
+		out.write((const char*)compressed.data(), compressed.size());
+
+		DY_CORE_INFO("Cooked '{0}' -> '{1}' ({2}, {3} mips, {4} KB)", sourcePath, outputPath, alpha ? "BC3" : "BC1", mipCount, compressed.size() / 1024);
+		return true;
+	}
+
+	uint32_t TextureCooker::CookDirectory(const std::string& directory, TextureCookFormat format, bool generateMips)
+	{
+		DY_PROFILE_FUNCTION();
+
+		uint32_t count = 0;
+		for (auto& entry : std::filesystem::recursive_directory_iterator(directory))
+		{
+			if (!entry.is_regular_file() || entry.path().extension() != ".png")
+				continue;
+
+			std::filesystem::path output = entry.path();
+			output.replace_extension(".dds");
+
+			std::error_code error;
+			if (std::filesystem::exists(output) && std::filesystem::last_write_time(output, error) >= entry.last_write_time())
+				continue;
+
+			if (Cook(entry.path().string(), output.string(), format, generateMips))
+				count++;
+		}
+		return count;
+	}
+
+}
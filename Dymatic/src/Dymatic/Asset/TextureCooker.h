@@ -0,0 +1,27 @@
+#pragma once
+
+#include <string>
+
+namespace Dymatic {
+
+	enum class TextureCookFormat
+	{
+		Auto = 0, // BC3 if the image has any transparency, BC1 otherwise
+		BC1,
+		BC3
+	};
+
+	// Offline conversion of source images (PNG, JPG, ...) into block compressed DDS files with a
+	// box filtered mip chain. Rows are written bottom-up and the file is tagged as such, so the
+	// loader does not need to flip it. BC7 is not written here.
+	class TextureCooker
+	{
+	public:
+		static bool Cook(const std::string& sourcePath, const std::string& outputPath, TextureCookFormat format = TextureCookFormat::Auto, bool generateMips = true);
+
+		// Cooks every .png next to itself as .dds, skipping files whose output is newer than the source.
+		// Returns the number of files written.
+		static uint32_t CookDirectory(const std::string& directory, TextureCookFormat format = TextureCookFormat::Auto, bool generateMips = true);
+	};
+
+}
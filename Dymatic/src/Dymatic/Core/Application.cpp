@@ -4,15 +4,22 @@
 #include "Dymatic/Core/Log.h"
 
 #include "Dymatic/Renderer/Renderer.h"
+#include "Dymatic/Core/JobSystem.h"
+#include "Dymatic/Asset/AssetManager.h"
 
 #include "Dymatic/Core/Input.h"
 
-#include <GLFW/glfw3.h>
+#include "Dymatic/Utils/PlatformUtils.h"
 
 namespace Dymatic {
 
 	Application* Application::s_Instance = nullptr;
 
+	// Idle render on demand loops still wake up this often, for work that raises no window event
+	// like shader hot reload. Input gets a few frames since ImGui reacts to some of it a frame late.
+	static const double s_IdleTimeout = 0.5;
+	static const uint32_t s_FramesPerWakeUp = 3;
+
 	Application::Application(const std::string& name)
 	{
 		DY_PROFILE_FUNCTION();
@@ -20,9 +27,14 @@ namespace Dymatic {
 		DY_CORE_ASSERT(!s_Instance, "Application already exists!");
 		s_Instance = this;
 		m_Window = Window::Create(WindowProps(name));
-		m_Window->SetEventCallback(DY_BIND_EVENT_FN(Application::OnEvent));
+		m_Window->SetEventQueue(&m_EventQueue);
+
+		m_EventHandlers.Bind<WindowCloseEvent, &Application::OnWindowClose>(this);
+		m_EventHandlers.Bind<WindowResizeEvent, &Application::OnWindowResize>(this);
 
+		JobSystem::Init();
 		Renderer::Init();
+		AssetManager::Init();
 
 		m_ImGuiLayer = new ImGuiLayer();
 		PushOverlay(m_ImGuiLayer);
@@ -32,6 +44,8 @@ namespace Dymatic {
 	{
 		DY_PROFILE_FUNCTION();
 
+		JobSystem::Shutdown();
+		AssetManager::Shutdown();
 		Renderer::Shutdown();
 	}
 
@@ -56,34 +70,73 @@ namespace Dymatic {
 		m_Running = false;
 	}
 
-	void Application::OnEvent(Event& e)
+	template<typename T>
+	void Application::OnEvent(T& e)
 	{
-		DY_PROFILE_FUNCTION();
-
-		EventDispatcher dispatcher(e);
-		dispatcher.Dispatch<WindowCloseEvent>(DY_BIND_EVENT_FN(Application::OnWindowClose));
-		dispatcher.Dispatch<WindowResizeEvent>(DY_BIND_EVENT_FN(Application::OnWindowResize));
+		m_EventHandlers.Dispatch(e);
 
 		for (auto it = m_LayerStack.rbegin(); it != m_LayerStack.rend(); ++it)
 		{
 			if (e.Handled)
 				break;
-			(*it)->OnEvent(e);
+
+			EventHandlerTable& handlers = (*it)->GetEventHandlers();
+			if (handlers.IsEmpty())
+				(*it)->OnEvent(e);
+			else
+				handlers.Dispatch(e);
 		}
 	}
 
+	void Application::ProcessEvents()
+	{
+		DY_PROFILE_FUNCTION();
+
+		// Input sees every event, even ones a layer marks as handled, and is current before any handler runs
+		Input::BeginFrame();
+		m_EventQueue.ForEach([](const auto& e) { Input::OnEvent(e); });
+		Input::PublishSnapshot();
+
+		// Everything the window collected during the last poll, in one pass over the layer stack per event
+		m_EventQueue.Dispatch([this](auto& e) { OnEvent(e); });
+	}
+
+	void Application::WaitForEvents()
+	{
+		DY_PROFILE_FUNCTION();
+
+		double start = Time::GetTime();
+		m_Window->WaitEvents(s_IdleTimeout);
+		double time = Time::GetTime();
+
+		// Time spent asleep is not part of the next timestep
+		m_LastFrameTime = time;
+		m_RequestedFrames = time - start < s_IdleTimeout ? s_FramesPerWakeUp : 1;
+	}
+
 	void Application::Run()
 	{
 		DY_PROFILE_FUNCTION();
 
+		m_LastFrameTime = Time::GetTime();
 		while (m_Running)
 		{
 			DY_PROFILE_SCOPE("RunLoop");
 
-			float time = (float)glfwGetTime();
-			Timestep timestep = time - m_LastFrameTime;
+			if (m_RenderOnDemand)
+			{
+				if (m_RequestedFrames == 0)
+					WaitForEvents();
+				m_RequestedFrames--;
+			}
+
+			double time = Time::GetTime();
+			Timestep timestep = (float)(time - m_LastFrameTime);
 			m_LastFrameTime = time;
 
+			ProcessEvents();
+			Renderer::BeginFrame();
+
 			if (!m_Minimized)
 			{
 				{
@@ -6,6 +6,7 @@
 #include "Dymatic/Core/LayerStack.h"
 #include "Dymatic/Events/Event.h"
 #include "Dymatic/Events/ApplicationEvent.h"
+#include "Dymatic/Events/EventQueue.h"
 
 #include "Dymatic/Core/Timestep.h"
 
@@ -21,8 +22,6 @@ namespace Dymatic {
 		Application(const std::string& name = "Dymatic Engine");
 		virtual ~Application();
 
-		void OnEvent(Event& e);
-
 		void PushLayer(Layer* layer);
 		void PushOverlay(Layer* layer);
 
@@ -32,9 +31,21 @@ namespace Dymatic {
 
 		ImGuiLayer* GetImGuiLayer() { return m_ImGuiLayer; }
 
+		EventQueue& GetEventQueue() { return m_EventQueue; }
+
+		// With render on demand the loop sleeps until the window gets an event, unless a
+		// layer requested the next frame. Every wake up runs a few frames so ImGui can settle.
+		void SetRenderOnDemand(bool enabled) { m_RenderOnDemand = enabled; }
+		bool IsRenderOnDemand() const { return m_RenderOnDemand; }
+		void RequestFrame() { if (m_RequestedFrames == 0) m_RequestedFrames = 1; }
+
 		static Application& Get() { return *s_Instance; }
 	private:
 		void Run();
+		void ProcessEvents();
+		void WaitForEvents();
+		template<typename T>
+		void OnEvent(T& e);
 		bool OnWindowClose(WindowCloseEvent& e);
 		bool OnWindowResize(WindowResizeEvent& e);
 	private:
@@ -43,7 +54,11 @@ namespace Dymatic {
 		bool m_Running = true;
 		bool m_Minimized = false;
 		LayerStack m_LayerStack;
-		float m_LastFrameTime = 0.0f;
+		EventQueue m_EventQueue;
+		EventHandlerTable m_EventHandlers;
+		double m_LastFrameTime = 0.0;
+		bool m_RenderOnDemand = false;
+		uint32_t m_RequestedFrames = 0;
 	private:
 		static Application* s_Instance;
 		friend int ::main(int argc, char** argv);
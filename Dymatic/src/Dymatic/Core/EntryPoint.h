@@ -1,7 +1,7 @@
 #pragma once
 #include "Dymatic/Core/Base.h"
 
-#ifdef DY_PLATFORM_WINDOWS
+#if defined(DY_PLATFORM_WINDOWS) || defined(DY_PLATFORM_LINUX)
 
 extern Dymatic::Application* Dymatic::CreateApplication();
 
@@ -20,6 +20,8 @@ int main(int argc, char** argv)
 	DY_PROFILE_BEGIN_SESSION("Shutdown", "DymaticProfile-Shutdown.json");
 	delete app;
 	DY_PROFILE_END_SESSION();
+
+	Dymatic::Log::Shutdown();
 }
 
 #endif
@@ -0,0 +1,169 @@
+#include "dypch.h"
+#include "Dymatic/Core/Input.h"
+
+#include <atomic>
+
+namespace Dymatic {
+
+	struct InputData
+	{
+		// Written while the frame's events are dispatched, only touched by the main thread
+		InputSnapshot Pending;
+		bool HasMousePosition = false;
+
+		// Readers only ever see a published snapshot, the next one is written into the other slot
+		InputSnapshot Snapshots[2];
+		std::atomic<uint32_t> Current = 0;
+	};
+
+	static InputData s_Data;
+
+	const InputSnapshot& Input::GetSnapshot()
+	{
+		return s_Data.Snapshots[s_Data.Current.load(std::memory_order_acquire)];
+	}
+
+	bool Input::IsKeyPressed(const KeyCode key)
+	{
+		return key < InputSnapshot::MaxKeys && GetSnapshot().Keys[key];
+	}
+
+	bool Input::WasKeyPressed(const KeyCode key)
+	{
+		return key < InputSnapshot::MaxKeys && GetSnapshot().KeysPressed[key];
+	}
+
+	bool Input::WasKeyReleased(const KeyCode key)
+	{
+		return key < InputSnapshot::MaxKeys && GetSnapshot().KeysReleased[key];
+	}
+
+	bool Input::IsMouseButtonPressed(const MouseCode button)
+	{
+		return button < InputSnapshot::MaxMouseButtons && GetSnapshot().MouseButtons[button];
+	}
+
+	bool Input::WasMouseButtonPressed(const MouseCode button)
+	{
+		return button < InputSnapshot::MaxMouseButtons && GetSnapshot().MouseButtonsPressed[button];
+	}
+
+	bool Input::WasMouseButtonReleased(const MouseCode button)
+	{
+		return button < InputSnapshot::MaxMouseButtons && GetSnapshot().MouseButtonsReleased[button];
+	}
+
+	glm::vec2 Input::GetMousePosition()
+	{
+		return GetSnapshot().MousePosition;
+	}
+
+	float Input::GetMouseX()
+	{
+		return GetMousePosition().x;
+	}
+
+	float Input::GetMouseY()
+	{
+		return GetMousePosition().y;
+	}
+
+	glm::vec2 Input::GetMouseDelta()
+	{
+		return GetSnapshot().MouseDelta;
+	}
+
+	glm::vec2 Input::GetScrollDelta()
+	{
+		return GetSnapshot().ScrollDelta;
+	}
+
+	void Input::BeginFrame()
+	{
+		// Held state carries over, edges and deltas only describe one frame
+		InputSnapshot& pending = s_Data.Pending;
+		pending.KeysPressed.reset();
+		pending.KeysReleased.reset();
+		pending.MouseButtonsPressed.reset();
+		pending.MouseButtonsReleased.reset();
+		pending.MouseDelta = { 0.0f, 0.0f };
+		pending.ScrollDelta = { 0.0f, 0.0f };
+	}
+
+	void Input::PublishSnapshot()
+	{
+		DY_PROFILE_FUNCTION();
+
+		uint32_t next = s_Data.Current.load(std::memory_order_relaxed) ^ 1;
+		s_Data.Snapshots[next] = s_Data.Pending;
+		s_Data.Current.store(next, std::memory_order_release);
+	}
+
+	void Input::OnEvent(const KeyPressedEvent& e)
+	{
+		KeyCode key = e.GetKeyCode();
+		if (key >= InputSnapshot::MaxKeys || e.GetRepeatCount() > 0)
+			return;
+
+		s_Data.Pending.Keys[key] = true;
+		s_Data.Pending.KeysPressed[key] = true;
+	}
+
+	void Input::OnEvent(const KeyReleasedEvent& e)
+	{
+		KeyCode key = e.GetKeyCode();
+		if (key >= InputSnapshot::MaxKeys)
+			return;
+
+		s_Data.Pending.Keys[key] = false;
+		s_Data.Pending.KeysReleased[key] = true;
+	}
+
+	void Input::OnEvent(const MouseButtonPressedEvent& e)
+	{
+		MouseCode button = e.GetMouseButton();
+		if (button >= InputSnapshot::MaxMouseButtons)
+			return;
+
+		s_Data.Pending.MouseButtons[button] = true;
+		s_Data.Pending.MouseButtonsPressed[button] = true;
+	}
+
+	void Input::OnEvent(const MouseButtonReleasedEvent& e)
+	{
+		MouseCode button = e.GetMouseButton();
+		if (button >= InputSnapshot::MaxMouseButtons)
+			return;
+
+		s_Data.Pending.MouseButtons[button] = false;
+		s_Data.Pending.MouseButtonsReleased[button] = true;
+	}
+
+	void Input::OnEvent(const MouseMovedEvent& e)
+	{
+		glm::vec2 position = { e.GetX(), e.GetY() };
+
+		// The first position has nothing to be relative to
+		if (s_Data.HasMousePosition)
+			s_Data.Pending.MouseDelta += position - s_Data.Pending.MousePosition;
+
+		s_Data.Pending.MousePosition = position;
+		s_Data.HasMousePosition = true;
+	}
+
+	void Input::OnEvent(const MouseScrolledEvent& e)
+	{
+		s_Data.Pending.ScrollDelta += glm::vec2(e.GetXOffset(), e.GetYOffset());
+	}
+
+	void Input::OnEvent(const WindowLostFocusEvent&)
+	{
+		// Releases happening while another window has focus are never reported
+		InputSnapshot& pending = s_Data.Pending;
+		pending.KeysReleased |= pending.Keys;
+		pending.MouseButtonsReleased |= pending.MouseButtons;
+		pending.Keys.reset();
+		pending.MouseButtons.reset();
+	}
+
+}
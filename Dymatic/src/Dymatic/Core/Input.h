@@ -1,22 +1,70 @@
 #pragma once
 
+#include <bitset>
 #include <glm/glm.hpp>
 
-#include "Dymatic/Core/Keycodes.h"
+#include "Dymatic/Core/KeyCodes.h"
 #include "Dymatic/Core/MouseCodes.h"
 
+#include "Dymatic/Events/ApplicationEvent.h"
+#include "Dymatic/Events/KeyEvent.h"
+#include "Dymatic/Events/MouseEvent.h"
+
 namespace Dymatic {
 
+	// Input state as of the start of a frame, built from the window's events
+	struct InputSnapshot
+	{
+		static constexpr uint32_t MaxKeys = 512;
+		static constexpr uint32_t MaxMouseButtons = 8;
+
+		std::bitset<MaxKeys> Keys;
+		std::bitset<MaxKeys> KeysPressed;  // Went down during the last frame
+		std::bitset<MaxKeys> KeysReleased; // Went up during the last frame
+
+		std::bitset<MaxMouseButtons> MouseButtons;
+		std::bitset<MaxMouseButtons> MouseButtonsPressed;
+		std::bitset<MaxMouseButtons> MouseButtonsReleased;
+
+		glm::vec2 MousePosition = { 0.0f, 0.0f };
+		glm::vec2 MouseDelta = { 0.0f, 0.0f };
+		glm::vec2 ScrollDelta = { 0.0f, 0.0f };
+	};
+
+	// Queries read the snapshot Application publishes once per frame. They are O(1), never call into the
+	// platform and can be used from jobs. A job running longer than a frame should copy GetSnapshot().
 	class Input
 	{
 	public:
 		static bool IsKeyPressed(KeyCode key);
+		static bool WasKeyPressed(KeyCode key);
+		static bool WasKeyReleased(KeyCode key);
 
 		static bool IsMouseButtonPressed(MouseCode button);
+		static bool WasMouseButtonPressed(MouseCode button);
+		static bool WasMouseButtonReleased(MouseCode button);
+
 		static glm::vec2 GetMousePosition();
 		static float GetMouseX();
 		static float GetMouseY();
-	};
+		static glm::vec2 GetMouseDelta();
+		static glm::vec2 GetScrollDelta();
 
+		static const InputSnapshot& GetSnapshot();
+	public:
+		// Called by Application around the dispatch of the frame's events
+		static void BeginFrame();
+		static void PublishSnapshot();
+
+		static void OnEvent(const KeyPressedEvent& e);
+		static void OnEvent(const KeyReleasedEvent& e);
+		static void OnEvent(const MouseButtonPressedEvent& e);
+		static void OnEvent(const MouseButtonReleasedEvent& e);
+		static void OnEvent(const MouseMovedEvent& e);
+		static void OnEvent(const MouseScrolledEvent& e);
+		static void OnEvent(const WindowLostFocusEvent&);
+		template<typename T>
+		static void OnEvent(const T&) {}
+	};
 
 }
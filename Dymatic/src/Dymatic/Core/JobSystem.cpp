@@ -0,0 +1,163 @@
+#include "dypch.h"
+#include "Dymatic/Core/JobSystem.h"
+
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <deque>
+#include <atomic>
+
+namespace Dymatic {
+
+	struct JobSystemData
+	{
+		std::vector<std::thread> Workers;
+		std::deque<JobSystem::Job> Queue;
+
+		std::mutex QueueMutex;
+		std::condition_variable QueueCondition;
+
+		bool Running = false;
+	};
+
+	static JobSystemData s_JobData;
+
+	static void WorkerLoop()
+	{
+		while (true)
+		{
+			JobSystem::Job job;
+			{
+				std::unique_lock lock(s_JobData.QueueMutex);
+				s_JobData.QueueCondition.wait(lock, [] { return !s_JobData.Running || !s_JobData.Queue.empty(); });
+
+				if (!s_JobData.Running && s_JobData.Queue.empty())
+					return;
+
+				job = std::move(s_JobData.Queue.front());
+				s_JobData.Queue.pop_front();
+			}
+
+			job();
+		}
+	}
+
+	void JobSystem::Init(uint32_t workerCount)
+	{
+		DY_PROFILE_FUNCTION();
+
+		DY_CORE_ASSERT(!s_JobData.Running, "JobSystem already initialized!");
+
+		if (workerCount == 0)
+		{
+			uint32_t hardwareThreads = std::thread::hardware_concurrency();
+			workerCount = hardwareThreads > 1 ? hardwareThreads - 1 : 1;
+		}
+
+		s_JobData.Running = true;
+		s_JobData.Workers.reserve(workerCount);
+		for (uint32_t i = 0; i < workerCount; i++)
+			s_JobData.Workers.emplace_back(WorkerLoop);
+
+		DY_CORE_INFO("JobSystem started with {0} worker threads", workerCount);
+	}
+
+	void JobSystem::Shutdown()
+	{
+		DY_PROFILE_FUNCTION();
+
+		{
+			std::lock_guard lock(s_JobData.QueueMutex);
+			s_JobData.Running = false;
+		}
+		s_JobData.QueueCondition.notify_all();
+
+		// Workers drain whatever is still queued before exiting
+		for (auto& worker : s_JobData.Workers)
+			worker.join();
+		s_JobData.Workers.clear();
+	}
+
+	void JobSystem::Submit(const Job& job)
+	{
+		// Without workers (before Init or after Shutdown) jobs run inline
+		if (s_JobData.Workers.empty())
+		{
+			job();
+			return;
+		}
+
+		{
+			std::lock_guard lock(s_JobData.QueueMutex);
+			s_JobData.Queue.push_back(job);
+		}
+		s_JobData.QueueCondition.notify_one();
+	}
+
+	// Shared with the helper jobs, which may only get to run after ParallelFor returned
+	struct ParallelForData
+	{
+		JobSystem::RangeJob Job;
+		uint32_t Count, ChunkSize, ChunkCount;
+
+		std::atomic<uint32_t> NextChunk{ 0 };
+		uint32_t CompletedChunks = 0;
+		std::mutex CompletedMutex;
+		std::condition_variable CompletedCondition;
+
+		// Returns false once no chunk is left to claim
+		bool RunNextChunk()
+		{
+			uint32_t chunk = NextChunk.fetch_add(1);
+			if (chunk >= ChunkCount)
+				return false;
+
+			uint32_t begin = chunk * ChunkSize;
+			Job(begin, std::min(begin + ChunkSize, Count));
+
+			std::lock_guard lock(CompletedMutex);
+			if (++CompletedChunks == ChunkCount)
+				CompletedCondition.notify_all();
+			return true;
+		}
+	};
+
+	void JobSystem::ParallelFor(uint32_t count, uint32_t chunkSize, const RangeJob& job)
+	{
+		DY_CORE_ASSERT(chunkSize > 0, "Chunk size must be positive!");
+
+		uint32_t chunkCount = (count + chunkSize - 1) / chunkSize;
+		if (chunkCount <= 1 || s_JobData.Workers.empty())
+		{
+			for (uint32_t begin = 0; begin < count; begin += chunkSize)
+				job(begin, std::min(begin + chunkSize, count));
+			return;
+		}
+
+		auto data = CreateRef<ParallelForData>();
+		data->Job = job;
+		data->Count = count;
+		data->ChunkSize = chunkSize;
+		data->ChunkCount = chunkCount;
+
+		// The calling thread takes chunks too, so one less helper than chunks is enough
+		uint32_t helperCount = std::min(chunkCount - 1, (uint32_t)s_JobData.Workers.size());
+		{
+			std::lock_guard lock(s_JobData.QueueMutex);
+			for (uint32_t i = 0; i < helperCount; i++)
+				s_JobData.Queue.push_back([data]() { while (data->RunNextChunk()); });
+		}
+		s_JobData.QueueCondition.notify_all();
+
+		while (data->RunNextChunk());
+
+		std::unique_lock lock(data->CompletedMutex);
+		data->CompletedCondition.wait(lock, [&] { return data->CompletedChunks == data->ChunkCount; });
+	}
+
+	uint32_t JobSystem::GetWorkerCount()
+	{
+		return (uint32_t)s_JobData.Workers.size();
+	}
+
+}
@@ -0,0 +1,27 @@
+#pragma once
+
+#include "Dymatic/Core/Base.h"
+
+#include <functional>
+
+namespace Dymatic {
+
+	class JobSystem
+	{
+	public:
+		using Job = std::function<void()>;
+		using RangeJob = std::function<void(uint32_t begin, uint32_t end)>;
+
+		// workerCount = 0 uses one worker per hardware thread, minus the main thread
+		static void Init(uint32_t workerCount = 0);
+		static void Shutdown();
+
+		static void Submit(const Job& job);
+		// Splits [0, count) into chunks of chunkSize and runs them on the workers and the calling
+		// thread, returning once every chunk is done. Chunk boundaries only depend on the arguments.
+		static void ParallelFor(uint32_t count, uint32_t chunkSize, const RangeJob& job);
+
+		static uint32_t GetWorkerCount();
+	};
+
+}
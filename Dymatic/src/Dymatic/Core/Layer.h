@@ -16,11 +16,15 @@ namespace Dymatic {
 		virtual void OnDetach() {}
 		virtual void OnUpdate(Timestep ts) {}
 		virtual void OnImGuiRender() {}
+		// Only called for layers that bound no handlers in GetEventHandlers()
 		virtual void OnEvent(Event& event) {}
 
 		const std::string& GetName() const { return m_DebugName; }
+
+		EventHandlerTable& GetEventHandlers() { return m_EventHandlers; }
 	protected:
 		std::string m_DebugName;
+		EventHandlerTable m_EventHandlers;
 	};
 
 }
\ No newline at end of file
@@ -1,33 +1,106 @@
 #include "dypch.h"
 #include "Dymatic/Core/Log.h"
+#include "Dymatic/Core/LogSinks.h"
 
 #include <spdlog/sinks/stdout_color_sinks.h>
 #include <spdlog/sinks/basic_file_sink.h>
 
+#include <chrono>
+
 namespace Dymatic {
 
 	Ref<spdlog::logger> Log::s_CoreLogger;
 	Ref<spdlog::logger> Log::s_ClientLogger;
+	LogMode Log::s_Mode = LogMode::Synchronous;
+
+	namespace Utils {
+
+		static std::vector<spdlog::sink_ptr> CreateSinks(LogMode mode, const std::string& filename, bool console)
+		{
+			std::vector<spdlog::sink_ptr> logSinks;
+			if (console)
+			{
+				logSinks.emplace_back(std::make_shared<spdlog::sinks::stdout_color_sink_mt>());
+				logSinks.back()->set_pattern("%^[%T] %n: %v%$");
+			}
+
+			if (mode == LogMode::AsyncBinary)
+			{
+				logSinks.emplace_back(std::make_shared<BinaryFileSink>(filename + ".dylog"));
+			}
+			else
+			{
+				logSinks.emplace_back(std::make_shared<spdlog::sinks::basic_file_sink_mt>(filename + ".log", true));
+				logSinks.back()->set_pattern("[%T] [%l] %n: %v");
+			}
+
+			// In async mode every logger using the sinks shares one queue and flusher, which decides when to flush
+			if (mode != LogMode::Synchronous)
+				logSinks = { std::make_shared<AsyncSink>(logSinks) };
+
+			return logSinks;
+		}
 
-	void Log::Init()
+		static Ref<spdlog::logger> CreateLogger(const std::string& name, LogMode mode, const std::vector<spdlog::sink_ptr>& logSinks)
+		{
+			Ref<spdlog::logger> logger = std::make_shared<spdlog::logger>(name, begin(logSinks), end(logSinks));
+			logger->set_level(spdlog::level::trace);
+			logger->flush_on(mode == LogMode::Synchronous ? spdlog::level::trace : spdlog::level::off);
+			return logger;
+		}
+
+	}
+
+	void Log::Init(LogMode mode)
 	{
-		std::vector<spdlog::sink_ptr> logSinks;
-		logSinks.emplace_back(std::make_shared<spdlog::sinks::stdout_color_sink_mt>());
-		logSinks.emplace_back(std::make_shared<spdlog::sinks::basic_file_sink_mt>("Dymatic.log", true));
+		if (s_CoreLogger)
+			Shutdown();
 
-		logSinks[0]->set_pattern("%^[%T] %n: %v%$");
-		logSinks[1]->set_pattern("[%T] [%l] %n: %v");
+		s_Mode = mode;
 
-		s_CoreLogger = std::make_shared<spdlog::logger>("Dymatic", begin(logSinks), end(logSinks));
+		std::vector<spdlog::sink_ptr> logSinks = Utils::CreateSinks(mode, "Dymatic", true);
+
+		s_CoreLogger = Utils::CreateLogger("Dymatic", mode, logSinks);
 		spdlog::register_logger(s_CoreLogger);
-		s_CoreLogger->set_level(spdlog::level::trace);
-		s_CoreLogger->flush_on(spdlog::level::trace);
 
-		s_ClientLogger = std::make_shared<spdlog::logger>("APP", begin(logSinks), end(logSinks));
+		s_ClientLogger = Utils::CreateLogger("APP", mode, logSinks);
 		spdlog::register_logger(s_ClientLogger);
-		s_ClientLogger->set_level(spdlog::level::trace);
-		s_ClientLogger->flush_on(spdlog::level::trace);
 	}
 
-}
+	Ref<spdlog::logger> Log::CreateLogger(const std::string& name, LogMode mode, const std::string& filename, bool console)
+	{
+		return Utils::CreateLogger(name, mode, Utils::CreateSinks(mode, filename, console));
+	}
+
+	void Log::Shutdown()
+	{
+		if (!s_CoreLogger)
+			return;
+
+		s_CoreLogger->flush();
+		spdlog::drop_all();
+		s_CoreLogger.reset();
+		s_ClientLogger.reset();
+	}
+
+	bool LogRateLimiter::Allow(uint32_t& suppressed)
+	{
+		int64_t second = std::chrono::duration_cast<std::chrono::seconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+
+		int64_t previous = m_Second.load(std::memory_order_relaxed);
+		if (second != previous && m_Second.compare_exchange_strong(previous, second, std::memory_order_relaxed))
+		{
+			suppressed = m_Suppressed.exchange(0, std::memory_order_relaxed);
+			m_Count.store(0, std::memory_order_relaxed);
+		}
+
+		if (m_Count.fetch_add(1, std::memory_order_relaxed) < m_MaxPerSecond)
+			return true;
 
+		// Hand a count taken above back, so it is reported with the next message that gets through
+		m_Suppressed.fetch_add(suppressed + 1, std::memory_order_relaxed);
+		suppressed = 0;
+		return false;
+	}
+
+}
@@ -8,23 +8,73 @@
 #include <spdlog/fmt/ostr.h>
 #pragma warning(pop)
 
+#include <atomic>
 
 namespace Dymatic {
 
+	enum class LogMode
+	{
+		Synchronous, // Every message is written and flushed before the call returns
+		Async,       // Messages are written by a background thread
+		AsyncBinary  // Async, with the log file written as binary records instead of formatted text
+	};
+
 	class Log
 	{
 	public:
-		static void Init();
+		// Can be called again to switch modes, but only while no other thread is logging
+		static void Init(LogMode mode = LogMode::Async);
+		// Writes out everything still queued
+		static void Shutdown();
+
+		static LogMode GetMode() { return s_Mode; }
+
+		// A logger with sinks of its own that is not registered with spdlog, configured like the
+		// engine loggers in mode. Writes to filename + ".log", or ".dylog" in AsyncBinary mode.
+		static Ref<spdlog::logger> CreateLogger(const std::string& name, LogMode mode, const std::string& filename, bool console = true);
 
 		static Ref<spdlog::logger>& GetCoreLogger() { return s_CoreLogger; }
 		static Ref<spdlog::logger>& GetClientLogger() { return s_ClientLogger; }
 	private:
 		static Ref<spdlog::logger> s_CoreLogger;
 		static Ref<spdlog::logger> s_ClientLogger;
+		static LogMode s_Mode;
+	};
+
+	// Lets a call site through at most MaxPerSecond times per second, used by the *_LIMITED macros
+	class LogRateLimiter
+	{
+	public:
+		LogRateLimiter(uint32_t maxPerSecond)
+			: m_MaxPerSecond(maxPerSecond) {}
+
+		// When a new second starts, suppressed receives how many messages were dropped in the previous one
+		bool Allow(uint32_t& suppressed);
+	private:
+		uint32_t m_MaxPerSecond;
+		std::atomic<int64_t> m_Second = 0;
+		std::atomic<uint32_t> m_Count = 0;
+		std::atomic<uint32_t> m_Suppressed = 0;
 	};
 
 }
 
+#define DY_LOG_RATE_LIMITED(logger, level, maxPerSecond, ...) \
+	do \
+	{ \
+		if (logger->should_log(level)) \
+		{ \
+			static ::Dymatic::LogRateLimiter s_RateLimiter(maxPerSecond); \
+			uint32_t suppressed = 0; \
+			if (s_RateLimiter.Allow(suppressed)) \
+			{ \
+				if (suppressed > 0) \
+					logger->log(level, "{0} messages from the line below were suppressed", suppressed); \
+				logger->log(level, __VA_ARGS__); \
+			} \
+		} \
+	} while (false)
+
 // Core log macros
 #define DY_CORE_TRACE(...)    ::Dymatic::Log::GetCoreLogger()->trace(__VA_ARGS__)
 #define DY_CORE_INFO(...)     ::Dymatic::Log::GetCoreLogger()->info(__VA_ARGS__)
@@ -32,9 +82,19 @@ namespace Dymatic {
 #define DY_CORE_ERROR(...)    ::Dymatic::Log::GetCoreLogger()->error(__VA_ARGS__)
 #define DY_CORE_CRITICAL(...) ::Dymatic::Log::GetCoreLogger()->critical(__VA_ARGS__)
 
+// Rate limited core log macros, for messages inside hot loops
+#define DY_CORE_TRACE_LIMITED(maxPerSecond, ...) DY_LOG_RATE_LIMITED(::Dymatic::Log::GetCoreLogger(), spdlog::level::trace, maxPerSecond, __VA_ARGS__)
+#define DY_CORE_INFO_LIMITED(maxPerSecond, ...)  DY_LOG_RATE_LIMITED(::Dymatic::Log::GetCoreLogger(), spdlog::level::info, maxPerSecond, __VA_ARGS__)
+#define DY_CORE_WARN_LIMITED(maxPerSecond, ...)  DY_LOG_RATE_LIMITED(::Dymatic::Log::GetCoreLogger(), spdlog::level::warn, maxPerSecond, __VA_ARGS__)
+
 // Client log macros
 #define DY_TRACE(...)         ::Dymatic::Log::GetClientLogger()->trace(__VA_ARGS__)
 #define DY_INFO(...)          ::Dymatic::Log::GetClientLogger()->info(__VA_ARGS__)
 #define DY_WARN(...)          ::Dymatic::Log::GetClientLogger()->warn(__VA_ARGS__)
 #define DY_ERROR(...)         ::Dymatic::Log::GetClientLogger()->error(__VA_ARGS__)
 #define DY_CRITICAL(...)      ::Dymatic::Log::GetClientLogger()->critical(__VA_ARGS__)
+
+// Rate limited client log macros, for messages inside hot loops
+#define DY_TRACE_LIMITED(maxPerSecond, ...)      DY_LOG_RATE_LIMITED(::Dymatic::Log::GetClientLogger(), spdlog::level::trace, maxPerSecond, __VA_ARGS__)
+#define DY_INFO_LIMITED(maxPerSecond, ...)       DY_LOG_RATE_LIMITED(::Dymatic::Log::GetClientLogger(), spdlog::level::info, maxPerSecond, __VA_ARGS__)
+#define DY_WARN_LIMITED(maxPerSecond, ...)       DY_LOG_RATE_LIMITED(::Dymatic::Log::GetClientLogger(), spdlog::level::warn, maxPerSecond, __VA_ARGS__)
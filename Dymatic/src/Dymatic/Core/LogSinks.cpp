@@ -0,0 +1,279 @@
+#include "dypch.h"
+#include "Dymatic/Core/LogSinks.h"
+
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+
+namespace Dymatic {
+
+	static uint64_t RoundUpToPowerOfTwo(uint64_t value)
+	{
+		uint64_t result = 1;
+		while (result < value)
+			result <<= 1;
+		return result;
+	}
+
+	AsyncSink::AsyncSink(std::vector<spdlog::sink_ptr> sinks, uint32_t capacity, spdlog::level::level_enum flushLevel)
+		: m_Sinks(std::move(sinks)), m_FlushLevel(flushLevel)
+	{
+		uint64_t size = RoundUpToPowerOfTwo(std::max(capacity, 2u));
+		m_Records = CreateScope<Record[]>(size);
+		m_Mask = size - 1;
+
+		// A record is free for position p when its sequence equals p, and written when it equals p + 1
+		for (uint64_t i = 0; i < size; i++)
+			m_Records[i].Sequence.store(i, std::memory_order_relaxed);
+
+		m_Thread = std::thread(&AsyncSink::FlusherThread, this);
+	}
+
+	AsyncSink::~AsyncSink()
+	{
+		{
+			std::lock_guard lock(m_Mutex);
+			m_Running = false;
+		}
+		m_WakeFlusher.notify_one();
+		m_Thread.join();
+	}
+
+	bool AsyncSink::TryPush(const spdlog::details::log_msg& msg, uint64_t& position)
+	{
+		// Bounded multi-producer queue (D. Vyukov), one CAS per message and no locks
+		Record* record;
+		position = m_EnqueuePosition.load(std::memory_order_relaxed);
+		for (;;)
+		{
+			record = &m_Records[position & m_Mask];
+			uint64_t sequence = record->Sequence.load(std::memory_order_acquire);
+			int64_t difference = (int64_t)sequence - (int64_t)position;
+			if (difference == 0)
+			{
+				if (m_EnqueuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+					break;
+			}
+			else if (difference < 0)
+			{
+				return false;
+			}
+			else
+			{
+				position = m_EnqueuePosition.load(std::memory_order_relaxed);
+			}
+		}
+
+		record->Time = msg.time;
+		record->Source = msg.source;
+		record->ThreadID = msg.thread_id;
+		record->Level = msg.level;
+
+		record->LoggerNameLength = (uint8_t)std::min(msg.logger_name.size(), sizeof(record->LoggerName));
+		memcpy(record->LoggerName, msg.logger_name.data(), record->LoggerNameLength);
+
+		record->PayloadLength = (uint32_t)msg.payload.size();
+		if (msg.payload.size() <= Record::InlinePayloadSize)
+			memcpy(record->Payload, msg.payload.data(), msg.payload.size());
+		else
+			record->LongPayload.assign(msg.payload.data(), msg.payload.size());
+
+		record->Sequence.store(position + 1, std::memory_order_release);
+		return true;
+	}
+
+	void AsyncSink::log(const spdlog::details::log_msg& msg)
+	{
+		uint64_t position;
+		while (!TryPush(msg, position))
+		{
+			// Floods of hot loop traces are not worth stalling the caller for
+			if (msg.level <= spdlog::level::debug)
+			{
+				m_Dropped.fetch_add(1, std::memory_order_relaxed);
+				return;
+			}
+
+			m_WakeFlusher.notify_one();
+			std::this_thread::yield();
+		}
+
+		if (msg.level >= m_FlushLevel || msg.level >= spdlog::level::err)
+			RequestFlush(position + 1);
+
+		// A flush that ran before this record was written does not count, only one that covers it
+		if (msg.level >= spdlog::level::err)
+		{
+			std::unique_lock lock(m_Mutex);
+			m_Flushed.wait(lock, [&]() { return m_FlushedPosition.load() > position || !m_Running; });
+		}
+	}
+
+	void AsyncSink::flush()
+	{
+		uint64_t position = m_EnqueuePosition.load();
+		RequestFlush(position);
+
+		std::unique_lock lock(m_Mutex);
+		m_Flushed.wait(lock, [&]() { return m_FlushedPosition.load() >= position || !m_Running; });
+	}
+
+	void AsyncSink::RequestFlush(uint64_t position)
+	{
+		uint64_t requested = m_FlushPosition.load();
+		while (requested < position && !m_FlushPosition.compare_exchange_weak(requested, position))
+			;
+
+		// Taking the lock orders the request before the flusher checks whether to sleep
+		{
+			std::lock_guard lock(m_Mutex);
+		}
+		m_WakeFlusher.notify_one();
+	}
+
+	bool AsyncSink::IsNextRecordReady() const
+	{
+		return m_Records[m_DequeuePosition & m_Mask].Sequence.load(std::memory_order_acquire) == m_DequeuePosition + 1;
+	}
+
+	bool AsyncSink::Drain()
+	{
+		bool wroteAny = false;
+		for (;;)
+		{
+			Record& record = m_Records[m_DequeuePosition & m_Mask];
+			if (record.Sequence.load(std::memory_order_acquire) != m_DequeuePosition + 1)
+				break;
+
+			const char* payload = record.PayloadLength <= Record::InlinePayloadSize ? record.Payload : record.LongPayload.data();
+			spdlog::details::log_msg msg(record.Time, record.Source, spdlog::string_view_t(record.LoggerName, record.LoggerNameLength),
+				record.Level, spdlog::string_view_t(payload, record.PayloadLength));
+			msg.thread_id = record.ThreadID;
+
+			for (auto& sink : m_Sinks)
+			{
+				if (sink->should_log(msg.level))
+					sink->log(msg);
+			}
+
+			record.Sequence.store(m_DequeuePosition + m_Mask + 1, std::memory_order_release);
+			m_DequeuePosition++;
+			wroteAny = true;
+		}
+
+		uint64_t dropped = m_Dropped.load(std::memory_order_relaxed);
+		if (dropped != m_ReportedDropped)
+		{
+			std::string message = std::to_string(dropped - m_ReportedDropped) + " trace messages were dropped, the log queue was full";
+			spdlog::details::log_msg msg("Log", spdlog::level::warn, message);
+			for (auto& sink : m_Sinks)
+				sink->log(msg);
+
+			m_ReportedDropped = dropped;
+			wroteAny = true;
+		}
+
+		return wroteAny;
+	}
+
+	void AsyncSink::FlusherThread()
+	{
+		using namespace std::chrono_literals;
+
+		auto lastFlush = std::chrono::steady_clock::now();
+		bool unflushed = false;
+		for (;;)
+		{
+			bool running = m_Running.load();
+			unflushed |= Drain();
+
+			// Anything logged at the flush level is flushed right away, everything else at least once a second
+			auto now = std::chrono::steady_clock::now();
+			bool flushRequested = unflushed && m_FlushPosition.load() > m_FlushedPosition.load();
+			if (flushRequested || (unflushed && now - lastFlush > 1s) || !running)
+			{
+				for (auto& sink : m_Sinks)
+					sink->flush();
+				lastFlush = now;
+				unflushed = false;
+
+				{
+					std::lock_guard lock(m_Mutex);
+					m_FlushedPosition.store(m_DequeuePosition);
+				}
+				m_Flushed.notify_all();
+			}
+
+			if (!running)
+				break;
+
+			// A requested flush may still wait for records being pushed, those are picked up once published
+			std::unique_lock lock(m_Mutex);
+			m_WakeFlusher.wait_for(lock, 5ms, [this]() { return (m_FlushPosition.load() > m_FlushedPosition.load() && IsNextRecordReady()) || !m_Running.load(); });
+		}
+	}
+
+	BinaryFileSink::BinaryFileSink(const std::string& filepath)
+	{
+		m_File = fopen(filepath.c_str(), "wb");
+		if (!m_File)
+			throw spdlog::spdlog_ex("Failed to open binary log file " + filepath);
+
+		setvbuf(m_File, nullptr, _IOFBF, 64 * 1024);
+		fwrite(&Magic, sizeof(Magic), 1, m_File);
+	}
+
+	BinaryFileSink::~BinaryFileSink()
+	{
+		fclose(m_File);
+	}
+
+	void BinaryFileSink::sink_it_(const spdlog::details::log_msg& msg)
+	{
+		RecordHeader header;
+		header.Time = std::chrono::duration_cast<std::chrono::nanoseconds>(msg.time.time_since_epoch()).count();
+		header.ThreadID = (uint32_t)msg.thread_id;
+		header.PayloadLength = (uint32_t)msg.payload.size();
+		header.Level = (uint8_t)msg.level;
+		header.LoggerNameLength = (uint8_t)std::min<size_t>(msg.logger_name.size(), 255);
+
+		fwrite(&header, sizeof(header), 1, m_File);
+		fwrite(msg.logger_name.data(), 1, header.LoggerNameLength, m_File);
+		fwrite(msg.payload.data(), 1, header.PayloadLength, m_File);
+	}
+
+	void BinaryFileSink::flush_()
+	{
+		fflush(m_File);
+	}
+
+	bool BinaryFileSink::DecodeToText(const std::string& binaryPath, std::ostream& out)
+	{
+		std::ifstream in(binaryPath, std::ios::in | std::ios::binary);
+		uint32_t magic = 0;
+		in.read((char*)&magic, sizeof(magic));
+		if (!in || magic != Magic)
+			return false;
+
+		RecordHeader header;
+		std::string loggerName, payload;
+		while (in.read((char*)&header, sizeof(header)))
+		{
+			loggerName.resize(header.LoggerNameLength);
+			payload.resize(header.PayloadLength);
+			in.read(loggerName.data(), loggerName.size());
+			in.read(payload.data(), payload.size());
+			if (!in)
+				return false;
+
+			// Same layout as the text log file, "[%T] [%l] %n: %v"
+			std::time_t seconds = (std::time_t)(header.Time / 1000000000);
+			std::tm time = *std::localtime(&seconds);
+			auto level = spdlog::level::to_string_view((spdlog::level::level_enum)header.Level);
+			out << "[" << std::put_time(&time, "%H:%M:%S") << "] [" << std::string(level.data(), level.size()) << "] " << loggerName << ": " << payload << "\n";
+		}
+
+		return true;
+	}
+
+}
@@ -0,0 +1,111 @@
+#pragma once
+
+#include "Dymatic/Core/Base.h"
+
+#pragma warning(push, 0)
+#include <spdlog/sinks/sink.h>
+#include <spdlog/sinks/base_sink.h>
+#pragma warning(pop)
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdio>
+#include <mutex>
+#include <thread>
+
+namespace Dymatic {
+
+	// Moves pattern formatting, I/O and flushing of the wrapped sinks to a background thread.
+	// Callers copy the message into a preallocated lock-free ring and return. When the ring is full,
+	// trace and debug messages are dropped and counted, anything else waits for space.
+	// Errors and above wait until they are written and flushed, so nothing is lost if an assert follows.
+	class AsyncSink : public spdlog::sinks::sink
+	{
+	public:
+		AsyncSink(std::vector<spdlog::sink_ptr> sinks, uint32_t capacity = 8192, spdlog::level::level_enum flushLevel = spdlog::level::warn);
+		virtual ~AsyncSink();
+
+		virtual void log(const spdlog::details::log_msg& msg) override;
+		// Waits until every message logged before the call is written and flushed
+		virtual void flush() override;
+
+		// Every wrapped sink keeps its own pattern
+		virtual void set_pattern(const std::string&) override {}
+		virtual void set_formatter(std::unique_ptr<spdlog::formatter>) override {}
+
+		uint64_t GetDroppedCount() const { return m_Dropped.load(std::memory_order_relaxed); }
+	private:
+		struct Record
+		{
+			static constexpr uint32_t InlinePayloadSize = 200;
+
+			std::atomic<uint64_t> Sequence;
+
+			spdlog::log_clock::time_point Time;
+			spdlog::source_loc Source;
+			size_t ThreadID;
+			spdlog::level::level_enum Level;
+			char LoggerName[32];
+			uint8_t LoggerNameLength;
+
+			// Messages longer than the inline buffer are rare (shader logs), those allocate
+			uint32_t PayloadLength;
+			char Payload[InlinePayloadSize];
+			std::string LongPayload;
+		};
+
+		bool TryPush(const spdlog::details::log_msg& msg, uint64_t& position);
+		// Asks the flusher to flush as soon as every record below position is written
+		void RequestFlush(uint64_t position);
+		bool IsNextRecordReady() const;
+		bool Drain();
+		void FlusherThread();
+	private:
+		std::vector<spdlog::sink_ptr> m_Sinks;
+		spdlog::level::level_enum m_FlushLevel;
+
+		Scope<Record[]> m_Records;
+		uint64_t m_Mask;
+		alignas(64) std::atomic<uint64_t> m_EnqueuePosition = 0;
+		alignas(64) std::atomic<uint64_t> m_FlushPosition = 0;   // Everything below is to be flushed right away
+		std::atomic<uint64_t> m_FlushedPosition = 0;             // Everything below was written and flushed
+		uint64_t m_DequeuePosition = 0;                          // Flusher thread only
+		std::atomic<uint64_t> m_Dropped = 0;
+		uint64_t m_ReportedDropped = 0; // Flusher thread only
+
+		std::thread m_Thread;
+		std::atomic<bool> m_Running = true;
+		std::mutex m_Mutex;
+		std::condition_variable m_WakeFlusher;
+		std::condition_variable m_Flushed;
+	};
+
+	// Writes records as they are (time, level, thread, logger and message) without running a pattern
+	// formatter. DecodeToText turns a file back into readable lines.
+	class BinaryFileSink : public spdlog::sinks::base_sink<std::mutex>
+	{
+	public:
+		BinaryFileSink(const std::string& filepath);
+		virtual ~BinaryFileSink();
+
+		static bool DecodeToText(const std::string& binaryPath, std::ostream& out);
+	protected:
+		virtual void sink_it_(const spdlog::details::log_msg& msg) override;
+		virtual void flush_() override;
+	private:
+		struct RecordHeader
+		{
+			int64_t Time; // Nanoseconds since the epoch
+			uint32_t ThreadID;
+			uint32_t PayloadLength;
+			uint8_t Level;
+			uint8_t LoggerNameLength;
+			uint16_t Padding = 0;
+		};
+
+		static constexpr uint32_t Magic = 0x474C5944; // "DYLG"
+
+		FILE* m_File = nullptr;
+	};
+
+}
@@ -0,0 +1,22 @@
+#include "dypch.h"
+#include "Dymatic/Core/UUID.h"
+
+#include <random>
+
+namespace Dymatic {
+
+	static std::random_device s_RandomDevice;
+	static std::mt19937_64 s_Engine(((uint64_t)s_RandomDevice() << 32) | s_RandomDevice());
+	static std::uniform_int_distribution<uint64_t> s_UniformDistribution(1, UINT64_MAX);
+
+	UUID::UUID()
+		: m_UUID(s_UniformDistribution(s_Engine))
+	{
+	}
+
+	UUID::UUID(uint64_t uuid)
+		: m_UUID(uuid)
+	{
+	}
+
+}
@@ -0,0 +1,35 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+
+namespace Dymatic {
+
+	// Random 64 bit identifier that stays the same across saves and loads. Zero is never generated
+	// and means "no entity", so it can mark empty slots and unset references.
+	class UUID
+	{
+	public:
+		UUID();
+		UUID(uint64_t uuid);
+		UUID(const UUID&) = default;
+
+		operator uint64_t() const { return m_UUID; }
+	private:
+		uint64_t m_UUID;
+	};
+
+}
+
+namespace std {
+
+	template<>
+	struct hash<Dymatic::UUID>
+	{
+		std::size_t operator()(const Dymatic::UUID& uuid) const
+		{
+			return hash<uint64_t>()((uint64_t)uuid);
+		}
+	};
+
+}
@@ -1,16 +1,20 @@
 #include "dypch.h"
 #include "Dymatic/Core/Window.h"
 
-#ifdef DY_PLATFORM_WINDOWS
+#if defined(DY_PLATFORM_WINDOWS)
 #include "Platform/Windows/WindowsWindow.h"
+#elif defined(DY_PLATFORM_LINUX)
+#include "Platform/Linux/LinuxWindow.h"
 #endif
 
 namespace Dymatic
 {
 	Scope<Window> Window::Create(const WindowProps& props)
 	{
-#ifdef DY_PLATFORM_WINDOWS
+#if defined(DY_PLATFORM_WINDOWS)
 		return CreateScope<WindowsWindow>(props);
+#elif defined(DY_PLATFORM_LINUX)
+		return CreateScope<LinuxWindow>(props);
 #else
 		DY_CORE_ASSERT(false, "Unknown platform!");
 		return nullptr;
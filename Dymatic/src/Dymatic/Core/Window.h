@@ -3,7 +3,7 @@
 #include <sstream>
 
 #include "Dymatic/Core/Base.h"
-#include "Dymatic/Events/Event.h"
+#include "Dymatic/Events/EventQueue.h"
 
 namespace Dymatic {
 
@@ -25,17 +25,18 @@ namespace Dymatic {
 	class Window
 	{
 	public:
-		using EventCallbackFn = std::function<void(Event&)>;
-
 		virtual ~Window() = default;
 
 		virtual void OnUpdate() = 0;
+		// Sleeps until an event arrives or timeout seconds passed, events are handled like in OnUpdate
+		virtual void WaitEvents(double timeout) = 0;
 
 		virtual uint32_t GetWidth() const = 0;
 		virtual uint32_t GetHeight() const = 0;
 
 		// Window attributes
-		virtual void SetEventCallback(const EventCallbackFn& callback) = 0;
+		// Events raised while polling are pushed here and dispatched by the owner of the queue
+		virtual void SetEventQueue(EventQueue* queue) = 0;
 		virtual void SetVSync(bool enabled) = 0;
 		virtual bool IsVSync() const = 0;
 
@@ -22,6 +22,9 @@ namespace Dymatic {
 		FloatingPointMicroseconds Start;
 		std::chrono::microseconds ElapsedTime;
 		std::thread::id ThreadID;
+
+		// GPU results are written to their own process track so they line up under the CPU scopes
+		bool GPU = false;
 	};
 
 	struct InstrumentationSession
@@ -78,11 +81,11 @@ namespace Dymatic {
 
 			json << std::setprecision(3) << std::fixed;
 			json << ",{";
-			json << "\"cat\":\"function\",";
+			json << "\"cat\":\"" << (result.GPU ? "gpu" : "function") << "\",";
 			json << "\"dur\":" << (result.ElapsedTime.count()) << ',';
 			json << "\"name\":\"" << result.Name << "\",";
 			json << "\"ph\":\"X\",";
-			json << "\"pid\":0,";
+			json << "\"pid\":" << (result.GPU ? 1 : 0) << ",";
 			json << "\"tid\":" << result.ThreadID << ",";
 			json << "\"ts\":" << result.Start.count();
 			json << "}";
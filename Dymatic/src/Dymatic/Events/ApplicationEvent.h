@@ -37,6 +37,15 @@ namespace Dymatic {
 		EVENT_CLASS_CATEGORY(EventCategoryApplication)
 	};
 
+	class WindowLostFocusEvent : public Event
+	{
+	public:
+		WindowLostFocusEvent() {}
+
+		EVENT_CLASS_TYPE(WindowLostFocus)
+		EVENT_CLASS_CATEGORY(EventCategoryApplication)
+	};
+
 	class AppTickEvent : public Event
 	{
 	public:
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <functional>
+#include <array>
 
 #include "Dymatic/Debug/Instrumentor.h"
 
@@ -14,7 +15,8 @@ namespace Dymatic {
 		WindowClose, WindowResize, WindowFocus, WindowLostFocus, WindowMoved,
 		AppTick, AppUpdate, AppRender,
 		KeyPressed, KeyReleased, KeyTyped,
-		MouseButtonPressed, MouseButtonReleased, MouseMoved, MouseScrolled
+		MouseButtonPressed, MouseButtonReleased, MouseMoved, MouseScrolled,
+		Count
 	};
 
 	enum EventCategory
@@ -28,7 +30,7 @@ namespace Dymatic {
 		
 	};
 
-#define EVENT_CLASS_TYPE(type) static EventType GetStaticType() { return EventType::##type; }\
+#define EVENT_CLASS_TYPE(type) static constexpr EventType GetStaticType() { return EventType::type; }\
 								virtual EventType GetEventType() const override { return GetStaticType(); }\
 								virtual const char* GetName() const override { return #type; }
 
@@ -77,6 +79,57 @@ namespace Dymatic {
 		Event& m_Event;
 	};
 
+	// Handlers indexed by event type, called through a plain function pointer. Used by the
+	// event queue instead of walking OnEvent overrides and comparing types one by one.
+	class EventHandlerTable
+	{
+	public:
+		// Binds a member function bool(T&) of instance, replacing any handler bound for T
+		template<typename T, auto Handler, typename C>
+		void Bind(C* instance)
+		{
+			Entry& entry = m_Handlers[(size_t)T::GetStaticType()];
+			entry.Instance = instance;
+			entry.Function = [](void* instance, Event& e) { return (static_cast<C*>(instance)->*Handler)(static_cast<T&>(e)); };
+			m_Empty = false;
+		}
+
+		template<typename T>
+		void Unbind()
+		{
+			m_Handlers[(size_t)T::GetStaticType()] = {};
+
+			m_Empty = true;
+			for (const Entry& entry : m_Handlers)
+			{
+				if (entry.Function)
+				{
+					m_Empty = false;
+					break;
+				}
+			}
+		}
+
+		template<typename T>
+		void Dispatch(T& e) const
+		{
+			const Entry& entry = m_Handlers[(size_t)T::GetStaticType()];
+			if (entry.Function)
+				e.Handled = entry.Function(entry.Instance, e);
+		}
+
+		bool IsEmpty() const { return m_Empty; }
+	private:
+		struct Entry
+		{
+			void* Instance = nullptr;
+			bool (*Function)(void*, Event&) = nullptr;
+		};
+
+		std::array<Entry, (size_t)EventType::Count> m_Handlers;
+		bool m_Empty = true;
+	};
+
 	inline std::ostream& operator<<(std::ostream& os, const Event& e)
 	{
 		return os << e.ToString();
@@ -0,0 +1,67 @@
+#include "dypch.h"
+#include "Dymatic/Events/EventQueue.h"
+
+#include "Dymatic/Utils/PlatformUtils.h"
+
+namespace Dymatic {
+
+	static uint32_t RoundUpToPowerOfTwo(uint32_t value)
+	{
+		uint32_t result = 1;
+		while (result < value)
+			result <<= 1;
+		return result;
+	}
+
+	EventQueue::EventQueue(uint32_t capacity)
+		: m_Events(RoundUpToPowerOfTwo(std::max(capacity, 1u)))
+	{
+	}
+
+	void EventQueue::Grow()
+	{
+		DY_PROFILE_FUNCTION();
+
+		// Only happens if a single frame produces more events than fit, the ring keeps its size afterwards
+		std::vector<QueuedEvent> events(m_Events.size() * 2);
+		for (uint32_t i = 0; i < m_Count; i++)
+			events[i] = m_Events[(m_Head + i) & (m_Events.size() - 1)];
+
+		DY_CORE_WARN("Event queue full, growing to {0} events", events.size());
+
+		m_Events = std::move(events);
+		m_Head = 0;
+	}
+
+	void EventQueue::BeginDispatch()
+	{
+		m_Stats.RawEvents = m_RawEvents;
+		m_Stats.DeliveredEvents = 0;
+		m_RawEvents = 0;
+
+		m_DeliveredMouseHistory.swap(m_MouseHistory);
+		m_MouseHistory.clear();
+	}
+
+	void EventQueue::SetMouseHistoryEnabled(bool enabled)
+	{
+		m_RecordMouseHistory = enabled;
+		if (enabled)
+		{
+			// Enough for a 1000Hz mouse at 4 samples per frame before the first growth
+			m_MouseHistory.reserve(256);
+			m_DeliveredMouseHistory.reserve(256);
+		}
+		else
+		{
+			m_MouseHistory.clear();
+			m_DeliveredMouseHistory.clear();
+		}
+	}
+
+	void EventQueue::RecordMouseSample(float x, float y)
+	{
+		m_MouseHistory.push_back({ x, y, Time::GetTime() });
+	}
+
+}
@@ -0,0 +1,145 @@
+#pragma once
+
+#include "Dymatic/Events/ApplicationEvent.h"
+#include "Dymatic/Events/KeyEvent.h"
+#include "Dymatic/Events/MouseEvent.h"
+
+#include <variant>
+#include <vector>
+#include <type_traits>
+
+namespace Dymatic {
+
+	// Every event a window can raise, stored by value so the queue never allocates per event
+	using QueuedEvent = std::variant<
+		WindowCloseEvent, WindowResizeEvent, WindowLostFocusEvent,
+		KeyPressedEvent, KeyReleasedEvent, KeyTypedEvent,
+		MouseButtonPressedEvent, MouseButtonReleasedEvent, MouseMovedEvent, MouseScrolledEvent>;
+
+	// Cursor position as reported by the OS, before moves were coalesced
+	struct MouseSample
+	{
+		float X, Y;
+		double Time; // Seconds from Time::GetTime()
+	};
+
+	// Ring of events collected while the window polls, dispatched in one batch at the start of the next frame.
+	// Consecutive mouse moves collapse into the latest one and consecutive scrolls are summed,
+	// so a high polling rate mouse costs one traversal of the layer stack per frame.
+	class EventQueue
+	{
+	public:
+		struct Statistics
+		{
+			uint32_t RawEvents = 0;       // Pushed by the window
+			uint32_t DeliveredEvents = 0; // Left after coalescing
+		};
+	public:
+		EventQueue(uint32_t capacity = 1024);
+
+		template<typename T>
+		void Push(const T& event)
+		{
+			m_RawEvents++;
+
+			if constexpr (std::is_same_v<T, MouseMovedEvent>)
+			{
+				if (m_RecordMouseHistory)
+					RecordMouseSample(event.GetX(), event.GetY());
+
+				if (m_Coalesce)
+				{
+					if (auto* last = GetLast<MouseMovedEvent>())
+					{
+						*last = event;
+						return;
+					}
+				}
+			}
+			else if constexpr (std::is_same_v<T, MouseScrolledEvent>)
+			{
+				if (m_Coalesce)
+				{
+					if (auto* last = GetLast<MouseScrolledEvent>())
+					{
+						*last = MouseScrolledEvent(last->GetXOffset() + event.GetXOffset(), last->GetYOffset() + event.GetYOffset());
+						return;
+					}
+				}
+			}
+
+			if (m_Count == m_Events.size())
+				Grow();
+
+			m_Events[(m_Head + m_Count) & (m_Events.size() - 1)] = event;
+			m_Count++;
+		}
+
+		// Calls func with each event as its concrete type in the order they were pushed, then empties the queue.
+		// Events pushed while dispatching are dispatched in the same call.
+		template<typename F>
+		void Dispatch(F&& func)
+		{
+			BeginDispatch();
+
+			while (m_Count > 0)
+			{
+				QueuedEvent event = m_Events[m_Head];
+				m_Head = (m_Head + 1) & (m_Events.size() - 1);
+				m_Count--;
+
+				m_Stats.DeliveredEvents++;
+				std::visit(func, event);
+			}
+		}
+
+		// Visits queued events in order without removing them
+		template<typename F>
+		void ForEach(F&& func) const
+		{
+			for (uint32_t i = 0; i < m_Count; i++)
+				std::visit(func, m_Events[(m_Head + i) & (m_Events.size() - 1)]);
+		}
+
+		uint32_t GetCount() const { return m_Count; }
+		uint32_t GetCapacity() const { return (uint32_t)m_Events.size(); }
+
+		void SetCoalescing(bool enabled) { m_Coalesce = enabled; }
+		bool IsCoalescing() const { return m_Coalesce; }
+
+		// Keeps every cursor position the window reported, for consumers that need more than one per frame
+		void SetMouseHistoryEnabled(bool enabled);
+		// Samples behind the mouse moves of the last Dispatch, oldest first
+		const std::vector<MouseSample>& GetMouseHistory() const { return m_DeliveredMouseHistory; }
+
+		// Counts for the last Dispatch
+		const Statistics& GetStats() const { return m_Stats; }
+	private:
+		template<typename T>
+		T* GetLast()
+		{
+			if (m_Count == 0)
+				return nullptr;
+
+			return std::get_if<T>(&m_Events[(m_Head + m_Count - 1) & (m_Events.size() - 1)]);
+		}
+
+		void Grow();
+		void BeginDispatch();
+		void RecordMouseSample(float x, float y);
+	private:
+		std::vector<QueuedEvent> m_Events;
+		uint32_t m_Head = 0;
+		uint32_t m_Count = 0;
+
+		bool m_Coalesce = true;
+		uint32_t m_RawEvents = 0;
+		Statistics m_Stats;
+
+		// Filled while polling, handed over to m_DeliveredMouseHistory on Dispatch. Both keep their capacity.
+		bool m_RecordMouseHistory = false;
+		std::vector<MouseSample> m_MouseHistory;
+		std::vector<MouseSample> m_DeliveredMouseHistory;
+	};
+
+}
@@ -18,6 +18,13 @@ namespace Dymatic {
 	ImGuiLayer::ImGuiLayer()
 		: Layer("ImGuiLayer")
 	{
+		m_EventHandlers.Bind<KeyPressedEvent, &ImGuiLayer::OnKeyboardEvent>(this);
+		m_EventHandlers.Bind<KeyReleasedEvent, &ImGuiLayer::OnKeyboardEvent>(this);
+		m_EventHandlers.Bind<KeyTypedEvent, &ImGuiLayer::OnKeyboardEvent>(this);
+		m_EventHandlers.Bind<MouseButtonPressedEvent, &ImGuiLayer::OnMouseEvent>(this);
+		m_EventHandlers.Bind<MouseButtonReleasedEvent, &ImGuiLayer::OnMouseEvent>(this);
+		m_EventHandlers.Bind<MouseMovedEvent, &ImGuiLayer::OnMouseEvent>(this);
+		m_EventHandlers.Bind<MouseScrolledEvent, &ImGuiLayer::OnMouseEvent>(this);
 	}
 
 	void ImGuiLayer::OnAttach()
@@ -69,14 +76,14 @@ namespace Dymatic {
 		ImGui::DestroyContext();
 	}
 
-	void ImGuiLayer::OnEvent(Event& e)
+	bool ImGuiLayer::OnMouseEvent(Event&)
 	{
-		if (m_BlockEvents)
-		{
-			ImGuiIO& io = ImGui::GetIO();
-			e.Handled |= e.IsInCategory(EventCategoryMouse) & io.WantCaptureMouse;
-			e.Handled |= e.IsInCategory(EventCategoryKeyboard) & io.WantCaptureKeyboard;
-		}
+		return m_BlockEvents && ImGui::GetIO().WantCaptureMouse;
+	}
+
+	bool ImGuiLayer::OnKeyboardEvent(Event&)
+	{
+		return m_BlockEvents && ImGui::GetIO().WantCaptureKeyboard;
 	}
 
 	void ImGuiLayer::Begin()
@@ -16,7 +16,6 @@ namespace Dymatic {
 
 		virtual void OnAttach() override;
 		virtual void OnDetach() override;
-		virtual void OnEvent(Event& e) override;
 
 		void Begin();
 		void End();
@@ -24,6 +23,10 @@ namespace Dymatic {
 		void BlockEvents(bool block) { m_BlockEvents = block; }
 
 		void SetDarkThemeColors();
+	private:
+		// Mark input ImGui wants to capture as handled so the layers below never see it
+		bool OnMouseEvent(Event&);
+		bool OnKeyboardEvent(Event&);
 	private:
 		bool m_BlockEvents = true;
 		float m_Time = 0.0f;
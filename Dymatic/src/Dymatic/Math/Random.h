@@ -0,0 +1,38 @@
+#pragma once
+
+#include <cstdint>
+
+namespace Dymatic::Math {
+
+	// Counter based random numbers: every value is a pure function of the seed and its position in
+	// the stream, so work split across any number of threads still draws exactly the same numbers.
+	// Each value is a splitmix64 finalization of the counter keyed by the hashed seed.
+	class CounterRandom
+	{
+	public:
+		CounterRandom(uint64_t seed = 0, uint64_t counter = 0)
+			: m_Key(Mix(seed)), m_Counter(counter) {}
+
+		uint32_t UInt() { return Generate(m_Key, m_Counter++); }
+		// Uniform in [0, 1)
+		float Float() { return (UInt() >> 8) * (1.0f / 16777216.0f); }
+
+		uint64_t GetCounter() const { return m_Counter; }
+
+		static uint32_t Generate(uint64_t key, uint64_t counter)
+		{
+			return (uint32_t)(Mix(key + counter * 0x9E3779B97F4A7C15ull) >> 32);
+		}
+	private:
+		static uint64_t Mix(uint64_t z)
+		{
+			z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+			z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+			return z ^ (z >> 31);
+		}
+	private:
+		uint64_t m_Key;
+		uint64_t m_Counter;
+	};
+
+}
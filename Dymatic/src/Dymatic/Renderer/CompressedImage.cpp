@@ -0,0 +1,369 @@
+#include "dypch.h"
+#include "Dymatic/Renderer/CompressedImage.h"
+
+#include <filesystem>
+#include <fstream>
+
+namespace Dymatic {
+
+	namespace Utils {
+
+		static bool ReadFile(const std::string& path, std::vector<uint8_t>& outData)
+		{
+			std::ifstream in(path, std::ios::in | std::ios::binary);
+			if (!in)
+			{
+				DY_CORE_ERROR("Could not open file '{0}'", path);
+				return false;
+			}
+
+			in.seekg(0, std::ios::end);
+			outData.resize((size_t)in.tellg());
+			in.seekg(0, std::ios::beg);
+			in.read((char*)outData.data(), outData.size());
+			return true;
+		}
+
+		static uint32_t ReadU32(const uint8_t* data)
+		{
+			return (uint32_t)data[0] | ((uint32_t)data[1] << 8) | ((uint32_t)data[2] << 16) | ((uint32_t)data[3] << 24);
+		}
+
+		static uint64_t ReadU64(const uint8_t* data)
+		{
+			return (uint64_t)ReadU32(data) | ((uint64_t)ReadU32(data + 4) << 32);
+		}
+
+		static constexpr uint32_t FourCC(char a, char b, char c, char d)
+		{
+			return (uint32_t)a | ((uint32_t)b << 8) | ((uint32_t)c << 16) | ((uint32_t)d << 24);
+		}
+
+		// Reorders the 4 rows of 2 bit color indices in a BC1 block, row r becomes source row rows[r]
+		static void PermuteBC1Rows(uint8_t* block, const uint32_t rows[4])
+		{
+			uint8_t indices[4] = { block[4], block[5], block[6], block[7] };
+			for (uint32_t r = 0; r < 4; r++)
+				block[4 + r] = indices[rows[r]];
+		}
+
+		// Same for the 3 bit alpha indices of a BC3 block, 12 bits per row after the two endpoints
+		static void PermuteBC3AlphaRows(uint8_t* block, const uint32_t rows[4])
+		{
+			uint64_t bits = 0;
+			for (int i = 0; i < 6; i++)
+				bits |= (uint64_t)block[2 + i] << (8 * i);
+
+			uint64_t permuted = 0;
+			for (uint32_t r = 0; r < 4; r++)
+				permuted |= ((bits >> (12 * rows[r])) & 0xFFF) << (12 * r);
+
+			for (int i = 0; i < 6; i++)
+				block[2 + i] = (uint8_t)(permuted >> (8 * i));
+		}
+
+	}
+
+	uint32_t CompressedImage::GetBlockSize(CompressedTextureFormat format)
+	{
+		switch (format)
+		{
+		case CompressedTextureFormat::BC1:
+		case CompressedTextureFormat::BC1A: return 8;
+		case CompressedTextureFormat::BC3:
+		case CompressedTextureFormat::BC7:  return 16;
+		default:                            break;
+		}
+
+		DY_CORE_ASSERT(false, "Unknown compressed texture format!");
+		return 0;
+	}
+
+	bool CompressedImage::FlipVertically()
+	{
+		if (Format == CompressedTextureFormat::BC7)
+			return false;
+
+		// Only complete blocks can be reordered, a level with a partial block row would shift by the padding
+		for (const Level& level : Levels)
+		{
+			if (level.Height > 4 && level.Height % 4 != 0)
+				return false;
+		}
+
+		uint32_t blockSize = GetBlockSize(Format);
+		std::vector<uint8_t> row;
+		for (const Level& level : Levels)
+		{
+			uint8_t* data = Data.data() + level.Offset;
+			uint32_t blocksX = (level.Width + 3) / 4;
+			uint32_t blocksY = (level.Height + 3) / 4;
+			size_t rowSize = (size_t)blocksX * blockSize;
+
+			// Whole blocks swap rows, a level shorter than a block only mirrors its used rows
+			uint32_t rows[4] = { 3, 2, 1, 0 };
+			if (level.Height < 4)
+			{
+				for (uint32_t r = 0; r < 4; r++)
+					rows[r] = r < level.Height ? level.Height - 1 - r : r;
+			}
+
+			row.resize(rowSize);
+			for (uint32_t y = 0; y < blocksY / 2; y++)
+			{
+				uint8_t* top = data + y * rowSize;
+				uint8_t* bottom = data + (blocksY - 1 - y) * rowSize;
+				memcpy(row.data(), top, rowSize);
+				memcpy(top, bottom, rowSize);
+				memcpy(bottom, row.data(), rowSize);
+			}
+
+			for (uint32_t block = 0; block < blocksX * blocksY; block++)
+			{
+				uint8_t* blockData = data + (size_t)block * blockSize;
+				if (Format == CompressedTextureFormat::BC3)
+				{
+					Utils::PermuteBC3AlphaRows(blockData, rows);
+					blockData += 8;
+				}
+				Utils::PermuteBC1Rows(blockData, rows);
+			}
+		}
+
+		return true;
+	}
+
+	size_t CompressedImage::CalculateLevelSize(CompressedTextureFormat format, uint32_t width, uint32_t height)
+	{
+		return (size_t)((width + 3) / 4) * ((height + 3) / 4) * GetBlockSize(format);
+	}
+
+	bool CompressedImage::IsCompressedFile(const std::string& path)
+	{
+		std::string extension = std::filesystem::path(path).extension().string();
+		std::transform(extension.begin(), extension.end(), extension.begin(), ::tolower);
+		return extension == ".dds" || extension == ".ktx2";
+	}
+
+	bool CompressedImage::Load(const std::string& path, CompressedImage& outImage)
+	{
+		std::string extension = std::filesystem::path(path).extension().string();
+		std::transform(extension.begin(), extension.end(), extension.begin(), ::tolower);
+
+		if (extension == ".dds")
+			return LoadDDS(path, outImage);
+		if (extension == ".ktx2")
+			return LoadKTX2(path, outImage);
+
+		DY_CORE_ERROR("Unsupported compressed texture container '{0}'", path);
+		return false;
+	}
+
+	bool CompressedImage::LoadDDS(const std::string& path, CompressedImage& outImage)
+	{
+		DY_PROFILE_FUNCTION();
+
+		std::vector<uint8_t> file;
+		if (!Utils::ReadFile(path, file))
+			return false;
+
+		// "DDS " + DDS_HEADER (124 bytes)
+		if (file.size() < 128 || Utils::ReadU32(file.data()) != Utils::FourCC('D', 'D', 'S', ' '))
+		{
+			DY_CORE_ERROR("'{0}' is not a DDS file", path);
+			return false;
+		}
+
+		const uint8_t* header = file.data() + 4;
+		uint32_t height = Utils::ReadU32(header + 8);
+		uint32_t width = Utils::ReadU32(header + 12);
+		uint32_t mipCount = std::max(Utils::ReadU32(header + 24), 1u);
+		uint32_t pixelFormatFlags = Utils::ReadU32(header + 76);
+		uint32_t fourCC = Utils::ReadU32(header + 80);
+
+		const uint32_t DDPF_FOURCC = 0x4;
+		if (!(pixelFormatFlags & DDPF_FOURCC))
+		{
+			DY_CORE_ERROR("'{0}' is not block compressed", path);
+			return false;
+		}
+
+		size_t offset = 128;
+		CompressedTextureFormat format = CompressedTextureFormat::None;
+		bool srgb = false;
+		if (fourCC == Utils::FourCC('D', 'X', 'T', '1'))
+			format = CompressedTextureFormat::BC1;
+		else if (fourCC == Utils::FourCC('D', 'X', 'T', '5'))
+			format = CompressedTextureFormat::BC3;
+		else if (fourCC == Utils::FourCC('D', 'X', '1', '0'))
+		{
+			// DDS_HEADER_DXT10 follows, the first field is the DXGI_FORMAT
+			if (file.size() < 148)
+				return false;
+
+			switch (Utils::ReadU32(file.data() + 128))
+			{
+			case 71: format = CompressedTextureFormat::BC1; break;                // DXGI_FORMAT_BC1_UNORM
+			case 72: format = CompressedTextureFormat::BC1; srgb = true; break;   // DXGI_FORMAT_BC1_UNORM_SRGB
+			case 77: format = CompressedTextureFormat::BC3; break;                // DXGI_FORMAT_BC3_UNORM
+			case 78: format = CompressedTextureFormat::BC3; srgb = true; break;   // DXGI_FORMAT_BC3_UNORM_SRGB
+			case 98: format = CompressedTextureFormat::BC7; break;                // DXGI_FORMAT_BC7_UNORM
+			case 99: format = CompressedTextureFormat::BC7; srgb = true; break;   // DXGI_FORMAT_BC7_UNORM_SRGB
+			}
+			offset += 20;
+		}
+
+		if (format == CompressedTextureFormat::None)
+		{
+			DY_CORE_ERROR("'{0}' uses an unsupported DDS format", path);
+			return false;
+		}
+
+		outImage.Format = format;
+		outImage.SRGB = srgb;
+		outImage.Width = width;
+		outImage.Height = height;
+		outImage.Levels.clear();
+
+		size_t dataOffset = 0;
+		for (uint32_t level = 0; level < mipCount; level++)
+		{
+			uint32_t levelWidth = std::max(width >> level, 1u);
+			uint32_t levelHeight = std::max(height >> level, 1u);
+			size_t size = CalculateLevelSize(format, levelWidth, levelHeight);
+			if (offset + dataOffset + size > file.size())
+			{
+				DY_CORE_ERROR("'{0}' is truncated", path);
+				return false;
+			}
+
+			outImage.Levels.push_back({ levelWidth, levelHeight, dataOffset, size });
+			dataOffset += size;
+		}
+
+		outImage.Data.assign(file.begin() + offset, file.begin() + offset + dataOffset);
+
+		// The TextureCooker tags its files in dwReserved1, anything else is top-down
+		bool bottomUp = Utils::ReadU32(header + 28) == Utils::FourCC('D', 'Y', 'B', 'U');
+		if (!bottomUp && !outImage.FlipVertically())
+		{
+			DY_CORE_ERROR("'{0}' can't be flipped to bottom-up rows without re-encoding, cook it with the TextureCooker or use BC1/BC3 with sizes that are multiples of 4", path);
+			return false;
+		}
+		return true;
+	}
+
+	bool CompressedImage::LoadKTX2(const std::string& path, CompressedImage& outImage)
+	{
+		DY_PROFILE_FUNCTION();
+
+		std::vector<uint8_t> file;
+		if (!Utils::ReadFile(path, file))
+			return false;
+
+		static const uint8_t identifier[12] = { 0xAB, 'K', 'T', 'X', ' ', '2', '0', 0xBB, '\r', '\n', 0x1A, '\n' };
+		const size_t headerSize = 80;
+		if (file.size() < headerSize || memcmp(file.data(), identifier, sizeof(identifier)) != 0)
+		{
+			DY_CORE_ERROR("'{0}' is not a KTX2 file", path);
+			return false;
+		}
+
+		const uint8_t* header = file.data() + 12;
+		uint32_t vkFormat = Utils::ReadU32(header + 0);
+		uint32_t width = Utils::ReadU32(header + 8);
+		uint32_t height = Utils::ReadU32(header + 12);
+		uint32_t layerCount = Utils::ReadU32(header + 20);
+		uint32_t faceCount = Utils::ReadU32(header + 24);
+		uint32_t levelCount = std::max(Utils::ReadU32(header + 28), 1u);
+		uint32_t supercompression = Utils::ReadU32(header + 32);
+		uint32_t keyValueOffset = Utils::ReadU32(header + 44);
+		uint32_t keyValueLength = Utils::ReadU32(header + 48);
+
+		if (supercompression != 0 || layerCount > 1 || faceCount != 1)
+		{
+			DY_CORE_ERROR("'{0}' uses supercompression, array layers or cube faces, which are not supported", path);
+			return false;
+		}
+
+		CompressedTextureFormat format = CompressedTextureFormat::None;
+		bool srgb = false;
+		switch (vkFormat)
+		{
+		case 131: format = CompressedTextureFormat::BC1; break;                 // VK_FORMAT_BC1_RGB_UNORM_BLOCK
+		case 132: format = CompressedTextureFormat::BC1; srgb = true; break;    // VK_FORMAT_BC1_RGB_SRGB_BLOCK
+		case 133: format = CompressedTextureFormat::BC1A; break;                // VK_FORMAT_BC1_RGBA_UNORM_BLOCK
+		case 134: format = CompressedTextureFormat::BC1A; srgb = true; break;   // VK_FORMAT_BC1_RGBA_SRGB_BLOCK
+		case 137: format = CompressedTextureFormat::BC3; break;                 // VK_FORMAT_BC3_UNORM_BLOCK
+		case 138: format = CompressedTextureFormat::BC3; srgb = true; break;    // VK_FORMAT_BC3_SRGB_BLOCK
+		case 145: format = CompressedTextureFormat::BC7; break;                 // VK_FORMAT_BC7_UNORM_BLOCK
+		case 146: format = CompressedTextureFormat::BC7; srgb = true; break;    // VK_FORMAT_BC7_SRGB_BLOCK
+		}
+
+		if (format == CompressedTextureFormat::None)
+		{
+			DY_CORE_ERROR("'{0}' uses an unsupported KTX2 format ({1})", path, vkFormat);
+			return false;
+		}
+
+		// The level index follows the header, one { byteOffset, byteLength, uncompressedByteLength } per level
+		const size_t levelIndexOffset = headerSize;
+		if (file.size() < levelIndexOffset + (size_t)levelCount * 24)
+			return false;
+
+		outImage.Format = format;
+		outImage.SRGB = srgb;
+		outImage.Width = width;
+		outImage.Height = height;
+		outImage.Levels.clear();
+		outImage.Data.clear();
+
+		for (uint32_t level = 0; level < levelCount; level++)
+		{
+			const uint8_t* entry = file.data() + levelIndexOffset + level * 24;
+			uint64_t byteOffset = Utils::ReadU64(entry);
+			uint64_t byteLength = Utils::ReadU64(entry + 8);
+
+			uint32_t levelWidth = std::max(width >> level, 1u);
+			uint32_t levelHeight = std::max(height >> level, 1u);
+			if (byteOffset + byteLength > file.size() || byteLength < CalculateLevelSize(format, levelWidth, levelHeight))
+			{
+				DY_CORE_ERROR("'{0}' is truncated", path);
+				return false;
+			}
+
+			outImage.Levels.push_back({ levelWidth, levelHeight, outImage.Data.size(), (size_t)byteLength });
+			outImage.Data.insert(outImage.Data.end(), file.begin() + byteOffset, file.begin() + byteOffset + byteLength);
+		}
+
+		// KTXorientation defaults to "rd", rows going down. Its second letter is 'u' for bottom-up rows.
+		bool bottomUp = false;
+		if ((size_t)keyValueOffset + keyValueLength <= file.size())
+		{
+			const uint8_t* entry = file.data() + keyValueOffset;
+			const uint8_t* end = entry + keyValueLength;
+			while (entry + 4 <= end)
+			{
+				uint32_t length = Utils::ReadU32(entry);
+				const char* key = (const char*)entry + 4;
+				if (entry + 4 + length > end)
+					break;
+
+				const char orientationKey[] = "KTXorientation";
+				if (length > sizeof(orientationKey) && memcmp(key, orientationKey, sizeof(orientationKey)) == 0)
+					bottomUp = length > sizeof(orientationKey) + 1 && key[sizeof(orientationKey) + 1] == 'u';
+
+				// Entries are padded to 4 bytes
+				entry += 4 + ((length + 3) & ~3u);
+			}
+		}
+
+		if (!bottomUp && !outImage.FlipVertically())
+		{
+			DY_CORE_ERROR("'{0}' can't be flipped to bottom-up rows without re-encoding, write it with KTXorientation \"ru\" or use BC1/BC3 with sizes that are multiples of 4", path);
+			return false;
+		}
+		return true;
+	}
+
+}
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+namespace Dymatic {
+
+	enum class CompressedTextureFormat
+	{
+		None = 0,
+		BC1,  // RGB, 4 bits per pixel
+		BC1A, // RGB with 1 bit alpha, 4 bits per pixel
+		BC3,  // RGBA, 8 bits per pixel
+		BC7   // RGBA, 8 bits per pixel
+	};
+
+	// Block compressed image with its whole mip chain, read from a DDS or KTX2 container.
+	// Rows end up bottom-up like every other texture in the engine. DDS and KTX2 files store them
+	// top-down, so BC1 and BC3 blocks are flipped while loading. DDS files tagged by the
+	// TextureCooker and KTX2 files whose KTXorientation points up are already bottom-up. Files that
+	// would need flipping but can't be flipped without re-encoding are rejected: BC7, where moving
+	// pixels changes the partition anchors, and levels taller than one block whose height is not a
+	// multiple of 4.
+	struct CompressedImage
+	{
+		struct Level
+		{
+			uint32_t Width = 0, Height = 0;
+			size_t Offset = 0, Size = 0;
+		};
+
+		CompressedTextureFormat Format = CompressedTextureFormat::None;
+		bool SRGB = false;
+		uint32_t Width = 0, Height = 0;
+
+		std::vector<Level> Levels;
+		std::vector<uint8_t> Data;
+
+		const uint8_t* GetLevelData(uint32_t level) const { return Data.data() + Levels[level].Offset; }
+
+		static bool IsCompressedFile(const std::string& path);
+
+		// Picks the container from the file extension
+		static bool Load(const std::string& path, CompressedImage& outImage);
+		static bool LoadDDS(const std::string& path, CompressedImage& outImage);
+		static bool LoadKTX2(const std::string& path, CompressedImage& outImage);
+
+		// Converts top-down rows to bottom-up, returns false if the format or sizes don't allow it
+		bool FlipVertically();
+
+		static uint32_t GetBlockSize(CompressedTextureFormat format);
+		static size_t CalculateLevelSize(CompressedTextureFormat format, uint32_t width, uint32_t height);
+	};
+
+}
@@ -7,6 +7,8 @@
 
 namespace Dymatic {
 
+	uint64_t Framebuffer::s_AllocationCount = 0;
+
 	Ref<Framebuffer> Framebuffer::Create(const FramebufferSpecification& spec)
 	{
 		switch (Renderer::GetAPI())
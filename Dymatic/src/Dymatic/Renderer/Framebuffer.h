@@ -2,11 +2,51 @@
 
 #include "Dymatic/Core/Base.h"
 
+#include <glm/glm.hpp>
+
 namespace Dymatic {
 
+	enum class FramebufferTextureFormat
+	{
+		None = 0,
+
+		// Color
+		RGBA8,
+		RGBA16F,
+		RED_INTEGER,
+
+		// Depth/stencil
+		DEPTH24STENCIL8,
+		DEPTH32F,
+
+		// Defaults
+		Depth = DEPTH24STENCIL8
+	};
+
+	struct FramebufferTextureSpecification
+	{
+		FramebufferTextureSpecification() = default;
+		FramebufferTextureSpecification(FramebufferTextureFormat format)
+			: TextureFormat(format) {}
+
+		FramebufferTextureFormat TextureFormat = FramebufferTextureFormat::None;
+	};
+
+	struct FramebufferAttachmentSpecification
+	{
+		FramebufferAttachmentSpecification() = default;
+		FramebufferAttachmentSpecification(std::initializer_list<FramebufferTextureSpecification> attachments)
+			: Attachments(attachments) {}
+
+		std::vector<FramebufferTextureSpecification> Attachments;
+	};
+
 	struct FramebufferSpecification
 	{
 		uint32_t Width = 0, Height = 0;
+		// Color attachments in order, at most one depth attachment anywhere in the list
+		FramebufferAttachmentSpecification Attachments = { FramebufferTextureFormat::RGBA8, FramebufferTextureFormat::Depth };
+		// More than one renders into multisampled attachments, which are resolved by Unbind()
 		uint32_t Samples = 1;
 
 		bool SwapChainTarget = false;
@@ -19,13 +59,25 @@ namespace Dymatic {
 		virtual void Bind() = 0;
 		virtual void Unbind() = 0;
 
+		// Attachments are allocated in rounded up sizes, a resize that still fits only changes the viewport
 		virtual void Resize(uint32_t width, uint32_t height) = 0;
+		virtual int ReadPixel(uint32_t attachmentIndex, int x, int y) = 0;
 
-		virtual uint32_t GetColorAttachmentRendererID() const = 0;
+		virtual void ClearAttachment(uint32_t attachmentIndex, int value) = 0;
+
+		// Always single sampled, multisampled attachments return their resolve target
+		virtual uint32_t GetColorAttachmentRendererID(uint32_t index = 0) const = 0;
+		// Part of the attachment textures covered by the specification's size, the maximum texture coordinate to sample
+		virtual glm::vec2 GetTextureCoordinateScale() const = 0;
 
 		virtual const FramebufferSpecification& GetSpecification() const = 0;
 
+		// Attachment textures created by all framebuffers since startup
+		static uint64_t GetAllocationCount() { return s_AllocationCount; }
+
 		static Ref<Framebuffer> Create(const FramebufferSpecification& spec);
+	protected:
+		static uint64_t s_AllocationCount;
 	};
 
 }
@@ -0,0 +1,241 @@
+#include "dypch.h"
+#include "Dymatic/Renderer/GPUParticleSystem.h"
+
+#include "Dymatic/Renderer/Renderer.h"
+#include "Dymatic/Renderer/Renderer2D.h"
+#include "Dymatic/Renderer/RenderCommand.h"
+#include "Dymatic/Renderer/StorageBuffer.h"
+#include "Dymatic/Renderer/Shader.h"
+#include "Dymatic/Renderer/VertexArray.h"
+#include "Dymatic/Renderer/GPUProfiler.h"
+#include "Dymatic/Math/Random.h"
+
+#include <glm/gtc/constants.hpp>
+
+namespace Dymatic {
+
+	// Must match local_size_x in ParticleUpdate.glsl
+	static const uint32_t s_WorkGroupSize = 256;
+	static const uint32_t s_ParticleBinding = 0;
+
+	// Random values drawn per emitted particle
+	static const uint32_t s_RandomValuesPerParticle = 4;
+
+	static Ref<Shader> LoadShader(const std::string& name, const std::string& filepath)
+	{
+		auto& library = Renderer::GetShaderLibrary();
+		return library->Exists(name) ? library->Get(name) : library->Load(filepath);
+	}
+
+	GPUParticleSystem::GPUParticleSystem(uint32_t maxParticles, uint64_t seed, bool useCompute)
+		: m_MaxParticles(maxParticles), m_Seed(seed), m_UseCompute(useCompute && RenderCommand::SupportsCompute())
+	{
+		DY_PROFILE_FUNCTION();
+
+		if (useCompute && !m_UseCompute)
+			DY_CORE_WARN("Compute shaders are not supported, particles are simulated on the CPU");
+
+		// Zeroed slots have no life left, so every slot starts out dead
+		std::vector<GPUParticle> initial(maxParticles, GPUParticle{});
+		if (!m_UseCompute)
+		{
+			m_CPUParticles = std::move(initial);
+			return;
+		}
+
+		m_ParticleBuffer = StorageBuffer::Create(maxParticles * sizeof(GPUParticle), s_ParticleBinding);
+		m_ParticleBuffer->SetData(initial.data(), maxParticles * sizeof(GPUParticle));
+
+		m_UpdateShader = LoadShader("ParticleUpdate", "assets/shaders/ParticleUpdate.glsl");
+		m_RenderShader = LoadShader("Particle", "assets/shaders/Particle.glsl");
+
+		float corners[4 * 2] = {
+			-0.5f, -0.5f,
+			 0.5f, -0.5f,
+			 0.5f,  0.5f,
+			-0.5f,  0.5f
+		};
+		uint32_t indices[6] = { 0, 1, 2, 2, 3, 0 };
+
+		m_QuadVertexArray = VertexArray::Create();
+		Ref<VertexBuffer> cornerBuffer = VertexBuffer::Create(corners, sizeof(corners));
+		cornerBuffer->SetLayout({
+			{ ShaderDataType::Float2, "a_Corner" }
+			});
+		m_QuadVertexArray->AddVertexBuffer(cornerBuffer);
+		m_QuadVertexArray->SetIndexBuffer(IndexBuffer::Create(indices, 6));
+	}
+
+	void GPUParticleSystem::OnUpdate(Timestep ts)
+	{
+		DY_PROFILE_FUNCTION();
+
+		if (!m_UseCompute)
+		{
+			Simulate(m_CPUParticles.data(), m_MaxParticles, ts);
+			return;
+		}
+
+		DY_PROFILE_GPU_SCOPE("GPUParticleSystem::OnUpdate");
+
+		m_UpdateShader->Bind();
+		m_UpdateShader->SetFloat("u_DeltaTime", ts);
+		m_UpdateShader->SetInt("u_Count", (int)m_MaxParticles);
+		m_ParticleBuffer->Bind();
+		RenderCommand::DispatchCompute((m_MaxParticles + s_WorkGroupSize - 1) / s_WorkGroupSize);
+	}
+
+	void GPUParticleSystem::OnRender(float depth)
+	{
+		DY_PROFILE_FUNCTION();
+
+		if (!m_UseCompute)
+		{
+			RenderCPU(depth);
+			return;
+		}
+
+		DY_PROFILE_GPU_SCOPE("GPUParticleSystem::OnRender");
+
+		m_RenderShader->Bind();
+		m_RenderShader->SetFloat("u_Depth", depth);
+		m_ParticleBuffer->Bind();
+		RenderCommand::DrawIndexedInstanced(m_QuadVertexArray, 6, m_MaxParticles);
+	}
+
+	void GPUParticleSystem::RenderCPU(float depth)
+	{
+		const glm::vec2* textureCoords = Renderer2D::GetQuadTextureCoords();
+
+		uint32_t liveCount = 0;
+		for (const GPUParticle& particle : m_CPUParticles)
+			liveCount += particle.Life > 0.0f;
+
+		// Dead slots are scattered through the ring, so walk it while filling each reservation
+		uint32_t slot = 0;
+		while (liveCount > 0)
+		{
+			uint32_t quadCount = liveCount;
+			Renderer2D::QuadVertex* vertex = Renderer2D::ReserveQuads(quadCount);
+			liveCount -= quadCount;
+
+			for (uint32_t quad = 0; quad < quadCount; slot++)
+			{
+				const GPUParticle& particle = m_CPUParticles[slot];
+				if (particle.Life <= 0.0f)
+					continue;
+
+				// Half extents along the rotated x and y axes, same corners as Particle.glsl
+				float halfSize = particle.Size * 0.5f;
+				float axisX = halfSize * std::cos(particle.Rotation);
+				float axisY = halfSize * std::sin(particle.Rotation);
+
+				float x = particle.Position.x, y = particle.Position.y;
+				glm::vec3 corners[4] = {
+					{ x - axisX + axisY, y - axisY - axisX, depth },
+					{ x + axisX + axisY, y + axisY - axisX, depth },
+					{ x + axisX - axisY, y + axisY + axisX, depth },
+					{ x - axisX - axisY, y - axisY + axisX, depth }
+				};
+
+				for (int corner = 0; corner < 4; corner++)
+				{
+					vertex->Position = corners[corner];
+					vertex->Color = particle.Color;
+					vertex->TexCoord = textureCoords[corner];
+					vertex->TexIndex = 0.0f; // White texture
+					vertex->TilingFactor = 1.0f;
+					vertex++;
+				}
+				quad++;
+			}
+		}
+	}
+
+	void GPUParticleSystem::Emit(const ParticleProps& particleProps, uint32_t count)
+	{
+		DY_PROFILE_FUNCTION();
+
+		DY_CORE_ASSERT(particleProps.LifeTime > 0.0f, "Particle lifetime must be positive!");
+
+		// Anything beyond one full ring would be overwritten again right away
+		count = std::min(count, m_MaxParticles);
+		float inverseLifeTime = 1.0f / particleProps.LifeTime;
+
+		// Same distribution and random sequence as ParticleSystem::Emit
+		m_EmitStaging.resize(count);
+		for (uint32_t n = 0; n < count; n++)
+		{
+			GPUParticle& particle = m_EmitStaging[n];
+			Math::CounterRandom random(m_Seed, (m_EmittedCount + n) * s_RandomValuesPerParticle);
+
+			particle.Position = particleProps.Position;
+			particle.Rotation = random.Float() * glm::two_pi<float>();
+			particle.AngularVelocity = particleProps.AngularVelocity;
+
+			particle.Velocity.x = particleProps.Velocity.x + particleProps.VelocityVariation.x * (random.Float() - 0.5f);
+			particle.Velocity.y = particleProps.Velocity.y + particleProps.VelocityVariation.y * (random.Float() - 0.5f);
+
+			particle.Life = particleProps.LifeTime;
+
+			float sizeBegin = particleProps.SizeBegin + particleProps.SizeVariation * (random.Float() - 0.5f);
+			particle.Size = sizeBegin;
+			particle.SizeRate = (particleProps.SizeEnd - sizeBegin) * inverseLifeTime;
+
+			particle.Color = particleProps.ColorBegin;
+			particle.ColorRate = (particleProps.ColorEnd - particleProps.ColorBegin) * inverseLifeTime;
+		}
+
+		// The ring may wrap, which splits the write in two
+		uint32_t firstPart = std::min(count, m_MaxParticles - m_EmitIndex);
+		Write(m_EmitStaging.data(), m_EmitIndex, firstPart);
+		Write(m_EmitStaging.data() + firstPart, 0, count - firstPart);
+
+		m_EmitIndex = (m_EmitIndex + count) % m_MaxParticles;
+		m_EmittedCount += count;
+	}
+
+	void GPUParticleSystem::Write(const GPUParticle* particles, uint32_t first, uint32_t count)
+	{
+		if (count == 0)
+			return;
+
+		if (m_UseCompute)
+			m_ParticleBuffer->SetData(particles, count * sizeof(GPUParticle), first * sizeof(GPUParticle));
+		else
+			memcpy(m_CPUParticles.data() + first, particles, count * sizeof(GPUParticle));
+	}
+
+	void GPUParticleSystem::GetParticles(std::vector<GPUParticle>& outParticles) const
+	{
+		DY_PROFILE_FUNCTION();
+
+		if (!m_UseCompute)
+		{
+			outParticles = m_CPUParticles;
+			return;
+		}
+
+		outParticles.resize(m_MaxParticles);
+		m_ParticleBuffer->GetData(outParticles.data(), m_MaxParticles * sizeof(GPUParticle));
+	}
+
+	void GPUParticleSystem::Simulate(GPUParticle* particles, uint32_t count, float dt)
+	{
+		DY_PROFILE_FUNCTION();
+
+		for (uint32_t i = 0; i < count; i++)
+		{
+			GPUParticle& particle = particles[i];
+			if (particle.Life <= 0.0f)
+				continue;
+
+			particle.Life -= dt;
+			particle.Position += particle.Velocity * dt;
+			particle.Rotation += particle.AngularVelocity * dt;
+			particle.Size += particle.SizeRate * dt;
+			particle.Color += particle.ColorRate * dt;
+		}
+	}
+
+}
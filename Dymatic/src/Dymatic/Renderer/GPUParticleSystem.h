@@ -0,0 +1,79 @@
+#pragma once
+
+#include "Dymatic/Core/Base.h"
+#include "Dymatic/Core/Timestep.h"
+#include "Dymatic/Renderer/ParticleSystem.h"
+
+#include <glm/glm.hpp>
+
+namespace Dymatic {
+
+	class Shader;
+	class StorageBuffer;
+	class VertexArray;
+
+	// Matches the std430 Particle struct of ParticleUpdate.glsl and Particle.glsl
+	struct GPUParticle
+	{
+		glm::vec4 Color;
+		glm::vec4 ColorRate;
+		glm::vec2 Position;
+		glm::vec2 Velocity;
+		float Rotation;
+		float AngularVelocity;
+		float Life;
+		float Size;
+		float SizeRate;
+		float Padding[3];
+	};
+
+	static_assert(sizeof(GPUParticle) == 80, "GPUParticle must match the std430 layout");
+
+	// Particle system whose state lives in a storage buffer. The ParticleUpdate compute shader
+	// advances it and every slot is drawn as one instance, so particle data never goes through
+	// Renderer2D. Emission writes into a ring, once full the oldest slots are reused whether or not
+	// they died. Without compute support (or with useCompute off) the particles stay in CPU memory,
+	// Simulate advances them and they are submitted to Renderer2D like any other quads. That path
+	// creates no GPU resources until it is rendered, so it also runs without a graphics context.
+	class GPUParticleSystem
+	{
+	public:
+		GPUParticleSystem(uint32_t maxParticles = 1000000, uint64_t seed = 0, bool useCompute = true);
+
+		void OnUpdate(Timestep ts);
+		// With compute this draws immediately with the camera of the last Renderer2D scene, call it
+		// after EndScene. The CPU fallback submits to the current scene, call it before EndScene.
+		void OnRender(float depth = 0.0f);
+
+		void Emit(const ParticleProps& particleProps, uint32_t count = 1);
+
+		bool IsUsingCompute() const { return m_UseCompute; }
+		uint32_t GetMaxParticles() const { return m_MaxParticles; }
+
+		// Reads every slot back, waiting for the GPU when using compute. Only meant for comparing
+		// against Simulate and ParticleSystem.
+		void GetParticles(std::vector<GPUParticle>& outParticles) const;
+
+		// CPU reference of ParticleUpdate.glsl
+		static void Simulate(GPUParticle* particles, uint32_t count, float dt);
+	private:
+		void Write(const GPUParticle* particles, uint32_t first, uint32_t count);
+		void RenderCPU(float depth);
+	private:
+		uint32_t m_MaxParticles;
+		uint64_t m_Seed;
+		uint64_t m_EmittedCount = 0;
+		uint32_t m_EmitIndex = 0;
+
+		bool m_UseCompute;
+
+		Ref<StorageBuffer> m_ParticleBuffer;
+		Ref<Shader> m_UpdateShader, m_RenderShader;
+		Ref<VertexArray> m_QuadVertexArray;
+
+		// Fallback state when not using compute
+		std::vector<GPUParticle> m_CPUParticles;
+		std::vector<GPUParticle> m_EmitStaging;
+	};
+
+}
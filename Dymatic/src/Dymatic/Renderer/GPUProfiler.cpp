@@ -0,0 +1,145 @@
+#include "dypch.h"
+#include "Dymatic/Renderer/GPUProfiler.h"
+
+#include "Dymatic/Renderer/RenderCommand.h"
+
+namespace Dymatic {
+
+	static const uint32_t s_InvalidScope = 0xffffffff;
+
+	struct GPUProfilerData
+	{
+		static const uint32_t FramesInFlight = 3;
+		static const uint32_t MaxScopesPerFrame = 256;
+
+		struct Frame
+		{
+			// Two timestamp queries (begin, end) per scope
+			uint32_t Queries[MaxScopesPerFrame * 2];
+			const char* ScopeNames[MaxScopesPerFrame];
+			uint32_t ScopeCount = 0;
+
+			// CPU (microseconds) and GPU (nanoseconds) clocks sampled together at the start
+			// of the frame, used to place GPU scopes on the CPU trace timeline
+			double CPUCalibration = 0.0;
+			uint64_t GPUCalibration = 0;
+
+			bool Pending = false;
+		};
+
+		Frame Frames[FramesInFlight];
+		uint32_t FrameIndex = 0;
+		bool Initialized = false;
+
+		std::vector<GPUProfiler::ScopeResult> Results;
+	};
+
+	static GPUProfilerData s_GPUData;
+
+	static void ResolveFrame(GPUProfilerData::Frame& frame)
+	{
+		DY_PROFILE_FUNCTION();
+
+		frame.Pending = false;
+
+		// Check that the whole frame is available first so that results are never partial
+		static uint64_t timestamps[GPUProfilerData::MaxScopesPerFrame * 2];
+		for (uint32_t i = 0; i < frame.ScopeCount * 2; i++)
+		{
+			if (!RenderCommand::GetTimestampResult(frame.Queries[i], timestamps[i]))
+				return;
+		}
+
+		s_GPUData.Results.clear();
+		for (uint32_t i = 0; i < frame.ScopeCount; i++)
+		{
+			uint64_t begin = timestamps[i * 2];
+			uint64_t end = std::max(timestamps[i * 2 + 1], begin);
+
+			s_GPUData.Results.push_back({ frame.ScopeNames[i], (float)((end - begin) / 1000000.0) });
+
+			double start = frame.CPUCalibration + ((double)begin - (double)frame.GPUCalibration) / 1000.0;
+			auto elapsedTime = std::chrono::microseconds((end - begin) / 1000);
+			Instrumentor::Get().WriteProfile({ frame.ScopeNames[i], FloatingPointMicroseconds{ start }, elapsedTime, std::this_thread::get_id(), true });
+		}
+	}
+
+	void GPUProfiler::Init()
+	{
+		DY_PROFILE_FUNCTION();
+
+		for (auto& frame : s_GPUData.Frames)
+		{
+			RenderCommand::CreateTimestampQueries(GPUProfilerData::MaxScopesPerFrame * 2, frame.Queries);
+			frame.ScopeCount = 0;
+			frame.Pending = false;
+		}
+
+		s_GPUData.FrameIndex = 0;
+		s_GPUData.Initialized = true;
+	}
+
+	void GPUProfiler::Shutdown()
+	{
+		DY_PROFILE_FUNCTION();
+
+		if (!s_GPUData.Initialized)
+			return;
+
+		for (auto& frame : s_GPUData.Frames)
+			RenderCommand::DeleteTimestampQueries(GPUProfilerData::MaxScopesPerFrame * 2, frame.Queries);
+
+		s_GPUData.Results.clear();
+		s_GPUData.Initialized = false;
+	}
+
+	void GPUProfiler::BeginFrame()
+	{
+		DY_PROFILE_FUNCTION();
+
+		if (!s_GPUData.Initialized)
+			return;
+
+		s_GPUData.FrameIndex = (s_GPUData.FrameIndex + 1) % GPUProfilerData::FramesInFlight;
+		auto& frame = s_GPUData.Frames[s_GPUData.FrameIndex];
+
+		// This slot was last recorded FramesInFlight - 1 frames ago
+		if (frame.Pending)
+			ResolveFrame(frame);
+
+		frame.ScopeCount = 0;
+		frame.CPUCalibration = FloatingPointMicroseconds{ std::chrono::steady_clock::now().time_since_epoch() }.count();
+		frame.GPUCalibration = RenderCommand::GetCurrentTimestamp();
+		frame.Pending = true;
+	}
+
+	uint32_t GPUProfiler::BeginScope(const char* name)
+	{
+		if (!s_GPUData.Initialized)
+			return s_InvalidScope;
+
+		auto& frame = s_GPUData.Frames[s_GPUData.FrameIndex];
+		if (frame.ScopeCount >= GPUProfilerData::MaxScopesPerFrame)
+			return s_InvalidScope;
+
+		uint32_t scope = frame.ScopeCount++;
+		frame.ScopeNames[scope] = name;
+		RenderCommand::RecordTimestamp(frame.Queries[scope * 2]);
+		return scope;
+	}
+
+	void GPUProfiler::EndScope(uint32_t scope)
+	{
+		if (scope == s_InvalidScope || !s_GPUData.Initialized)
+			return;
+
+		auto& frame = s_GPUData.Frames[s_GPUData.FrameIndex];
+		RenderCommand::RecordTimestamp(frame.Queries[scope * 2 + 1]);
+	}
+
+	const std::vector<GPUProfiler::ScopeResult>& GPUProfiler::GetResults()
+	{
+		return s_GPUData.Results;
+	}
+
+}
@@ -0,0 +1,55 @@
+#pragma once
+
+#include "Dymatic/Core/Base.h"
+#include "Dymatic/Debug/Instrumentor.h"
+
+namespace Dymatic {
+
+	class GPUProfiler
+	{
+	public:
+		struct ScopeResult
+		{
+			const char* Name;
+			float Milliseconds;
+		};
+	public:
+		static void Init();
+		static void Shutdown();
+
+		// Advances the query ring and collects results from the oldest frame still in flight.
+		// Results that are not available yet are skipped rather than waited on.
+		static void BeginFrame();
+
+		static uint32_t BeginScope(const char* name);
+		static void EndScope(uint32_t scope);
+
+		// Timings of the most recent frame whose queries have all resolved
+		static const std::vector<ScopeResult>& GetResults();
+	};
+
+	class GPUProfilerScope
+	{
+	public:
+		GPUProfilerScope(const char* name)
+			: m_Scope(GPUProfiler::BeginScope(name))
+		{
+		}
+
+		~GPUProfilerScope()
+		{
+			GPUProfiler::EndScope(m_Scope);
+		}
+	private:
+		uint32_t m_Scope;
+	};
+
+}
+
+#if DY_PROFILE
+#define DY_PROFILE_GPU_SCOPE_LINE2(name, line) ::Dymatic::GPUProfilerScope gpuTimer##line(name)
+#define DY_PROFILE_GPU_SCOPE_LINE(name, line) DY_PROFILE_GPU_SCOPE_LINE2(name, line)
+#define DY_PROFILE_GPU_SCOPE(name) DY_PROFILE_GPU_SCOPE_LINE(name, __LINE__)
+#else
+#define DY_PROFILE_GPU_SCOPE(name)
+#endif
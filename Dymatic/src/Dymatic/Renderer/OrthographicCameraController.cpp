@@ -66,6 +66,12 @@ namespace Dymatic {
 		dispatcher.Dispatch<WindowResizeEvent>(DY_BIND_EVENT_FN(OrthographicCameraController::OnWindowResized));
 	}
 
+	void OrthographicCameraController::BindEventHandlers(EventHandlerTable& handlers)
+	{
+		handlers.Bind<MouseScrolledEvent, &OrthographicCameraController::OnMouseScrolled>(this);
+		handlers.Bind<WindowResizeEvent, &OrthographicCameraController::OnWindowResized>(this);
+	}
+
 	void OrthographicCameraController::OnResize(float width, float height)
 	{
 		m_AspectRatio = width / height;
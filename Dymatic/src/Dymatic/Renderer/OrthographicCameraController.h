@@ -24,6 +24,8 @@ namespace Dymatic {
 
 		void OnUpdate(Timestep ts);
 		void OnEvent(Event& e);
+		// For layers using handler tables, binds the events OnEvent would handle
+		void BindEventHandlers(EventHandlerTable& handlers);
 
 		void OnResize(float width, float height);
 
@@ -0,0 +1,246 @@
+#include "dypch.h"
+#include "Dymatic/Renderer/ParticleSystem.h"
+
+#include "Dymatic/Renderer/Renderer2D.h"
+#include "Dymatic/Core/JobSystem.h"
+#include "Dymatic/Math/Random.h"
+
+#include <glm/gtc/constants.hpp>
+
+#if defined(_M_X64) || defined(__SSE2__) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+	#define DY_PARTICLES_SSE
+	#include <emmintrin.h>
+#endif
+
+namespace Dymatic {
+
+	// Chunk sizes are multiples of 4 so every chunk starts on an aligned SIMD lane
+	static const uint32_t s_UpdateChunkSize = 16384;
+	static const uint32_t s_EmitChunkSize = 4096;
+	static const uint32_t s_RenderChunkSize = 4096;
+
+	// Random values drawn per emitted particle
+	static const uint32_t s_RandomValuesPerParticle = 4;
+
+	namespace Utils {
+
+		// values[i] += rates[i] * dt
+		static void Integrate(float* values, const float* rates, float dt, uint32_t count)
+		{
+			uint32_t i = 0;
+#ifdef DY_PARTICLES_SSE
+			__m128 step = _mm_set1_ps(dt);
+			for (; i + 4 <= count; i += 4)
+				_mm_store_ps(values + i, _mm_add_ps(_mm_load_ps(values + i), _mm_mul_ps(_mm_load_ps(rates + i), step)));
+#endif
+			for (; i < count; i++)
+				values[i] += rates[i] * dt;
+		}
+
+		// values[i] -= dt
+		static void Decrement(float* values, float dt, uint32_t count)
+		{
+			uint32_t i = 0;
+#ifdef DY_PARTICLES_SSE
+			__m128 step = _mm_set1_ps(dt);
+			for (; i + 4 <= count; i += 4)
+				_mm_store_ps(values + i, _mm_sub_ps(_mm_load_ps(values + i), step));
+#endif
+			for (; i < count; i++)
+				values[i] -= dt;
+		}
+
+		// Parabolic approximation with one refinement step, the error stays below 0.001 which is
+		// invisible on a sprite and several times cheaper than std::sin and std::cos per particle
+		static float FastSin(float angle)
+		{
+			constexpr float pi = glm::pi<float>();
+			constexpr float twoPi = glm::two_pi<float>();
+
+			angle -= twoPi * std::floor((angle + pi) / twoPi);
+
+			float y = (4.0f / pi) * angle - (4.0f / (pi * pi)) * angle * std::abs(angle);
+			return 0.225f * (y * std::abs(y) - y) + y;
+		}
+
+	}
+
+	ParticleSystem::ParticleSystem(uint32_t maxParticles, uint64_t seed)
+		: m_MaxParticles(maxParticles), m_Seed(seed)
+	{
+		size_t stride = (maxParticles + 3) & ~3u;
+		m_Data = static_cast<float*>(::operator new(sizeof(float) * stride * StreamCount, std::align_val_t(16)));
+		for (size_t i = 0; i < StreamCount; i++)
+			m_Streams[i] = m_Data + i * stride;
+	}
+
+	ParticleSystem::~ParticleSystem()
+	{
+		::operator delete(m_Data, std::align_val_t(16));
+	}
+
+	void ParticleSystem::OnUpdate(Timestep ts)
+	{
+		DY_PROFILE_FUNCTION();
+
+		float dt = ts;
+
+		JobSystem::ParallelFor(m_Count, s_UpdateChunkSize, [this, dt](uint32_t begin, uint32_t end)
+		{
+			uint32_t count = end - begin;
+			auto integrate = [&](Stream value, Stream rate) { Utils::Integrate(m_Streams[value] + begin, m_Streams[rate] + begin, dt, count); };
+
+			Utils::Decrement(m_Streams[Life] + begin, dt, count);
+			integrate(PositionX, VelocityX);
+			integrate(PositionY, VelocityY);
+			integrate(Rotation, AngularVelocity);
+			integrate(Size, SizeRate);
+			integrate(ColorR, ColorRateR);
+			integrate(ColorG, ColorRateG);
+			integrate(ColorB, ColorRateB);
+			integrate(ColorA, ColorRateA);
+		});
+
+		// Remove dead particles, only the life stream is read for groups where nothing died.
+		// Swap removal depends on order, so this stays on the calling thread.
+		const float* life = m_Streams[Life];
+		for (uint32_t i = 0; i < m_Count;)
+		{
+#ifdef DY_PARTICLES_SSE
+			if (i + 4 <= m_Count && _mm_movemask_ps(_mm_cmple_ps(_mm_loadu_ps(life + i), _mm_setzero_ps())) == 0)
+			{
+				i += 4;
+				continue;
+			}
+#endif
+			if (life[i] <= 0.0f)
+				Kill(i); // The last particle moved into i, so check it next
+			else
+				i++;
+		}
+	}
+
+	void ParticleSystem::OnRender(float depth)
+	{
+		DY_PROFILE_FUNCTION();
+
+		const glm::vec2* textureCoords = Renderer2D::GetQuadTextureCoords();
+
+		const float* positionX = m_Streams[PositionX];
+		const float* positionY = m_Streams[PositionY];
+		const float* rotation = m_Streams[Rotation];
+		const float* size = m_Streams[Size];
+		const float* colorR = m_Streams[ColorR];
+		const float* colorG = m_Streams[ColorG];
+		const float* colorB = m_Streams[ColorB];
+		const float* colorA = m_Streams[ColorA];
+
+		uint32_t index = 0;
+		while (index < m_Count)
+		{
+			uint32_t quadCount = m_Count - index;
+			Renderer2D::QuadVertex* vertices = Renderer2D::ReserveQuads(quadCount);
+
+			uint32_t first = index;
+			JobSystem::ParallelFor(quadCount, s_RenderChunkSize, [=](uint32_t begin, uint32_t end)
+			{
+				Renderer2D::QuadVertex* vertex = vertices + begin * 4;
+				for (uint32_t i = first + begin; i < first + end; i++)
+				{
+					// Half extents along the rotated x and y axes
+					float halfSize = size[i] * 0.5f;
+					float axisX = halfSize * Utils::FastSin(rotation[i] + glm::half_pi<float>());
+					float axisY = halfSize * Utils::FastSin(rotation[i]);
+
+					float x = positionX[i], y = positionY[i];
+					glm::vec3 corners[4] = {
+						{ x - axisX + axisY, y - axisY - axisX, depth },
+						{ x + axisX + axisY, y + axisY - axisX, depth },
+						{ x + axisX - axisY, y + axisY + axisX, depth },
+						{ x - axisX - axisY, y - axisY + axisX, depth }
+					};
+					glm::vec4 color = { colorR[i], colorG[i], colorB[i], colorA[i] };
+
+					for (int corner = 0; corner < 4; corner++)
+					{
+						vertex->Position = corners[corner];
+						vertex->Color = color;
+						vertex->TexCoord = textureCoords[corner];
+						vertex->TexIndex = 0.0f; // White texture
+						vertex->TilingFactor = 1.0f;
+						vertex++;
+					}
+				}
+			});
+
+			index += quadCount;
+		}
+	}
+
+	void ParticleSystem::Emit(const ParticleProps& particleProps, uint32_t count)
+	{
+		DY_CORE_ASSERT(particleProps.LifeTime > 0.0f, "Particle lifetime must be positive!");
+
+		count = std::min(count, m_MaxParticles - m_Count);
+		float inverseLifeTime = 1.0f / particleProps.LifeTime;
+
+		uint32_t first = m_Count;
+		uint64_t firstEmitted = m_EmittedCount;
+		JobSystem::ParallelFor(count, s_EmitChunkSize, [&](uint32_t begin, uint32_t end)
+		{
+			for (uint32_t n = begin; n < end; n++)
+			{
+				uint32_t i = first + n;
+				Math::CounterRandom random(m_Seed, (firstEmitted + n) * s_RandomValuesPerParticle);
+
+				m_Streams[PositionX][i] = particleProps.Position.x;
+				m_Streams[PositionY][i] = particleProps.Position.y;
+
+				m_Streams[Rotation][i] = random.Float() * glm::two_pi<float>();
+				m_Streams[AngularVelocity][i] = particleProps.AngularVelocity;
+
+				// Velocity
+				m_Streams[VelocityX][i] = particleProps.Velocity.x + particleProps.VelocityVariation.x * (random.Float() - 0.5f);
+				m_Streams[VelocityY][i] = particleProps.Velocity.y + particleProps.VelocityVariation.y * (random.Float() - 0.5f);
+
+				m_Streams[Life][i] = particleProps.LifeTime;
+
+				// Size and color reach their end values exactly when the particle dies
+				float sizeBegin = particleProps.SizeBegin + particleProps.SizeVariation * (random.Float() - 0.5f);
+				m_Streams[Size][i] = sizeBegin;
+				m_Streams[SizeRate][i] = (particleProps.SizeEnd - sizeBegin) * inverseLifeTime;
+
+				for (int channel = 0; channel < 4; channel++)
+				{
+					m_Streams[ColorR + channel][i] = particleProps.ColorBegin[channel];
+					m_Streams[ColorRateR + channel][i] = (particleProps.ColorEnd[channel] - particleProps.ColorBegin[channel]) * inverseLifeTime;
+				}
+			}
+		});
+
+		m_Count += count;
+		m_EmittedCount += count;
+	}
+
+	ParticleState ParticleSystem::GetParticle(uint32_t index) const
+	{
+		DY_CORE_ASSERT(index < m_Count, "Particle index out of range!");
+
+		ParticleState particle;
+		particle.Position = { m_Streams[PositionX][index], m_Streams[PositionY][index] };
+		particle.Velocity = { m_Streams[VelocityX][index], m_Streams[VelocityY][index] };
+		particle.Color = { m_Streams[ColorR][index], m_Streams[ColorG][index], m_Streams[ColorB][index], m_Streams[ColorA][index] };
+		particle.Rotation = m_Streams[Rotation][index];
+		particle.Life = m_Streams[Life][index];
+		particle.Size = m_Streams[Size][index];
+		return particle;
+	}
+
+	void ParticleSystem::Kill(uint32_t index)
+	{
+		uint32_t last = --m_Count;
+		for (size_t stream = 0; stream < StreamCount; stream++)
+			m_Streams[stream][index] = m_Streams[stream][last];
+	}
+
+}
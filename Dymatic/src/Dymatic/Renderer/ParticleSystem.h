@@ -0,0 +1,82 @@
+#pragma once
+
+#include "Dymatic/Core/Base.h"
+#include "Dymatic/Core/Timestep.h"
+
+#include <glm/glm.hpp>
+
+namespace Dymatic {
+
+	struct ParticleProps
+	{
+		glm::vec2 Position = { 0.0f, 0.0f };
+		glm::vec2 Velocity = { 0.0f, 0.0f }, VelocityVariation = { 0.0f, 0.0f };
+		glm::vec4 ColorBegin = { 1.0f, 1.0f, 1.0f, 1.0f }, ColorEnd = { 1.0f, 1.0f, 1.0f, 0.0f };
+		float SizeBegin = 0.1f, SizeEnd = 0.0f, SizeVariation = 0.0f;
+		float AngularVelocity = 0.0f; // Radians per second
+		float LifeTime = 1.0f;
+	};
+
+	// One particle copied out of a ParticleSystem's streams
+	struct ParticleState
+	{
+		glm::vec2 Position, Velocity;
+		glm::vec4 Color;
+		float Rotation, Life, Size;
+	};
+
+	// Particles are stored as structure of arrays and kept densely packed, the first
+	// GetParticleCount() slots of every stream are alive and dead particles are swap removed.
+	// Size and color change linearly over a particle's lifetime, so they are integrated with
+	// a per particle rate just like position, which lets the whole update run in SIMD lanes.
+	// Update, emission and vertex generation are split into chunks on the JobSystem. Random values
+	// are drawn from a counter based generator indexed by emission order, so a given seed produces
+	// the same particles no matter how many worker threads there are.
+	class ParticleSystem
+	{
+	public:
+		ParticleSystem(uint32_t maxParticles = 100000, uint64_t seed = 0);
+		~ParticleSystem();
+
+		ParticleSystem(const ParticleSystem&) = delete;
+		ParticleSystem& operator=(const ParticleSystem&) = delete;
+
+		void OnUpdate(Timestep ts);
+		// Submits every live particle to the current Renderer2D scene
+		void OnRender(float depth = 0.0f);
+
+		// Particles emitted while the system is full are dropped
+		void Emit(const ParticleProps& particleProps, uint32_t count = 1);
+		void Clear() { m_Count = 0; }
+
+		uint32_t GetParticleCount() const { return m_Count; }
+		// Index is below GetParticleCount(). Particles keep their emission order until one dies.
+		ParticleState GetParticle(uint32_t index) const;
+		uint32_t GetMaxParticles() const { return m_MaxParticles; }
+	private:
+		void Kill(uint32_t index);
+	private:
+		enum Stream
+		{
+			PositionX = 0, PositionY,
+			VelocityX, VelocityY,
+			Rotation, AngularVelocity,
+			Life,
+			Size, SizeRate,
+			ColorR, ColorG, ColorB, ColorA,
+			ColorRateR, ColorRateG, ColorRateB, ColorRateA,
+			StreamCount
+		};
+
+		// All streams share one 16 byte aligned allocation, each padded to a multiple of 4 floats
+		float* m_Data = nullptr;
+		float* m_Streams[StreamCount];
+
+		uint32_t m_Count = 0;
+		uint32_t m_MaxParticles;
+
+		uint64_t m_Seed;
+		uint64_t m_EmittedCount = 0;
+	};
+
+}
@@ -7,6 +7,14 @@ namespace Dymatic {
 	class RenderCommand
 	{
 	public:
+		// Replaces the backend, only while the renderer is not initialized. API::None selects the
+		// NullRendererAPI, resources such as textures and shaders still need a real backend.
+		static void SetAPI(RendererAPI::API api)
+		{
+			RendererAPI::SetAPI(api);
+			s_RendererAPI = RendererAPI::Create();
+		}
+
 		static void Init()
 		{
 			s_RendererAPI->Init();
@@ -31,6 +39,46 @@ namespace Dymatic {
 		{
 			s_RendererAPI->DrawIndexed(vertexArray, count);
 		}
+
+		static void DrawIndexedInstanced(const Ref<VertexArray>& vertexArray, uint32_t indexCount, uint32_t instanceCount)
+		{
+			s_RendererAPI->DrawIndexedInstanced(vertexArray, indexCount, instanceCount);
+		}
+
+		static bool SupportsCompute()
+		{
+			return s_RendererAPI->SupportsCompute();
+		}
+
+		static void DispatchCompute(uint32_t groupsX, uint32_t groupsY = 1, uint32_t groupsZ = 1)
+		{
+			s_RendererAPI->DispatchCompute(groupsX, groupsY, groupsZ);
+		}
+
+		static void CreateTimestampQueries(uint32_t count, uint32_t* queryIDs)
+		{
+			s_RendererAPI->CreateTimestampQueries(count, queryIDs);
+		}
+
+		static void DeleteTimestampQueries(uint32_t count, const uint32_t* queryIDs)
+		{
+			s_RendererAPI->DeleteTimestampQueries(count, queryIDs);
+		}
+
+		static void RecordTimestamp(uint32_t queryID)
+		{
+			s_RendererAPI->RecordTimestamp(queryID);
+		}
+
+		static bool GetTimestampResult(uint32_t queryID, uint64_t& outNanoseconds)
+		{
+			return s_RendererAPI->GetTimestampResult(queryID, outNanoseconds);
+		}
+
+		static uint64_t GetCurrentTimestamp()
+		{
+			return s_RendererAPI->GetCurrentTimestamp();
+		}
 	private:
 		static Scope<RendererAPI> s_RendererAPI;
 	};
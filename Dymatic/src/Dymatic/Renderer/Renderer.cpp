@@ -1,22 +1,50 @@
 #include "dypch.h"
 #include "Dymatic/Renderer/Renderer.h"
 #include "Dymatic/Renderer/Renderer2D.h"
+#include "Dymatic/Renderer/GPUProfiler.h"
+#include "Dymatic/Renderer/Texture.h"
+
+#include "Dymatic/Core/Timer.h"
 
 namespace Dymatic {
 
 	Scope<Renderer::SceneData> Renderer::s_SceneData = CreateScope<Renderer::SceneData>();
+	Ref<ShaderLibrary> Renderer::s_ShaderLibrary;
 
 	void Renderer::Init()
 	{
 		DY_PROFILE_FUNCTION();
 
+		// Dominated by shader creation, compare a cold start against one with a warm shader cache
+		Timer timer;
+
+		s_ShaderLibrary = CreateRef<ShaderLibrary>();
+
 		RenderCommand::Init();
+		GPUProfiler::Init();
+		Texture2D::InitAsyncLoading();
 		Renderer2D::Init();
+
+		DY_CORE_INFO("Renderer initialized in {0}ms", timer.ElapsedMillis());
 	}
 
 	void Renderer::Shutdown()
 	{
 		Renderer2D::Shutdown();
+		Texture2D::ShutdownAsyncLoading();
+		GPUProfiler::Shutdown();
+		s_ShaderLibrary.reset();
+	}
+
+	void Renderer::BeginFrame()
+	{
+		DY_PROFILE_FUNCTION();
+
+		GPUProfiler::BeginFrame();
+		Texture2D::ProcessAsyncLoads();
+
+		// Programs are only swapped here, never in the middle of a frame
+		s_ShaderLibrary->ProcessHotReload();
 	}
 
 	void Renderer::OnWindowResize(uint32_t width, uint32_t height)
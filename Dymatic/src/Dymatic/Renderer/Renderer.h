@@ -13,6 +13,9 @@ namespace Dymatic {
 		static void Init();
 		static void Shutdown();
 
+		// Called by Application once per frame before any layer is updated
+		static void BeginFrame();
+
 		static void OnWindowResize(uint32_t width, uint32_t height);
 
 		static void BeginScene(OrthographicCamera& camera);
@@ -21,6 +24,9 @@ namespace Dymatic {
 		static void Submit(const Ref<Shader>& shader, const Ref<VertexArray>& vertexArray, const glm::mat4& transform = glm::mat4(1.0f));
 
 		static RendererAPI::API GetAPI() { return RendererAPI::GetAPI(); }
+
+		// Shaders loaded through the library are hot-reloaded at frame boundaries once enabled
+		static const Ref<ShaderLibrary>& GetShaderLibrary() { return s_ShaderLibrary; }
 	private:
 		struct SceneData
 		{
@@ -28,5 +34,6 @@ namespace Dymatic {
 		};
 
 		static Scope<SceneData> s_SceneData;
+		static Ref<ShaderLibrary> s_ShaderLibrary;
 	};
 }
@@ -3,6 +3,7 @@
 #include "Dymatic/Renderer/OrthographicCamera.h"
 
 #include "Dymatic/Renderer/Texture.h"
+#include "Dymatic/Renderer/SubTexture2D.h"
 
 #include "Dymatic/Renderer/Camera.h"
 
@@ -11,6 +12,15 @@ namespace Dymatic {
 	class Renderer2D
 	{
 	public:
+		struct QuadVertex
+		{
+			glm::vec3 Position;
+			glm::vec4 Color;
+			glm::vec2 TexCoord;
+			float TexIndex;
+			float TilingFactor;
+		};
+
 		static void Init();
 		static void Shutdown();
 
@@ -24,14 +34,26 @@ namespace Dymatic {
 		static void DrawQuad(const glm::vec3& position, const glm::vec2& size, const glm::vec4& color);
 		static void DrawQuad(const glm::vec2& position, const glm::vec2& size, const Ref<Texture2D>& texture, float tilingFactor = 1.0f, const glm::vec4& tintColor = glm::vec4(1.0f));
 		static void DrawQuad(const glm::vec3& position, const glm::vec2& size, const Ref<Texture2D>& texture, float tilingFactor = 1.0f, const glm::vec4& tintColor = glm::vec4(1.0f));
+		static void DrawQuad(const glm::vec2& position, const glm::vec2& size, const Ref<SubTexture2D>& subtexture, float tilingFactor = 1.0f, const glm::vec4& tintColor = glm::vec4(1.0f));
+		static void DrawQuad(const glm::vec3& position, const glm::vec2& size, const Ref<SubTexture2D>& subtexture, float tilingFactor = 1.0f, const glm::vec4& tintColor = glm::vec4(1.0f));
 
 		static void DrawQuad(const glm::mat4& transform, const glm::vec4& color);
 		static void DrawQuad(const glm::mat4& transform, const Ref<Texture2D>& texture, float tilingFactor = 1.0f, const glm::vec4& tintColor = glm::vec4(1.0f));
+		static void DrawQuad(const glm::mat4& transform, const Ref<SubTexture2D>& subtexture, float tilingFactor = 1.0f, const glm::vec4& tintColor = glm::vec4(1.0f));
 
 		static void DrawRotatedQuad(const glm::vec2& position, const glm::vec2& size, float rotation, const glm::vec4& color);
 		static void DrawRotatedQuad(const glm::vec3& position, const glm::vec2& size, float rotation, const glm::vec4& color);
 		static void DrawRotatedQuad(const glm::vec2& position, const glm::vec2& size, float rotation, const Ref<Texture2D>& texture, float tilingFactor = 1.0f, const glm::vec4& tintColor = glm::vec4(1.0f));
 		static void DrawRotatedQuad(const glm::vec3& position, const glm::vec2& size, float rotation, const Ref<Texture2D>& texture, float tilingFactor = 1.0f, const glm::vec4& tintColor = glm::vec4(1.0f));
+		static void DrawRotatedQuad(const glm::vec2& position, const glm::vec2& size, float rotation, const Ref<SubTexture2D>& subtexture, float tilingFactor = 1.0f, const glm::vec4& tintColor = glm::vec4(1.0f));
+		static void DrawRotatedQuad(const glm::vec3& position, const glm::vec2& size, float rotation, const Ref<SubTexture2D>& subtexture, float tilingFactor = 1.0f, const glm::vec4& tintColor = glm::vec4(1.0f));
+
+		// Bulk emission for systems that generate many quads at once. Returns room for quadCount
+		// untextured quads in the current batch, flushing first if the batch is full, and lowers
+		// quadCount to what fit. Callers write 4 vertices per quad with the corners in the order
+		// (-0.5, -0.5), (0.5, -0.5), (0.5, 0.5), (-0.5, 0.5) and keep calling until all are written.
+		static QuadVertex* ReserveQuads(uint32_t& quadCount);
+		static const glm::vec2* GetQuadTextureCoords();
 
 		// Stats
 		struct Statistics
@@ -48,6 +70,8 @@ namespace Dymatic {
 	private:
 		static void StartBatch();
 		static void NextBatch();
+
+		static float GetTextureIndex(const Ref<Texture2D>& texture);
 	};
 
 }
\ No newline at end of file
@@ -22,8 +22,23 @@ namespace Dymatic {
 		virtual void Clear() = 0;
 
 		virtual void DrawIndexed(const Ref<VertexArray>& vertexArray, uint32_t indexCount = 0) = 0;
+		virtual void DrawIndexedInstanced(const Ref<VertexArray>& vertexArray, uint32_t indexCount, uint32_t instanceCount) = 0;
+
+		// Compute dispatches finish their storage buffer writes before later draws and dispatches read them
+		virtual bool SupportsCompute() const = 0;
+		virtual void DispatchCompute(uint32_t groupsX, uint32_t groupsY, uint32_t groupsZ) = 0;
+
+		// GPU timestamp queries. Backends without timer query support keep these defaults,
+		// which hand out null query IDs and report every timestamp as zero.
+		virtual void CreateTimestampQueries(uint32_t count, uint32_t* queryIDs) { memset(queryIDs, 0, count * sizeof(uint32_t)); }
+		virtual void DeleteTimestampQueries(uint32_t, const uint32_t*) {}
+		virtual void RecordTimestamp(uint32_t) {}
+		virtual bool GetTimestampResult(uint32_t, uint64_t& outNanoseconds) { outNanoseconds = 0; return true; }
+		virtual uint64_t GetCurrentTimestamp() { return 0; }
 
 		static API GetAPI() { return s_API; }
+		// Only affects backends created afterwards, see RenderCommand::SetAPI
+		static void SetAPI(API api) { s_API = api; }
 		static Scope<RendererAPI> Create();
 	private:
 		static API s_API;
@@ -30,10 +30,49 @@ namespace Dymatic {
 		return nullptr;
 	}
 
+	Ref<Shader> Shader::CreateAsync(const std::string& filepath)
+	{
+		switch (Renderer::GetAPI())
+		{
+		case RendererAPI::API::None:    DY_CORE_ASSERT(false, "RendererAPI::None is currently not supported!"); return nullptr;
+		case RendererAPI::API::OpenGL:  return CreateRef<OpenGLShader>(filepath, false);
+		}
+
+		DY_CORE_ASSERT(false, "Unknown RendererAPI!");
+		return nullptr;
+	}
+
+	Ref<Shader> Shader::CreateAsync(const std::string& name, const std::string& vertexSrc, const std::string& fragmentSrc)
+	{
+		switch (Renderer::GetAPI())
+		{
+		case RendererAPI::API::None:    DY_CORE_ASSERT(false, "RendererAPI::None is currently not supported!"); return nullptr;
+		case RendererAPI::API::OpenGL:  return CreateRef<OpenGLShader>(name, vertexSrc, fragmentSrc, false);
+		}
+
+		DY_CORE_ASSERT(false, "Unknown RendererAPI!");
+		return nullptr;
+	}
+
+	static bool s_BinaryCacheEnabled = true;
+
+	void Shader::SetBinaryCacheEnabled(bool enabled)
+	{
+		s_BinaryCacheEnabled = enabled;
+	}
+
+	bool Shader::IsBinaryCacheEnabled()
+	{
+		return s_BinaryCacheEnabled;
+	}
+
 	void ShaderLibrary::Add(const std::string& name, const Ref<Shader>& shader)
 	{
 		DY_CORE_ASSERT(!Exists(name), "Shader already exists!");
 		m_Shaders[name] = shader;
+
+		if (m_Watcher && !shader->GetFilepath().empty())
+			m_Watcher->Watch(shader->GetFilepath());
 	}
 
 	void ShaderLibrary::Add(const Ref<Shader>& shader)
@@ -56,6 +95,72 @@ namespace Dymatic {
 		return shader;
 	}
 
+	std::vector<Ref<Shader>> ShaderLibrary::LoadBatch(const std::vector<std::string>& filepaths)
+	{
+		DY_PROFILE_FUNCTION();
+
+		std::vector<Ref<Shader>> shaders;
+		shaders.reserve(filepaths.size());
+		for (auto& filepath : filepaths)
+		{
+			auto shader = Shader::CreateAsync(filepath);
+			Add(shader);
+			shaders.push_back(shader);
+		}
+
+		m_Pending.insert(m_Pending.end(), shaders.begin(), shaders.end());
+		return shaders;
+	}
+
+	bool ShaderLibrary::Poll()
+	{
+		DY_PROFILE_FUNCTION();
+
+		m_Pending.erase(std::remove_if(m_Pending.begin(), m_Pending.end(), [](const Ref<Shader>& shader) { return shader->IsReady(); }), m_Pending.end());
+		return m_Pending.empty();
+	}
+
+	void ShaderLibrary::EnableHotReload()
+	{
+		DY_PROFILE_FUNCTION();
+
+		if (m_Watcher)
+			return;
+
+		m_Watcher = CreateScope<FileWatcher>();
+		for (auto& [name, shader] : m_Shaders)
+		{
+			if (!shader->GetFilepath().empty())
+				m_Watcher->Watch(shader->GetFilepath());
+		}
+	}
+
+	void ShaderLibrary::ProcessHotReload()
+	{
+		DY_PROFILE_FUNCTION();
+
+		if (!m_Watcher)
+			return;
+
+		for (auto& filepath : m_Watcher->GetChangedFiles())
+		{
+			for (auto& [name, shader] : m_Shaders)
+			{
+				if (shader->GetFilepath() != filepath)
+					continue;
+
+				DY_CORE_INFO("Reloading shader '{0}'", name);
+				shader->Reload();
+				if (std::find(m_Reloading.begin(), m_Reloading.end(), shader) == m_Reloading.end())
+					m_Reloading.push_back(shader);
+			}
+		}
+
+		size_t reloading = m_Reloading.size();
+		m_Reloading.erase(std::remove_if(m_Reloading.begin(), m_Reloading.end(), [](const Ref<Shader>& shader) { return !shader->ProcessReload(); }), m_Reloading.end());
+		m_ReloadCount += reloading - m_Reloading.size();
+	}
+
 	Ref<Shader> ShaderLibrary::Get(const std::string& name)
 	{
 		DY_CORE_ASSERT(Exists(name), "Shader not found!");
@@ -2,9 +2,12 @@
 
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 #include <glm/glm.hpp>
 
+#include "Dymatic/Utils/FileWatcher.h"
+
 namespace Dymatic {
 
 	class Shader
@@ -24,8 +27,29 @@ namespace Dymatic {
 
 		virtual const std::string& GetName() const = 0;
 
+		// Finishes a shader created with CreateAsync once the driver is done, never blocks
+		virtual bool IsReady() = 0;
+
+		// Empty for shaders created from source strings, those cannot be reloaded
+		virtual const std::string& GetFilepath() const = 0;
+
+		// Recompiles from the source file without blocking, the current program stays in use meanwhile
+		virtual void Reload() = 0;
+		// Swaps in the reloaded program once it is ready, a program that failed to compile is dropped
+		// and the old one kept. Returns true while a reload is still compiling.
+		virtual bool ProcessReload() = 0;
+
 		static Ref<Shader> Create(const std::string& filepath);
 		static Ref<Shader> Create(const std::string& name, const std::string& vertexSrc, const std::string& fragmentSrc);
+
+		// Issues compilation without waiting for it, so many shaders can compile in parallel.
+		// Binding the shader before IsReady() returned true waits for it.
+		static Ref<Shader> CreateAsync(const std::string& filepath);
+		static Ref<Shader> CreateAsync(const std::string& name, const std::string& vertexSrc, const std::string& fragmentSrc);
+
+		// Linked programs are cached on disk unless this is turned off, it applies to shaders created afterwards
+		static void SetBinaryCacheEnabled(bool enabled);
+		static bool IsBinaryCacheEnabled();
 	};
 
 	class ShaderLibrary
@@ -36,11 +60,30 @@ namespace Dymatic {
 		Ref<Shader> Load(const std::string& filepath);
 		Ref<Shader> Load(const std::string& name, const std::string& filepath);
 
+		// Issues compilation of every shader before checking any of them
+		std::vector<Ref<Shader>> LoadBatch(const std::vector<std::string>& filepaths);
+		// Polls shaders from LoadBatch without blocking, returns true once all of them are ready
+		bool Poll();
+		uint32_t GetPendingCount() const { return (uint32_t)m_Pending.size(); }
+
+		// Watches the source file of every shader in the library, including ones added later
+		void EnableHotReload();
+		// Starts reloading edited shaders and swaps in finished ones, called once per frame
+		void ProcessHotReload();
+		bool IsReloading() const { return !m_Reloading.empty(); }
+		// Counts reloads that finished, so users of the library can tell when to redraw
+		uint64_t GetReloadCount() const { return m_ReloadCount; }
+
 		Ref<Shader> Get(const std::string& name);
 
 		bool Exists(const std::string& name) const;
 	private:
 		std::unordered_map<std::string, Ref<Shader>> m_Shaders;
+		std::vector<Ref<Shader>> m_Pending;
+
+		Scope<FileWatcher> m_Watcher;
+		std::vector<Ref<Shader>> m_Reloading;
+		uint64_t m_ReloadCount = 0;
 	};
 
 }
\ No newline at end of file
@@ -0,0 +1,22 @@
+#pragma once
+
+#include "Dymatic/Core/Base.h"
+
+namespace Dymatic {
+
+	// Block of std430 laid out data that shaders, including compute shaders, can read and write at a fixed binding
+	class StorageBuffer
+	{
+	public:
+		virtual ~StorageBuffer() {}
+		virtual void SetData(const void* data, uint32_t size, uint32_t offset = 0) = 0;
+		// Waits for the GPU, only meant for debugging and comparing results
+		virtual void GetData(void* data, uint32_t size, uint32_t offset = 0) const = 0;
+
+		// Rebinds the buffer to its binding, needed before use when several buffers share a binding
+		virtual void Bind() const = 0;
+
+		static Ref<StorageBuffer> Create(uint32_t size, uint32_t binding);
+	};
+
+}
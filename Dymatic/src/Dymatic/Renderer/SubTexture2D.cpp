@@ -6,8 +6,13 @@ namespace Dymatic {
 	
 
 	SubTexture2D::SubTexture2D(const Ref<Texture2D>& texture, const glm::vec2& min, const glm::vec2 max)
-		: m_Texture(texture)
 	{
+		Set(texture, min, max);
+	}
+
+	void SubTexture2D::Set(const Ref<Texture2D>& texture, const glm::vec2& min, const glm::vec2& max)
+	{
+		m_Texture = texture;
 		m_TexCoords[0] = { min.x, min.y };
 		m_TexCoords[1] = { max.x, min.y };
 		m_TexCoords[2] = { max.x, max.y };
@@ -14,6 +14,9 @@ namespace Dymatic {
 		const Ref<Texture2D> GetTexture() const { return m_Texture; }
 		const glm::vec2* GetTexCoords() const { return m_TexCoords; }
 
+		// Used by TextureAtlas to move the region when a page grows or is repacked
+		void Set(const Ref<Texture2D>& texture, const glm::vec2& min, const glm::vec2& max);
+
 		static Ref<SubTexture2D> CreateFromCoords(const Ref<Texture2D>& texture, const glm::vec2& coords, const glm::vec2& cellSize, const glm::vec2& spriteSize = { 1, 1 });
 	private:
 		Ref<Texture2D> m_Texture;
@@ -3,6 +3,7 @@
 
 #include "Dymatic/Renderer/Renderer.h"
 #include "Platform/OpenGL/OpenGLTexture.h"
+#include "Platform/OpenGL/OpenGLTextureLoader.h"
 
 namespace Dymatic {
 
@@ -30,4 +31,61 @@ namespace Dymatic {
 		return nullptr;
 	}
 
+	Ref<Texture2D> Texture2D::CreateAsync(const std::string& path, const LoadedCallbackFn& onLoaded)
+	{
+		switch (Renderer::GetAPI())
+		{
+		case RendererAPI::API::None:    DY_CORE_ASSERT(false, "RendererAPI::None is currently not supported!"); return nullptr;
+		case RendererAPI::API::OpenGL:  return OpenGLTextureLoader::Load(path, onLoaded);
+		}
+
+		DY_CORE_ASSERT(false, "Unknown RendererAPI!");
+		return nullptr;
+	}
+
+	void Texture2D::ProcessAsyncLoads()
+	{
+		switch (Renderer::GetAPI())
+		{
+		case RendererAPI::API::None:    return;
+		case RendererAPI::API::OpenGL:  OpenGLTextureLoader::ProcessUploads(); return;
+		}
+
+		DY_CORE_ASSERT(false, "Unknown RendererAPI!");
+	}
+
+	uint32_t Texture2D::GetPendingAsyncLoads()
+	{
+		switch (Renderer::GetAPI())
+		{
+		case RendererAPI::API::None:    return 0;
+		case RendererAPI::API::OpenGL:  return OpenGLTextureLoader::GetPendingCount();
+		}
+
+		DY_CORE_ASSERT(false, "Unknown RendererAPI!");
+		return 0;
+	}
+
+	void Texture2D::InitAsyncLoading()
+	{
+		switch (Renderer::GetAPI())
+		{
+		case RendererAPI::API::None:    return;
+		case RendererAPI::API::OpenGL:  OpenGLTextureLoader::Init(); return;
+		}
+
+		DY_CORE_ASSERT(false, "Unknown RendererAPI!");
+	}
+
+	void Texture2D::ShutdownAsyncLoading()
+	{
+		switch (Renderer::GetAPI())
+		{
+		case RendererAPI::API::None:    return;
+		case RendererAPI::API::OpenGL:  OpenGLTextureLoader::Shutdown(); return;
+		}
+
+		DY_CORE_ASSERT(false, "Unknown RendererAPI!");
+	}
+
 }
\ No newline at end of file
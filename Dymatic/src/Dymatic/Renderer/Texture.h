@@ -1,6 +1,7 @@
 #pragma once
 
 #include <string>
+#include <functional>
 
 #include "Dymatic/Core/Base.h"
 
@@ -16,17 +17,40 @@ namespace Dymatic {
 		virtual uint32_t GetRendererID() const = 0;
 
 		virtual void SetData(void* data, uint32_t size) = 0;
+		// Replaces a rectangle of the texture, data is tightly packed in the texture's format
+		virtual void SetSubData(void* data, uint32_t x, uint32_t y, uint32_t width, uint32_t height) = 0;
 
 		virtual void Bind(uint32_t slot = 0) const = 0;
 
+		virtual bool IsLoaded() const = 0;
+
+		virtual uint32_t GetMipLevelCount() const = 0;
+		// Estimated GPU memory including the whole mip chain
+		virtual uint64_t GetMemorySize() const = 0;
+
 		virtual bool operator==(const Texture& other) const = 0;
 	};
 
 	class Texture2D : public Texture
 	{
 	public:
+		using LoadedCallbackFn = std::function<void(const Ref<Texture2D>&)>;
+
+		// Single mip level, meant for generated data such as atlas pages
 		static Ref<Texture2D> Create(uint32_t width, uint32_t height);
+		// Images get a full mip chain, .dds and .ktx2 files are uploaded block compressed with their stored mips
 		static Ref<Texture2D> Create(const std::string& path);
+
+		// Decodes the image on a worker thread and uploads it on the render thread.
+		// Until then IsLoaded() returns false and Renderer2D draws the white texture in its place.
+		static Ref<Texture2D> CreateAsync(const std::string& path, const LoadedCallbackFn& onLoaded = nullptr);
+
+		// Uploads images decoded since the last call, must be called on the render thread
+		static void ProcessAsyncLoads();
+		static uint32_t GetPendingAsyncLoads();
+
+		static void InitAsyncLoading();
+		static void ShutdownAsyncLoading();
 	};
 
 }
\ No newline at end of file
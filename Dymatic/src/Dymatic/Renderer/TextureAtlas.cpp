@@ -0,0 +1,305 @@
+#include "dypch.h"
+#include "Dymatic/Renderer/TextureAtlas.h"
+
+#include <stb_image.h>
+
+namespace Dymatic {
+
+	void TextureAtlas::Skyline::Reset(uint32_t width, uint32_t height)
+	{
+		m_Width = width;
+		m_Height = height;
+		m_Nodes.clear();
+		m_Nodes.push_back({ 0, 0, width });
+	}
+
+	void TextureAtlas::Skyline::Grow(uint32_t width, uint32_t height)
+	{
+		// Existing placements stay where they are, the new columns start out empty
+		if (width > m_Width)
+			m_Nodes.push_back({ m_Width, 0, width - m_Width });
+		m_Width = width;
+		m_Height = height;
+	}
+
+	bool TextureAtlas::Skyline::Fit(size_t index, uint32_t width, uint32_t height, uint32_t& outY) const
+	{
+		if (m_Nodes[index].X + width > m_Width)
+			return false;
+
+		uint32_t y = 0;
+		int64_t remaining = width;
+		for (size_t i = index; remaining > 0; i++)
+		{
+			y = std::max(y, m_Nodes[i].Y);
+			if (y + height > m_Height)
+				return false;
+			remaining -= m_Nodes[i].Width;
+		}
+
+		outY = y;
+		return true;
+	}
+
+	bool TextureAtlas::Skyline::Insert(uint32_t width, uint32_t height, uint32_t& outX, uint32_t& outY)
+	{
+		size_t bestIndex = SIZE_MAX;
+		uint32_t bestBottom = UINT32_MAX, bestWidth = UINT32_MAX;
+
+		for (size_t i = 0; i < m_Nodes.size(); i++)
+		{
+			uint32_t y;
+			if (!Fit(i, width, height, y))
+				continue;
+
+			if (y + height < bestBottom || (y + height == bestBottom && m_Nodes[i].Width < bestWidth))
+			{
+				bestIndex = i;
+				bestBottom = y + height;
+				bestWidth = m_Nodes[i].Width;
+				outX = m_Nodes[i].X;
+				outY = y;
+			}
+		}
+
+		if (bestIndex == SIZE_MAX)
+			return false;
+
+		m_Nodes.insert(m_Nodes.begin() + bestIndex, { outX, outY + height, width });
+
+		// Cut the nodes now covered by the new one
+		for (size_t i = bestIndex + 1; i < m_Nodes.size();)
+		{
+			const Node& previous = m_Nodes[i - 1];
+			Node& node = m_Nodes[i];
+			uint32_t previousEnd = previous.X + previous.Width;
+			if (node.X >= previousEnd)
+				break;
+
+			uint32_t shrink = previousEnd - node.X;
+			if (shrink >= node.Width)
+			{
+				m_Nodes.erase(m_Nodes.begin() + i);
+				continue;
+			}
+
+			node.X += shrink;
+			node.Width -= shrink;
+			break;
+		}
+
+		for (size_t i = 0; i + 1 < m_Nodes.size();)
+		{
+			if (m_Nodes[i].Y == m_Nodes[i + 1].Y)
+			{
+				m_Nodes[i].Width += m_Nodes[i + 1].Width;
+				m_Nodes.erase(m_Nodes.begin() + i + 1);
+			}
+			else
+				i++;
+		}
+
+		return true;
+	}
+
+	TextureAtlas::TextureAtlas(const TextureAtlasSpecification& spec)
+		: m_Specification(spec)
+	{
+		DY_CORE_ASSERT(spec.InitialPageSize <= spec.MaxPageSize, "Initial page size exceeds the maximum page size!");
+	}
+
+	Ref<TextureAtlas> TextureAtlas::Create(const TextureAtlasSpecification& spec)
+	{
+		return CreateRef<TextureAtlas>(spec);
+	}
+
+	Ref<SubTexture2D> TextureAtlas::Add(const std::string& path)
+	{
+		DY_PROFILE_FUNCTION();
+
+		int width, height, channels;
+		stbi_set_flip_vertically_on_load_thread(1);
+		stbi_uc* data = nullptr;
+		{
+			DY_PROFILE_SCOPE("stbi_load - TextureAtlas::Add(const std::string&)");
+			data = stbi_load(path.c_str(), &width, &height, &channels, 4);
+		}
+		if (!data)
+		{
+			DY_CORE_ERROR("Failed to load image '{0}'", path);
+			return nullptr;
+		}
+
+		Ref<SubTexture2D> subtexture = Add(data, width, height);
+		stbi_image_free(data);
+		return subtexture;
+	}
+
+	Ref<SubTexture2D> TextureAtlas::Add(const void* pixels, uint32_t width, uint32_t height)
+	{
+		DY_PROFILE_FUNCTION();
+
+		uint32_t padding = m_Specification.Padding;
+		if (width + 2 * padding > m_Specification.MaxPageSize || height + 2 * padding > m_Specification.MaxPageSize)
+		{
+			DY_CORE_ERROR("Image of {0}x{1} does not fit into a {2}x{2} atlas page", width, height, m_Specification.MaxPageSize);
+			return nullptr;
+		}
+
+		Entry& entry = m_Entries.emplace_back();
+		entry.Width = width;
+		entry.Height = height;
+		entry.Pixels.assign((const uint8_t*)pixels, (const uint8_t*)pixels + (size_t)width * height * 4);
+		entry.SubTexture = CreateRef<SubTexture2D>(nullptr, glm::vec2(0.0f), glm::vec2(0.0f));
+
+		entry.Placed = Place(entry);
+		DY_CORE_ASSERT(entry.Placed, "Failed to place image in the atlas!");
+		Upload(entry);
+
+		return entry.SubTexture;
+	}
+
+	void TextureAtlas::Remove(const Ref<SubTexture2D>& subtexture)
+	{
+		auto it = std::find_if(m_Entries.begin(), m_Entries.end(), [&](const Entry& entry) { return entry.SubTexture == subtexture; });
+		if (it != m_Entries.end())
+			m_Entries.erase(it);
+	}
+
+	bool TextureAtlas::Place(Entry& entry)
+	{
+		uint32_t paddedWidth = entry.Width + 2 * m_Specification.Padding;
+		uint32_t paddedHeight = entry.Height + 2 * m_Specification.Padding;
+
+		for (uint32_t i = 0; i < m_Pages.size(); i++)
+		{
+			if (m_Pages[i].Packer.Insert(paddedWidth, paddedHeight, entry.X, entry.Y))
+			{
+				entry.Page = i;
+				return true;
+			}
+		}
+
+		// Grow the newest page before starting another one
+		if (!m_Pages.empty())
+		{
+			uint32_t last = (uint32_t)m_Pages.size() - 1;
+			while (m_Pages[last].Size < m_Specification.MaxPageSize)
+			{
+				GrowPage(last);
+				if (m_Pages[last].Packer.Insert(paddedWidth, paddedHeight, entry.X, entry.Y))
+				{
+					entry.Page = last;
+					return true;
+				}
+			}
+		}
+
+		uint32_t page = CreatePage(std::max(paddedWidth, paddedHeight));
+		entry.Page = page;
+		return m_Pages[page].Packer.Insert(paddedWidth, paddedHeight, entry.X, entry.Y);
+	}
+
+	uint32_t TextureAtlas::CreatePage(uint32_t minSize)
+	{
+		uint32_t size = m_Specification.InitialPageSize;
+		while (size < minSize)
+			size *= 2;
+		size = std::min(size, m_Specification.MaxPageSize);
+
+		Page& page = m_Pages.emplace_back();
+		page.Size = size;
+		page.Texture = Texture2D::Create(size, size);
+		page.Packer.Reset(size, size);
+		return (uint32_t)m_Pages.size() - 1;
+	}
+
+	void TextureAtlas::GrowPage(uint32_t pageIndex)
+	{
+		DY_PROFILE_FUNCTION();
+
+		Page& page = m_Pages[pageIndex];
+		page.Size = std::min(page.Size * 2, m_Specification.MaxPageSize);
+		page.Texture = Texture2D::Create(page.Size, page.Size);
+		page.Packer.Grow(page.Size, page.Size);
+
+		// Placements keep their pixel position, only the texture and UVs change
+		for (auto& entry : m_Entries)
+		{
+			if (entry.Placed && entry.Page == pageIndex)
+				Upload(entry);
+		}
+	}
+
+	void TextureAtlas::Repack()
+	{
+		DY_PROFILE_FUNCTION();
+
+		m_Pages.clear();
+		for (auto& entry : m_Entries)
+			entry.Placed = false;
+
+		std::vector<Entry*> sorted;
+		sorted.reserve(m_Entries.size());
+		for (auto& entry : m_Entries)
+			sorted.push_back(&entry);
+
+		std::sort(sorted.begin(), sorted.end(), [](const Entry* a, const Entry* b)
+		{
+			return a->Height != b->Height ? a->Height > b->Height : a->Width > b->Width;
+		});
+
+		// Nothing is marked as placed until the end, so growing pages does not upload stale placements
+		for (Entry* entry : sorted)
+		{
+			bool placed = Place(*entry);
+			DY_CORE_ASSERT(placed, "Failed to place image in the atlas!");
+		}
+
+		for (auto& entry : m_Entries)
+		{
+			entry.Placed = true;
+			Upload(entry);
+		}
+	}
+
+	void TextureAtlas::Upload(Entry& entry)
+	{
+		const uint32_t padding = m_Specification.Padding;
+		const uint32_t paddedWidth = entry.Width + 2 * padding;
+		const uint32_t paddedHeight = entry.Height + 2 * padding;
+
+		// Extrude the edge pixels into the padding
+		std::vector<uint32_t> padded((size_t)paddedWidth * paddedHeight);
+		const uint32_t* source = (const uint32_t*)entry.Pixels.data();
+		for (uint32_t y = 0; y < paddedHeight; y++)
+		{
+			uint32_t sourceY = (uint32_t)std::clamp((int32_t)y - (int32_t)padding, 0, (int32_t)entry.Height - 1);
+			for (uint32_t x = 0; x < paddedWidth; x++)
+			{
+				uint32_t sourceX = (uint32_t)std::clamp((int32_t)x - (int32_t)padding, 0, (int32_t)entry.Width - 1);
+				padded[(size_t)y * paddedWidth + x] = source[(size_t)sourceY * entry.Width + sourceX];
+			}
+		}
+
+		Page& page = m_Pages[entry.Page];
+		page.Texture->SetSubData(padded.data(), entry.X, entry.Y, paddedWidth, paddedHeight);
+
+		float size = (float)page.Size;
+		glm::vec2 min = { (entry.X + padding) / size, (entry.Y + padding) / size };
+		glm::vec2 max = { (entry.X + padding + entry.Width) / size, (entry.Y + padding + entry.Height) / size };
+		entry.SubTexture->Set(page.Texture, min, max);
+	}
+
+	float TextureAtlas::GetOccupancy() const
+	{
+		uint64_t pageArea = 0, usedArea = 0;
+		for (auto& page : m_Pages)
+			pageArea += (uint64_t)page.Size * page.Size;
+		for (auto& entry : m_Entries)
+			usedArea += (uint64_t)entry.Width * entry.Height;
+
+		return pageArea ? (float)((double)usedArea / pageArea) : 0.0f;
+	}
+
+}
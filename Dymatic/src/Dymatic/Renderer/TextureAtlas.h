@@ -0,0 +1,94 @@
+#pragma once
+
+#include "Dymatic/Core/Base.h"
+#include "Dymatic/Renderer/Texture.h"
+#include "Dymatic/Renderer/SubTexture2D.h"
+
+#include <vector>
+
+namespace Dymatic {
+
+	struct TextureAtlasSpecification
+	{
+		uint32_t InitialPageSize = 512;
+		uint32_t MaxPageSize = 4096;
+
+		// Border around every image filled with its edge pixels so filtering never reads a neighbour
+		uint32_t Padding = 2;
+	};
+
+	// Packs images into a few large RGBA8 pages at runtime using a skyline bottom-left packer.
+	// The returned SubTexture2D handles stay valid when a page grows or the atlas is repacked,
+	// only their texture and coordinates change.
+	class TextureAtlas
+	{
+	public:
+		TextureAtlas(const TextureAtlasSpecification& spec = TextureAtlasSpecification());
+
+		Ref<SubTexture2D> Add(const std::string& path);
+		// Pixels are tightly packed RGBA8 rows, copied by the atlas
+		Ref<SubTexture2D> Add(const void* pixels, uint32_t width, uint32_t height);
+		void Remove(const Ref<SubTexture2D>& subtexture);
+
+		// Packs every image again from scratch, largest first, reclaiming space freed by Remove
+		void Repack();
+
+		uint32_t GetPageCount() const { return (uint32_t)m_Pages.size(); }
+		const Ref<Texture2D>& GetPage(uint32_t index) const { return m_Pages[index].Texture; }
+		uint32_t GetImageCount() const { return (uint32_t)m_Entries.size(); }
+
+		// Fraction of the page area covered by images, padding excluded
+		float GetOccupancy() const;
+
+		const TextureAtlasSpecification& GetSpecification() const { return m_Specification; }
+
+		static Ref<TextureAtlas> Create(const TextureAtlasSpecification& spec = TextureAtlasSpecification());
+	private:
+		class Skyline
+		{
+		public:
+			void Reset(uint32_t width, uint32_t height);
+			void Grow(uint32_t width, uint32_t height);
+			bool Insert(uint32_t width, uint32_t height, uint32_t& outX, uint32_t& outY);
+		private:
+			bool Fit(size_t index, uint32_t width, uint32_t height, uint32_t& outY) const;
+		private:
+			struct Node
+			{
+				uint32_t X, Y, Width;
+			};
+
+			std::vector<Node> m_Nodes;
+			uint32_t m_Width = 0, m_Height = 0;
+		};
+
+		struct Page
+		{
+			Ref<Texture2D> Texture;
+			Skyline Packer;
+			uint32_t Size = 0;
+		};
+
+		struct Entry
+		{
+			Ref<SubTexture2D> SubTexture;
+			std::vector<uint8_t> Pixels;
+			uint32_t Width = 0, Height = 0;
+
+			uint32_t Page = 0;
+			uint32_t X = 0, Y = 0;
+			bool Placed = false;
+		};
+	private:
+		bool Place(Entry& entry);
+		uint32_t CreatePage(uint32_t minSize);
+		void GrowPage(uint32_t pageIndex);
+		void Upload(Entry& entry);
+	private:
+		TextureAtlasSpecification m_Specification;
+
+		std::vector<Page> m_Pages;
+		std::vector<Entry> m_Entries;
+	};
+
+}
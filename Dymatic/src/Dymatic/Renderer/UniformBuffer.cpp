@@ -0,0 +1,21 @@
+#include "dypch.h"
+#include "Dymatic/Renderer/UniformBuffer.h"
+
+#include "Dymatic/Renderer/Renderer.h"
+#include "Platform/OpenGL/OpenGLUniformBuffer.h"
+
+namespace Dymatic {
+
+	Ref<UniformBuffer> UniformBuffer::Create(uint32_t size, uint32_t binding)
+	{
+		switch (Renderer::GetAPI())
+		{
+		case RendererAPI::API::None:    DY_CORE_ASSERT(false, "RendererAPI::None is currently not supported!"); return nullptr;
+		case RendererAPI::API::OpenGL:  return CreateRef<OpenGLUniformBuffer>(size, binding);
+		}
+
+		DY_CORE_ASSERT(false, "Unknown RendererAPI!");
+		return nullptr;
+	}
+
+}
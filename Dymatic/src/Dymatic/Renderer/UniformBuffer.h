@@ -0,0 +1,17 @@
+#pragma once
+
+#include "Dymatic/Core/Base.h"
+
+namespace Dymatic {
+
+	// Block of std140 laid out data shared by every shader that declares a uniform block at the same binding
+	class UniformBuffer
+	{
+	public:
+		virtual ~UniformBuffer() {}
+		virtual void SetData(const void* data, uint32_t size, uint32_t offset = 0) = 0;
+
+		static Ref<UniformBuffer> Create(uint32_t size, uint32_t binding);
+	};
+
+}
@@ -7,10 +7,21 @@
 #include <glm/gtx/quaternion.hpp>
 
 #include "SceneCamera.h"
-#include "ScriptableEntity.h"
+#include "Dymatic/Core/UUID.h"
+#include "Dymatic/Renderer/ParticleSystem.h"
 
 namespace Dymatic {
 
+	struct IDComponent
+	{
+		UUID ID;
+
+		IDComponent() = default;
+		IDComponent(const IDComponent&) = default;
+		IDComponent(UUID id)
+			: ID(id) {}
+	};
+
 	struct TagComponent
 	{
 		std::string Tag;
@@ -62,6 +73,37 @@ namespace Dymatic {
 		CameraComponent(const CameraComponent&) = default;
 	};
 
+	struct ParticleEmitterComponent
+	{
+		ParticleProps Props; // Position is taken from the entity's translation
+		float EmissionRate = 100.0f; // Particles per second
+		uint32_t MaxParticles = 10000;
+		uint64_t Seed = 0;
+
+		// Runtime state, created by the Scene on its first update
+		Ref<ParticleSystem> System;
+		float EmitRemainder = 0.0f;
+
+		ParticleEmitterComponent() = default;
+		ParticleEmitterComponent(const ParticleEmitterComponent&) = default;
+	};
+
+	class Prefab;
+
+	// Marks an entity as an instance of Source, see Entity::GetEffectiveComponent
+	struct PrefabInstanceComponent
+	{
+		Ref<Prefab> Source;
+
+		PrefabInstanceComponent() = default;
+		PrefabInstanceComponent(const PrefabInstanceComponent&) = default;
+		PrefabInstanceComponent(const Ref<Prefab>& source)
+			: Source(source) {}
+	};
+
+	// Forward declaration, Bind is only instantiated where the script type is complete
+	class ScriptableEntity;
+
 	struct NativeScriptComponent
 	{
 		ScriptableEntity* Instance = nullptr;
@@ -1,6 +1,8 @@
 #pragma once
 
 #include "Scene.h"
+#include "Components.h"
+#include "Prefab.h"
 
 #include "entt.hpp"
 
@@ -29,6 +31,14 @@ namespace Dymatic {
 			return m_Scene->m_Registry.get<T>(m_EntityHandle);
 		}
 
+		// Writes through func so anything listening for changes to T is notified
+		template<typename T, typename Func>
+		T& PatchComponent(Func&& func)
+		{
+			DY_CORE_ASSERT(HasComponent<T>(), "Entity does not have component!");
+			return m_Scene->m_Registry.patch<T>(m_EntityHandle, std::forward<Func>(func));
+		}
+
 		template<typename T>
 		bool HasComponent()
 		{
@@ -42,6 +52,36 @@ namespace Dymatic {
 			m_Scene->m_Registry.remove<T>(m_EntityHandle);
 		}
 
+		// The entity's own component, or the one shared by its prefab
+		template<typename T>
+		bool HasEffectiveComponent()
+		{
+			if (HasComponent<T>())
+				return true;
+			return HasComponent<PrefabInstanceComponent>() && GetComponent<PrefabInstanceComponent>().Source->GetEntity().HasComponent<T>();
+		}
+
+		template<typename T>
+		const T& GetEffectiveComponent()
+		{
+			DY_CORE_ASSERT(HasEffectiveComponent<T>(), "Entity does not have component!");
+			if (HasComponent<T>())
+				return GetComponent<T>();
+			return GetComponent<PrefabInstanceComponent>().Source->GetEntity().GetComponent<T>();
+		}
+
+		// Copy on write for prefab instances, the shared component is copied into the entity
+		// the first time it is written. Removing the copy reverts to the prefab's.
+		template<typename T>
+		T& OverrideComponent()
+		{
+			if (HasComponent<T>())
+				return GetComponent<T>();
+			return AddComponent<T>(GetEffectiveComponent<T>());
+		}
+
+		UUID GetUUID() { return GetComponent<IDComponent>().ID; }
+
 		operator bool() const { return m_EntityHandle != entt::null; }
 		operator entt::entity() const { return m_EntityHandle; }
 		operator uint32_t() const { return (uint32_t)m_EntityHandle; }
@@ -0,0 +1,127 @@
+#include "dypch.h"
+#include "Dymatic/Scene/EntityIDMap.h"
+
+namespace Dymatic {
+
+	static const uint32_t s_MinCapacity = 64;
+
+	EntityIDMap::EntityIDMap()
+	{
+		Rehash(s_MinCapacity);
+	}
+
+	bool EntityIDMap::Insert(UUID id, entt::entity entity)
+	{
+		DY_CORE_ASSERT((uint64_t)id != 0, "UUID 0 can't be stored!");
+
+		// Keep the load factor at or below one half so probe sequences stay short
+		if ((m_Size + 1) * 2 > (uint32_t)m_Entries.size())
+			Rehash((uint32_t)m_Entries.size() * 2);
+
+		for (uint32_t slot = GetHomeSlot(id);; slot = (slot + 1) & m_Mask)
+		{
+			Entry& entry = m_Entries[slot];
+			if (entry.ID == id)
+			{
+				entry.Entity = entity;
+				return false;
+			}
+
+			if (entry.ID == 0)
+			{
+				entry.ID = id;
+				entry.Entity = entity;
+				m_Size++;
+				return true;
+			}
+		}
+	}
+
+	bool EntityIDMap::Erase(UUID id)
+	{
+		uint32_t slot = GetHomeSlot(id);
+		while (m_Entries[slot].ID != id)
+		{
+			if (m_Entries[slot].ID == 0)
+				return false;
+			slot = (slot + 1) & m_Mask;
+		}
+
+		// Move later entries of the same probe run into the hole, so no lookup stops early at it
+		uint32_t hole = slot;
+		for (uint32_t next = (hole + 1) & m_Mask; m_Entries[next].ID != 0; next = (next + 1) & m_Mask)
+		{
+			uint32_t home = GetHomeSlot(m_Entries[next].ID);
+
+			// The entry may move if its home slot is not cyclically within (hole, next]
+			bool homeInRange = hole <= next ? (home > hole && home <= next) : (home > hole || home <= next);
+			if (!homeInRange)
+			{
+				m_Entries[hole] = m_Entries[next];
+				hole = next;
+			}
+		}
+
+		m_Entries[hole] = Entry();
+		m_Size--;
+		return true;
+	}
+
+	entt::entity EntityIDMap::Find(UUID id) const
+	{
+		if ((uint64_t)id == 0)
+			return entt::null;
+
+		for (uint32_t slot = GetHomeSlot(id);; slot = (slot + 1) & m_Mask)
+		{
+			const Entry& entry = m_Entries[slot];
+			if (entry.ID == id)
+				return entry.Entity;
+			if (entry.ID == 0)
+				return entt::null;
+		}
+	}
+
+	void EntityIDMap::Reserve(uint32_t count)
+	{
+		uint32_t capacity = (uint32_t)m_Entries.size();
+		while (count * 2 > capacity)
+			capacity *= 2;
+
+		if (capacity != m_Entries.size())
+			Rehash(capacity);
+	}
+
+	void EntityIDMap::Clear()
+	{
+		m_Entries.assign(m_Entries.size(), Entry());
+		m_Size = 0;
+	}
+
+	uint32_t EntityIDMap::GetHomeSlot(uint64_t id) const
+	{
+		// Fibonacci hashing, so sequential IDs from other tools still spread over the table
+		return (uint32_t)((id * 0x9E3779B97F4A7C15ull) >> m_Shift);
+	}
+
+	void EntityIDMap::Rehash(uint32_t capacity)
+	{
+		DY_CORE_ASSERT((capacity & (capacity - 1)) == 0, "Capacity must be a power of two!");
+
+		std::vector<Entry> entries(capacity);
+		std::swap(entries, m_Entries);
+
+		m_Mask = capacity - 1;
+		m_Shift = 64;
+		for (uint32_t size = capacity; size > 1; size >>= 1)
+			m_Shift--;
+
+		m_Size = 0;
+		for (const Entry& entry : entries)
+		{
+			if (entry.ID != 0)
+				Insert(entry.ID, entry.Entity);
+		}
+	}
+
+}
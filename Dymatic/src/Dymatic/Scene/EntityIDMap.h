@@ -0,0 +1,46 @@
+#pragma once
+
+#include "Dymatic/Core/UUID.h"
+
+#include "entt.hpp"
+
+#include <vector>
+
+namespace Dymatic {
+
+	// Open addressing hash map from UUID to entity handle with linear probing over one flat array.
+	// Erase shifts the entries after it back instead of leaving tombstones, so lookups stay short
+	// however many entities were destroyed. UUID 0 marks an empty slot and can't be stored.
+	class EntityIDMap
+	{
+	public:
+		EntityIDMap();
+
+		// Returns false and updates the handle if the UUID was already present
+		bool Insert(UUID id, entt::entity entity);
+		bool Erase(UUID id);
+		// entt::null when the UUID is not present
+		entt::entity Find(UUID id) const;
+		bool Contains(UUID id) const { return Find(id) != entt::null; }
+
+		void Reserve(uint32_t count);
+		void Clear();
+
+		uint32_t GetSize() const { return m_Size; }
+	private:
+		uint32_t GetHomeSlot(uint64_t id) const;
+		void Rehash(uint32_t capacity);
+	private:
+		struct Entry
+		{
+			uint64_t ID = 0;
+			entt::entity Entity = entt::null;
+		};
+
+		std::vector<Entry> m_Entries;
+		uint32_t m_Size = 0;
+		uint32_t m_Mask = 0;
+		uint32_t m_Shift = 0;
+	};
+
+}
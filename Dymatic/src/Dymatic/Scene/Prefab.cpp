@@ -0,0 +1,86 @@
+#include "dypch.h"
+#include "Dymatic/Scene/Prefab.h"
+
+#include "Dymatic/Scene/Entity.h"
+#include "Dymatic/Scene/SceneSerializer.h"
+
+#include <unordered_map>
+
+namespace Dymatic {
+
+	namespace Utils {
+
+		template<typename Component>
+		static void CopyEffectiveComponent(Entity dst, Entity src)
+		{
+			if (!src.HasEffectiveComponent<Component>())
+				return;
+
+			if (dst.HasComponent<Component>())
+				dst.GetComponent<Component>() = src.GetEffectiveComponent<Component>();
+			else
+				dst.AddComponent<Component>(src.GetEffectiveComponent<Component>());
+		}
+
+	}
+
+	// Loaded prefab assets by path, entries expire once no scene uses the prefab anymore
+	static std::unordered_map<std::string, std::weak_ptr<Prefab>> s_LoadedPrefabs;
+
+	Prefab::Prefab(const std::string& name, UUID id)
+		: m_ID(id), m_Scene(CreateRef<Scene>())
+	{
+		m_EntityHandle = m_Scene->CreateEntity(name);
+	}
+
+	Ref<Prefab> Prefab::Create(Entity entity)
+	{
+		Ref<Prefab> prefab = CreateRef<Prefab>();
+		Entity prefabEntity = prefab->GetEntity();
+
+		Utils::CopyEffectiveComponent<TagComponent>(prefabEntity, entity);
+		Utils::CopyEffectiveComponent<TransformComponent>(prefabEntity, entity);
+		Utils::CopyEffectiveComponent<SpriteRendererComponent>(prefabEntity, entity);
+		Utils::CopyEffectiveComponent<CameraComponent>(prefabEntity, entity);
+		Utils::CopyEffectiveComponent<ParticleEmitterComponent>(prefabEntity, entity);
+		Utils::CopyEffectiveComponent<NativeScriptComponent>(prefabEntity, entity);
+
+		// Runtime state stays with the original entity
+		if (prefabEntity.HasComponent<ParticleEmitterComponent>())
+			prefabEntity.GetComponent<ParticleEmitterComponent>().System = nullptr;
+		if (prefabEntity.HasComponent<NativeScriptComponent>())
+			prefabEntity.GetComponent<NativeScriptComponent>().Instance = nullptr;
+
+		return prefab;
+	}
+
+	Ref<Prefab> Prefab::Load(const std::string& filepath)
+	{
+		if (Ref<Prefab> loaded = s_LoadedPrefabs[filepath].lock())
+			return loaded;
+
+		Ref<Prefab> prefab = SceneSerializer::DeserializePrefab(filepath);
+		if (!prefab)
+		{
+			s_LoadedPrefabs.erase(filepath);
+			return nullptr;
+		}
+
+		prefab->m_FilePath = filepath;
+		s_LoadedPrefabs[filepath] = prefab;
+		return prefab;
+	}
+
+	void Prefab::Save(const Ref<Prefab>& prefab, const std::string& filepath)
+	{
+		SceneSerializer::SerializePrefab(prefab, filepath);
+		prefab->m_FilePath = filepath;
+		s_LoadedPrefabs[filepath] = prefab;
+	}
+
+	Entity Prefab::GetEntity() const
+	{
+		return { m_EntityHandle, m_Scene.get() };
+	}
+
+}
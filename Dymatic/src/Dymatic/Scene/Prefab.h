@@ -0,0 +1,42 @@
+#pragma once
+
+#include "Dymatic/Core/Base.h"
+#include "Dymatic/Core/UUID.h"
+#include "Dymatic/Scene/Scene.h"
+
+namespace Dymatic {
+
+	class Entity;
+
+	// A template entity that lives in a scene of its own. Instances keep a reference to it and
+	// share its TagComponent and SpriteRendererComponent until they override them, components
+	// with per entity state (transforms, cameras, emitters, scripts) are copied on instantiation.
+	// Prefabs saved as asset files are referenced by path from the scenes that use them, and every
+	// scene that loads the same file shares one Prefab.
+	class Prefab
+	{
+	public:
+		Prefab(const std::string& name = std::string(), UUID id = UUID());
+
+		// Copies every component entity has, or shares through its own prefab, into a new prefab
+		static Ref<Prefab> Create(Entity entity);
+
+		// Returns the prefab already loaded from filepath if there is one, nullptr if the file can't be read
+		static Ref<Prefab> Load(const std::string& filepath);
+		// Writes the prefab asset and makes later loads of filepath return this prefab
+		static void Save(const Ref<Prefab>& prefab, const std::string& filepath);
+
+		UUID GetID() const { return m_ID; }
+		// Empty until the prefab is saved or loaded as an asset
+		const std::string& GetFilePath() const { return m_FilePath; }
+
+		// Changes to the template show up in every instance that does not override them
+		Entity GetEntity() const;
+	private:
+		UUID m_ID;
+		std::string m_FilePath;
+		Ref<Scene> m_Scene;
+		entt::entity m_EntityHandle{ entt::null };
+	};
+
+}
@@ -7,20 +7,99 @@
 #include <glm/glm.hpp>
 
 #include "Entity.h"
+#include "Prefab.h"
+#include "ScriptableEntity.h"
 
 namespace Dymatic {
 
+	namespace Utils {
+
+		// The component array and the entity list of a pool line up index for index, so the whole
+		// pool is appended in one range insert. That is a memmove for trivially copyable components
+		// and one copy constructor call per element for everything else.
+		template<typename Component>
+		static void CopyComponentPool(entt::registry& dst, const entt::registry& src)
+		{
+			size_t count = src.size<Component>();
+			if (count == 0)
+				return;
+
+			const entt::entity* entities = src.data<Component>();
+			const Component* components = src.raw<Component>();
+			dst.insert<Component>(entities, entities + count, components, components + count);
+		}
+
+	}
+
 	Scene::Scene()
 	{
 	}
 
 	Scene::~Scene()
 	{
+		m_Registry.view<NativeScriptComponent>().each([](auto& nsc)
+		{
+			if (nsc.Instance)
+			{
+				nsc.Instance->OnDestroy();
+				nsc.DestroyScript(&nsc);
+			}
+		});
+	}
+
+	Ref<Scene> Scene::Copy(Ref<Scene> other)
+	{
+		DY_PROFILE_FUNCTION();
+
+		Ref<Scene> newScene = CreateRef<Scene>();
+		newScene->m_ViewportWidth = other->m_ViewportWidth;
+		newScene->m_ViewportHeight = other->m_ViewportHeight;
+
+		// Recreates the same handles, including the free list of destroyed entities
+		const entt::registry& srcRegistry = other->m_Registry;
+		entt::registry& dstRegistry = newScene->m_Registry;
+		dstRegistry.assign(srcRegistry.data(), srcRegistry.data() + srcRegistry.size());
+
+		Utils::CopyComponentPool<IDComponent>(dstRegistry, srcRegistry);
+		Utils::CopyComponentPool<TagComponent>(dstRegistry, srcRegistry);
+		Utils::CopyComponentPool<TransformComponent>(dstRegistry, srcRegistry);
+		Utils::CopyComponentPool<SpriteRendererComponent>(dstRegistry, srcRegistry);
+		Utils::CopyComponentPool<CameraComponent>(dstRegistry, srcRegistry);
+		Utils::CopyComponentPool<ParticleEmitterComponent>(dstRegistry, srcRegistry);
+		Utils::CopyComponentPool<NativeScriptComponent>(dstRegistry, srcRegistry);
+		Utils::CopyComponentPool<PrefabInstanceComponent>(dstRegistry, srcRegistry);
+
+		// Handles are identical, so the UUID index carries over as is
+		newScene->m_EntityIDMap = other->m_EntityIDMap;
+
+		// Runtime state must not be shared with the original
+		dstRegistry.view<ParticleEmitterComponent>().each([](auto& emitter)
+		{
+			emitter.System = nullptr;
+			emitter.EmitRemainder = 0.0f;
+		});
+		dstRegistry.view<NativeScriptComponent>().each([](auto& nsc)
+		{
+			nsc.Instance = nullptr;
+		});
+
+		return newScene;
 	}
 
 	Entity Scene::CreateEntity(const std::string& name)
 	{
+		return CreateEntityWithUUID(UUID(), name);
+	}
+
+	Entity Scene::CreateEntityWithUUID(UUID uuid, const std::string& name)
+	{
+		uuid = GetUnusedUUID(uuid);
+
+		m_EntityChangeCount++;
+
 		Entity entity = { m_Registry.create(), this };
+		entity.AddComponent<IDComponent>(uuid);
+		m_EntityIDMap.Insert(uuid, entity);
 		entity.AddComponent<TransformComponent>();
 		auto& tag = entity.AddComponent<TagComponent>();
 		tag.Tag = name.empty() ? "Entity" : name;
@@ -29,9 +108,111 @@ namespace Dymatic {
 
 	void Scene::DestroyEntity(Entity entity)
 	{
+		m_EntityChangeCount++;
+
+		m_EntityIDMap.Erase(entity.GetUUID());
 		m_Registry.destroy(entity);
 	}
 
+	Entity Scene::GetEntityByUUID(UUID uuid)
+	{
+		entt::entity handle = m_EntityIDMap.Find(uuid);
+		if (handle == entt::null)
+			return {};
+		return { handle, this };
+	}
+
+	Entity Scene::InstantiatePrefab(const Ref<Prefab>& prefab)
+	{
+		return InstantiatePrefabWithUUID(prefab, UUID());
+	}
+
+	Entity Scene::InstantiatePrefabWithUUID(const Ref<Prefab>& prefab, UUID uuid)
+	{
+		uuid = GetUnusedUUID(uuid);
+		m_EntityChangeCount++;
+
+		entt::entity handle = m_Registry.create();
+		m_Registry.emplace<IDComponent>(handle, uuid);
+		m_EntityIDMap.Insert(uuid, handle);
+		AddPrefabComponents(prefab, &handle, &handle + 1);
+		return { handle, this };
+	}
+
+	std::vector<Entity> Scene::InstantiatePrefab(const Ref<Prefab>& prefab, const std::vector<glm::vec3>& translations)
+	{
+		DY_PROFILE_FUNCTION();
+
+		std::vector<entt::entity> handles(translations.size());
+		m_Registry.create(handles.begin(), handles.end());
+		m_EntityChangeCount++;
+
+		std::vector<IDComponent> ids(handles.size());
+		m_EntityIDMap.Reserve(m_EntityIDMap.GetSize() + (uint32_t)handles.size());
+		for (size_t i = 0; i < handles.size(); i++)
+		{
+			ids[i].ID = GetUnusedUUID(ids[i].ID);
+			m_EntityIDMap.Insert(ids[i].ID, handles[i]);
+		}
+		m_Registry.insert<IDComponent>(handles.begin(), handles.end(), ids.begin(), ids.end());
+
+		AddPrefabComponents(prefab, handles.data(), handles.data() + handles.size());
+
+		std::vector<Entity> entities;
+		entities.reserve(handles.size());
+		for (size_t i = 0; i < handles.size(); i++)
+		{
+			m_Registry.get<TransformComponent>(handles[i]).Translation = translations[i];
+			entities.emplace_back(handles[i], this);
+		}
+		return entities;
+	}
+
+	UUID Scene::GetUnusedUUID(UUID uuid)
+	{
+		if ((uint64_t)uuid != 0 && !m_EntityIDMap.Contains(uuid))
+			return uuid;
+
+		DY_CORE_WARN("Entity UUID {0} is invalid or already in use, assigning a new one", (uint64_t)uuid);
+		do
+		{
+			uuid = UUID();
+		} while (m_EntityIDMap.Contains(uuid));
+		return uuid;
+	}
+
+	void Scene::AddPrefabComponents(const Ref<Prefab>& prefab, const entt::entity* first, const entt::entity* last)
+	{
+		Entity source = prefab->GetEntity();
+
+		// Tags and sprites stay with the prefab, everything else holds per entity state and is copied
+		m_Registry.insert<PrefabInstanceComponent>(first, last, PrefabInstanceComponent(prefab));
+		m_Registry.insert<TransformComponent>(first, last, source.GetComponent<TransformComponent>());
+
+		if (source.HasComponent<CameraComponent>())
+		{
+			m_Registry.insert<CameraComponent>(first, last, source.GetComponent<CameraComponent>());
+			// Bulk inserts skip OnComponentAdded, which only sizes the camera
+			for (const entt::entity* handle = first; handle != last; handle++)
+				m_Registry.get<CameraComponent>(*handle).Camera.SetViewportSize(m_ViewportWidth, m_ViewportHeight);
+		}
+
+		if (source.HasComponent<ParticleEmitterComponent>())
+		{
+			ParticleEmitterComponent emitter = source.GetComponent<ParticleEmitterComponent>();
+			emitter.System = nullptr;
+			emitter.EmitRemainder = 0.0f;
+			m_Registry.insert<ParticleEmitterComponent>(first, last, emitter);
+		}
+
+		if (source.HasComponent<NativeScriptComponent>())
+		{
+			NativeScriptComponent script = source.GetComponent<NativeScriptComponent>();
+			script.Instance = nullptr;
+			m_Registry.insert<NativeScriptComponent>(first, last, script);
+		}
+	}
+
 	void Scene::OnUpdate(Timestep ts)
 	{
 		// Update scripts
@@ -50,7 +231,39 @@ namespace Dymatic {
 			});
 		}
 
-		// Render 2D
+		UpdateParticles(ts);
+		RenderScene();
+	}
+
+	void Scene::OnUpdateEditor(Timestep ts)
+	{
+		UpdateParticles(ts);
+		RenderScene();
+	}
+
+	void Scene::UpdateParticles(Timestep ts)
+	{
+		auto view = m_Registry.view<TransformComponent, ParticleEmitterComponent>();
+		for (auto entity : view)
+		{
+			auto [transform, emitter] = view.get<TransformComponent, ParticleEmitterComponent>(entity);
+
+			if (!emitter.System || emitter.System->GetMaxParticles() != emitter.MaxParticles)
+				emitter.System = CreateRef<ParticleSystem>(emitter.MaxParticles, emitter.Seed);
+
+			float emit = emitter.EmissionRate * ts + emitter.EmitRemainder;
+			uint32_t emitCount = (uint32_t)emit;
+			emitter.EmitRemainder = emit - emitCount;
+
+			ParticleProps props = emitter.Props;
+			props.Position = { transform.Translation.x, transform.Translation.y };
+			emitter.System->Emit(props, emitCount);
+			emitter.System->OnUpdate(ts);
+		}
+	}
+
+	void Scene::RenderScene()
+	{
 		Camera* mainCamera = nullptr;
 		glm::mat4 cameraTransform;
 		{
@@ -80,6 +293,26 @@ namespace Dymatic {
 				Renderer2D::DrawQuad(transform.GetTransform(), sprite.Color);
 			}
 
+			// Prefab instances that don't override the sprite draw their prefab's
+			auto instances = m_Registry.view<TransformComponent, PrefabInstanceComponent>(entt::exclude<SpriteRendererComponent>);
+			for (auto entity : instances)
+			{
+				auto [transform, instance] = instances.get<TransformComponent, PrefabInstanceComponent>(entity);
+
+				Entity source = instance.Source->GetEntity();
+				if (source.HasComponent<SpriteRendererComponent>())
+					Renderer2D::DrawQuad(transform.GetTransform(), source.GetComponent<SpriteRendererComponent>().Color);
+			}
+
+			// Particles live in world space, only the depth comes from the emitter
+			auto view = m_Registry.view<TransformComponent, ParticleEmitterComponent>();
+			for (auto entity : view)
+			{
+				auto [transform, emitter] = view.get<TransformComponent, ParticleEmitterComponent>(entity);
+				if (emitter.System)
+					emitter.System->OnRender(transform.Translation.z);
+			}
+
 			Renderer2D::EndScene();
 		}
 
@@ -113,10 +346,20 @@ namespace Dymatic {
 		return {};
 	}
 
+	bool Scene::IsAnimated() const
+	{
+		return m_Registry.size<ParticleEmitterComponent>() > 0;
+	}
+
 	template<typename T>
 	void Scene::OnComponentAdded(Entity entity, T& component)
 	{
-		static_assert(false);
+		static_assert(sizeof(T) == 0);
+	}
+
+	template<>
+	void Scene::OnComponentAdded<IDComponent>(Entity entity, IDComponent& component)
+	{
 	}
 
 	template<>
@@ -140,6 +383,16 @@ namespace Dymatic {
 	{
 	}
 
+	template<>
+	void Scene::OnComponentAdded<ParticleEmitterComponent>(Entity entity, ParticleEmitterComponent& component)
+	{
+	}
+
+	template<>
+	void Scene::OnComponentAdded<PrefabInstanceComponent>(Entity entity, PrefabInstanceComponent& component)
+	{
+	}
+
 	template<>
 	void Scene::OnComponentAdded<NativeScriptComponent>(Entity entity, NativeScriptComponent& component)
 	{
@@ -2,11 +2,17 @@
 
 #include "entt.hpp"
 
+#include "Dymatic/Core/Base.h"
 #include "Dymatic/Core/Timestep.h"
+#include "Dymatic/Core/UUID.h"
+#include "Dymatic/Scene/EntityIDMap.h"
+
+#include <glm/glm.hpp>
 
 namespace Dymatic {
 
 	class Entity;
+	class Prefab;
 
 	class Scene
 	{
@@ -14,23 +20,53 @@ namespace Dymatic {
 		Scene();
 		~Scene();
 
+		// Clones every component pool of other in bulk. Entity handles and UUIDs match the
+		// original, runtime state (script instances, particle systems) starts out empty.
+		static Ref<Scene> Copy(Ref<Scene> other);
+
 		Entity CreateEntity(const std::string& name = std::string());
+		// A UUID that is zero or already taken is replaced by a new one
+		Entity CreateEntityWithUUID(UUID uuid, const std::string& name = std::string());
 		void DestroyEntity(Entity entity);
 
+		// Empty entity if no entity has the UUID
+		Entity GetEntityByUUID(UUID uuid);
+
+		Entity InstantiatePrefab(const Ref<Prefab>& prefab);
+		Entity InstantiatePrefabWithUUID(const Ref<Prefab>& prefab, UUID uuid);
+		// Creates one instance per translation with a single insert per component pool
+		std::vector<Entity> InstantiatePrefab(const Ref<Prefab>& prefab, const std::vector<glm::vec3>& translations);
+
 		void OnUpdate(Timestep ts);
+		// Same as OnUpdate without running native scripts
+		void OnUpdateEditor(Timestep ts);
 		void OnViewportResize(uint32_t width, uint32_t height);
 
 		Entity GetPrimaryCameraEntity();
+
+		// Updating the scene changes what it renders without any edit, true while particle emitters exist
+		bool IsAnimated() const;
+		// Counts entities created and destroyed, components written in place are not seen
+		uint64_t GetEntityChangeCount() const { return m_EntityChangeCount; }
 	private:
 		template<typename T>
 		void OnComponentAdded(Entity entity, T& component);
+
+		UUID GetUnusedUUID(UUID uuid);
+		void AddPrefabComponents(const Ref<Prefab>& prefab, const entt::entity* first, const entt::entity* last);
+
+		void UpdateParticles(Timestep ts);
+		void RenderScene();
 	private:
 		entt::registry m_Registry;
+		EntityIDMap m_EntityIDMap;
 		uint32_t m_ViewportWidth = 0, m_ViewportHeight = 0;
+		uint64_t m_EntityChangeCount = 0;
 		
 		friend class Entity;
 		friend class SceneSerializer;
 		friend class SceneHierarchyPanel;
+		friend class SpriteGrid;
 	};
 
 }
@@ -3,6 +3,7 @@
 
 #include "Entity.h"
 #include "Components.h"
+#include "Prefab.h"
 
 #include <fstream>
 
@@ -10,6 +11,29 @@
 
 namespace YAML {
 
+	template<>
+	struct convert<glm::vec2>
+	{
+		static Node encode(const glm::vec2& rhs)
+		{
+			Node node;
+			node.push_back(rhs.x);
+			node.push_back(rhs.y);
+			node.SetStyle(EmitterStyle::Flow);
+			return node;
+		}
+
+		static bool decode(const Node& node, glm::vec2& rhs)
+		{
+			if (!node.IsSequence() || node.size() != 2)
+				return false;
+
+			rhs.x = node[0].as<float>();
+			rhs.y = node[1].as<float>();
+			return true;
+		}
+	};
+
 	template<>
 	struct convert<glm::vec3>
 	{
@@ -65,6 +89,13 @@ namespace YAML {
 }
 namespace Dymatic {
 
+	YAML::Emitter& operator<<(YAML::Emitter& out, const glm::vec2& v)
+	{
+		out << YAML::Flow;
+		out << YAML::BeginSeq << v.x << v.y << YAML::EndSeq;
+		return out;
+	}
+
 	YAML::Emitter& operator<<(YAML::Emitter& out, const glm::vec3& v)
 	{
 		out << YAML::Flow;
@@ -87,7 +118,11 @@ namespace Dymatic {
 	static void SerializeEntity(YAML::Emitter& out, Entity entity)
 	{
 		out << YAML::BeginMap; // Entity
-		out << YAML::Key << "Entity" << YAML::Value << "12837192831273"; // TODO: Entity ID goes here
+		out << YAML::Key << "Entity" << YAML::Value << (uint64_t)entity.GetUUID();
+
+		// Instances only write what they own, shared components are read back from the prefab
+		if (entity.HasComponent<PrefabInstanceComponent>())
+			out << YAML::Key << "Prefab" << YAML::Value << (uint64_t)entity.GetComponent<PrefabInstanceComponent>().Source->GetID();
 
 		if (entity.HasComponent<TagComponent>())
 		{
@@ -149,14 +184,134 @@ namespace Dymatic {
 			out << YAML::EndMap; // SpriteRendererComponent
 		}
 
+		if (entity.HasComponent<ParticleEmitterComponent>())
+		{
+			out << YAML::Key << "ParticleEmitterComponent";
+			out << YAML::BeginMap; // ParticleEmitterComponent
+
+			auto& emitter = entity.GetComponent<ParticleEmitterComponent>();
+			auto& props = emitter.Props;
+			out << YAML::Key << "Velocity" << YAML::Value << props.Velocity;
+			out << YAML::Key << "VelocityVariation" << YAML::Value << props.VelocityVariation;
+			out << YAML::Key << "ColorBegin" << YAML::Value << props.ColorBegin;
+			out << YAML::Key << "ColorEnd" << YAML::Value << props.ColorEnd;
+			out << YAML::Key << "SizeBegin" << YAML::Value << props.SizeBegin;
+			out << YAML::Key << "SizeEnd" << YAML::Value << props.SizeEnd;
+			out << YAML::Key << "SizeVariation" << YAML::Value << props.SizeVariation;
+			out << YAML::Key << "AngularVelocity" << YAML::Value << props.AngularVelocity;
+			out << YAML::Key << "LifeTime" << YAML::Value << props.LifeTime;
+			out << YAML::Key << "EmissionRate" << YAML::Value << emitter.EmissionRate;
+			out << YAML::Key << "MaxParticles" << YAML::Value << emitter.MaxParticles;
+			out << YAML::Key << "Seed" << YAML::Value << emitter.Seed;
+
+			out << YAML::EndMap; // ParticleEmitterComponent
+		}
+
 		out << YAML::EndMap; // Entity
 	}
 
+	// Prefab instances already carry copies of some components when these are read
+	template<typename T>
+	static T& GetOrAddComponent(Entity entity)
+	{
+		if (entity.HasComponent<T>())
+			return entity.GetComponent<T>();
+		return entity.AddComponent<T>();
+	}
+
+	static void DeserializeComponents(const YAML::Node& entity, Entity deserializedEntity)
+	{
+		auto tagComponent = entity["TagComponent"];
+		if (tagComponent)
+			GetOrAddComponent<TagComponent>(deserializedEntity).Tag = tagComponent["Tag"].as<std::string>();
+
+		auto transformComponent = entity["TransformComponent"];
+		if (transformComponent)
+		{
+			// Entities always have transforms
+			auto& tc = deserializedEntity.GetComponent<TransformComponent>();
+			tc.Translation = transformComponent["Translation"].as<glm::vec3>();
+			tc.Rotation = transformComponent["Rotation"].as<glm::vec3>();
+			tc.Scale = transformComponent["Scale"].as<glm::vec3>();
+		}
+
+		auto cameraComponent = entity["CameraComponent"];
+		if (cameraComponent)
+		{
+			auto& cc = GetOrAddComponent<CameraComponent>(deserializedEntity);
+
+			auto cameraProps = cameraComponent["Camera"];
+			cc.Camera.SetProjectionType((SceneCamera::ProjectionType)cameraProps["ProjectionType"].as<int>());
+
+			cc.Camera.SetPerspectiveVerticalFOV(cameraProps["PerspectiveFOV"].as<float>());
+			cc.Camera.SetPerspectiveNearClip(cameraProps["PerspectiveNear"].as<float>());
+			cc.Camera.SetPerspectiveFarClip(cameraProps["PerspectiveFar"].as<float>());
+
+			cc.Camera.SetOrthographicSize(cameraProps["OrthographicSize"].as<float>());
+			cc.Camera.SetOrthographicNearClip(cameraProps["OrthographicNear"].as<float>());
+			cc.Camera.SetOrthographicFarClip(cameraProps["OrthographicFar"].as<float>());
+
+			cc.Primary = cameraComponent["Primary"].as<bool>();
+			cc.FixedAspectRatio = cameraComponent["FixedAspectRatio"].as<bool>();
+		}
+
+		auto spriteRendererComponent = entity["SpriteRendererComponent"];
+		if (spriteRendererComponent)
+		{
+			auto& src = GetOrAddComponent<SpriteRendererComponent>(deserializedEntity);
+			src.Color = spriteRendererComponent["Color"].as<glm::vec4>();
+		}
+
+		auto particleEmitterComponent = entity["ParticleEmitterComponent"];
+		if (particleEmitterComponent)
+		{
+			auto& emitter = GetOrAddComponent<ParticleEmitterComponent>(deserializedEntity);
+			auto& props = emitter.Props;
+			props.Velocity = particleEmitterComponent["Velocity"].as<glm::vec2>();
+			props.VelocityVariation = particleEmitterComponent["VelocityVariation"].as<glm::vec2>();
+			props.ColorBegin = particleEmitterComponent["ColorBegin"].as<glm::vec4>();
+			props.ColorEnd = particleEmitterComponent["ColorEnd"].as<glm::vec4>();
+			props.SizeBegin = particleEmitterComponent["SizeBegin"].as<float>();
+			props.SizeEnd = particleEmitterComponent["SizeEnd"].as<float>();
+			props.SizeVariation = particleEmitterComponent["SizeVariation"].as<float>();
+			props.AngularVelocity = particleEmitterComponent["AngularVelocity"].as<float>();
+			props.LifeTime = particleEmitterComponent["LifeTime"].as<float>();
+			emitter.EmissionRate = particleEmitterComponent["EmissionRate"].as<float>();
+			emitter.MaxParticles = particleEmitterComponent["MaxParticles"].as<uint32_t>();
+			emitter.Seed = particleEmitterComponent["Seed"].as<uint64_t>();
+		}
+	}
+
 	void SceneSerializer::Serialize(const std::string& filepath)
 	{
 		YAML::Emitter out;
 		out << YAML::BeginMap;
 		out << YAML::Key << "Scene" << YAML::Value << "Untitled";
+
+		// Every prefab is written once, ahead of the entities that reference it. Prefab assets are
+		// referenced by path, prefabs that were never saved as assets are embedded in the scene.
+		std::unordered_set<Prefab*> prefabs;
+		out << YAML::Key << "Prefabs" << YAML::Value << YAML::BeginSeq;
+		m_Scene->m_Registry.view<PrefabInstanceComponent>().each([&](auto& instance)
+		{
+			if (!prefabs.insert(instance.Source.get()).second)
+				return;
+
+			out << YAML::BeginMap; // Prefab
+			out << YAML::Key << "Prefab" << YAML::Value << (uint64_t)instance.Source->GetID();
+			if (!instance.Source->GetFilePath().empty())
+			{
+				out << YAML::Key << "Path" << YAML::Value << instance.Source->GetFilePath();
+			}
+			else
+			{
+				out << YAML::Key << "Template" << YAML::Value;
+				SerializeEntity(out, instance.Source->GetEntity());
+			}
+			out << YAML::EndMap; // Prefab
+		});
+		out << YAML::EndSeq;
+
 		out << YAML::Key << "Entities" << YAML::Value << YAML::BeginSeq;
 		m_Scene->m_Registry.each([&](auto entityID)
 		{
@@ -188,58 +343,69 @@ namespace Dymatic {
 		std::string sceneName = data["Scene"].as<std::string>();
 		DY_CORE_TRACE("Deserializing scene '{0}'", sceneName);
 
+		std::unordered_map<uint64_t, Ref<Prefab>> prefabs;
+		auto prefabNodes = data["Prefabs"];
+		if (prefabNodes)
+		{
+			for (auto prefabNode : prefabNodes)
+			{
+				uint64_t prefabID = prefabNode["Prefab"].as<uint64_t>();
+
+				Ref<Prefab> prefab;
+				if (auto path = prefabNode["Path"])
+				{
+					prefab = Prefab::Load(path.as<std::string>());
+					if (!prefab)
+					{
+						DY_CORE_ERROR("Could not load prefab {0} from '{1}'", prefabID, path.as<std::string>());
+						continue;
+					}
+					if ((uint64_t)prefab->GetID() != prefabID)
+						DY_CORE_WARN("Prefab '{0}' was replaced by a different prefab since the scene was saved", path.as<std::string>());
+				}
+				else
+				{
+					prefab = CreateRef<Prefab>(std::string(), prefabID);
+					DeserializeComponents(prefabNode["Template"], prefab->GetEntity());
+				}
+				prefabs[prefabID] = prefab;
+			}
+		}
+
 		auto entities = data["Entities"];
 		if (entities)
 		{
+			m_Scene->m_EntityIDMap.Reserve(m_Scene->m_EntityIDMap.GetSize() + (uint32_t)entities.size());
+
 			for (auto entity : entities)
 			{
-				uint64_t uuid = entity["Entity"].as<uint64_t>(); // TODO
+				uint64_t uuid = entity["Entity"].as<uint64_t>();
 
 				std::string name;
 				auto tagComponent = entity["TagComponent"];
 				if (tagComponent)
 					name = tagComponent["Tag"].as<std::string>();
 
-				DY_CORE_TRACE("Deserialized entity with ID = {0}, name = {1}", uuid, name);
-
-				Entity deserializedEntity = m_Scene->CreateEntity(name);
+				DY_CORE_TRACE_LIMITED(100, "Deserialized entity with ID = {0}, name = {1}", uuid, name);
 
-				auto transformComponent = entity["TransformComponent"];
-				if (transformComponent)
+				Entity deserializedEntity;
+				auto prefabID = entity["Prefab"];
+				if (prefabID)
 				{
-					// Entities always have transforms
-					auto& tc = deserializedEntity.GetComponent<TransformComponent>();
-					tc.Translation = transformComponent["Translation"].as<glm::vec3>();
-					tc.Rotation = transformComponent["Rotation"].as<glm::vec3>();
-					tc.Scale = transformComponent["Scale"].as<glm::vec3>();
+					auto it = prefabs.find(prefabID.as<uint64_t>());
+					if (it == prefabs.end())
+					{
+						DY_CORE_ERROR("Entity {0} references missing prefab {1}", uuid, prefabID.as<uint64_t>());
+						continue;
+					}
+					deserializedEntity = m_Scene->InstantiatePrefabWithUUID(it->second, uuid);
 				}
-
-				auto cameraComponent = entity["CameraComponent"];
-				if (cameraComponent)
+				else
 				{
-					auto& cc = deserializedEntity.AddComponent<CameraComponent>();
-
-					auto& cameraProps = cameraComponent["Camera"];
-					cc.Camera.SetProjectionType((SceneCamera::ProjectionType)cameraProps["ProjectionType"].as<int>());
-
-					cc.Camera.SetPerspectiveVerticalFOV(cameraProps["PerspectiveFOV"].as<float>());
-					cc.Camera.SetPerspectiveNearClip(cameraProps["PerspectiveNear"].as<float>());
-					cc.Camera.SetPerspectiveFarClip(cameraProps["PerspectiveFar"].as<float>());
-
-					cc.Camera.SetOrthographicSize(cameraProps["OrthographicSize"].as<float>());
-					cc.Camera.SetOrthographicNearClip(cameraProps["OrthographicNear"].as<float>());
-					cc.Camera.SetOrthographicFarClip(cameraProps["OrthographicFar"].as<float>());
-
-					cc.Primary = cameraComponent["Primary"].as<bool>();
-					cc.FixedAspectRatio = cameraComponent["FixedAspectRatio"].as<bool>();
+					deserializedEntity = m_Scene->CreateEntityWithUUID(uuid, name);
 				}
 
-				auto spriteRendererComponent = entity["SpriteRendererComponent"];
-				if (spriteRendererComponent)
-				{
-					auto& src = deserializedEntity.AddComponent<SpriteRendererComponent>();
-					src.Color = spriteRendererComponent["Color"].as<glm::vec4>();
-				}
+				DeserializeComponents(entity, deserializedEntity);
 			}
 		}
 
@@ -253,4 +419,37 @@ namespace Dymatic {
 		return false;
 	}
 
+	void SceneSerializer::SerializePrefab(const Ref<Prefab>& prefab, const std::string& filepath)
+	{
+		YAML::Emitter out;
+		out << YAML::BeginMap;
+		out << YAML::Key << "Prefab" << YAML::Value << (uint64_t)prefab->GetID();
+		out << YAML::Key << "Template" << YAML::Value;
+		SerializeEntity(out, prefab->GetEntity());
+		out << YAML::EndMap;
+
+		std::ofstream fout(filepath);
+		fout << out.c_str();
+	}
+
+	Ref<Prefab> SceneSerializer::DeserializePrefab(const std::string& filepath)
+	{
+		YAML::Node data;
+		try
+		{
+			data = YAML::LoadFile(filepath);
+		}
+		catch (const YAML::Exception&)
+		{
+			return nullptr;
+		}
+
+		if (!data["Prefab"] || !data["Template"])
+			return nullptr;
+
+		Ref<Prefab> prefab = CreateRef<Prefab>(std::string(), data["Prefab"].as<uint64_t>());
+		DeserializeComponents(data["Template"], prefab->GetEntity());
+		return prefab;
+	}
+
 }
@@ -4,6 +4,8 @@
 
 namespace Dymatic {
 
+	class Prefab;
+
 	class SceneSerializer
 	{
 	public:
@@ -14,6 +16,10 @@ namespace Dymatic {
 
 		bool Deserialize(const std::string& filepath);
 		bool DeserializeRuntime(const std::string& filepath);
+
+		// Prefab asset files, use Prefab::Save and Prefab::Load to share prefabs between scenes
+		static void SerializePrefab(const Ref<Prefab>& prefab, const std::string& filepath);
+		static Ref<Prefab> DeserializePrefab(const std::string& filepath);
 	private:
 		Ref<Scene> m_Scene;
 	};
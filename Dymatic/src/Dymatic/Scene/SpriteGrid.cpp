@@ -0,0 +1,218 @@
+#include "dypch.h"
+#include "Dymatic/Scene/SpriteGrid.h"
+
+namespace Dymatic {
+
+	static const uint32_t s_MaxCellsPerSprite = 16;
+	static const uint32_t s_MaxCells = 1 << 20;
+
+	void SpriteGrid::Build(Scene* scene)
+	{
+		DY_PROFILE_FUNCTION();
+
+		m_Scene = scene;
+		m_Bounds.clear();
+		m_CellEntries.clear();
+		m_CellStart.clear();
+		m_LargeSprites.clear();
+		m_Columns = m_Rows = 0;
+
+		glm::vec3 sceneMin(std::numeric_limits<float>::max()), sceneMax(std::numeric_limits<float>::lowest());
+		float extentSum = 0.0f;
+
+		// The quad spans [-0.5, 0.5] on its local x and y axes, so the world half extents are the
+		// absolute rotated axes scaled by half the size, no full matrix is needed
+		auto addSprite = [&](entt::entity handle, const TransformComponent& transform)
+		{
+			glm::mat3 rotation = glm::toMat3(glm::quat(transform.Rotation));
+			glm::vec3 axisX = glm::abs(rotation[0]) * (0.5f * std::abs(transform.Scale.x));
+			glm::vec3 axisY = glm::abs(rotation[1]) * (0.5f * std::abs(transform.Scale.y));
+			glm::vec3 halfExtents = axisX + axisY;
+
+			glm::vec3 min = transform.Translation - halfExtents;
+			glm::vec3 max = transform.Translation + halfExtents;
+			m_Bounds.push_back({ { min.x, min.y }, { max.x, max.y }, handle });
+
+			sceneMin = glm::min(sceneMin, min);
+			sceneMax = glm::max(sceneMax, max);
+			extentSum += std::max(max.x - min.x, max.y - min.y);
+		};
+
+		auto& registry = scene->m_Registry;
+		m_Bounds.reserve(registry.size<SpriteRendererComponent>() + registry.size<PrefabInstanceComponent>());
+
+		// Same group and order as Scene::OnUpdate, the index of a sprite is its draw order
+		auto sprites = registry.group<TransformComponent>(entt::get<SpriteRendererComponent>);
+		for (auto entity : sprites)
+			addSprite(entity, sprites.get<TransformComponent>(entity));
+
+		auto instances = registry.view<TransformComponent, PrefabInstanceComponent>(entt::exclude<SpriteRendererComponent>);
+		for (auto entity : instances)
+		{
+			auto [transform, instance] = instances.get<TransformComponent, PrefabInstanceComponent>(entity);
+			if (instance.Source->GetEntity().HasComponent<SpriteRendererComponent>())
+				addSprite(entity, transform);
+		}
+
+		uint32_t count = (uint32_t)m_Bounds.size();
+		if (count == 0)
+			return;
+
+		m_MinZ = sceneMin.z;
+		m_MaxZ = sceneMax.z;
+
+		// Roughly one sprite per cell, but never smaller than the average sprite
+		glm::vec2 size = glm::max(glm::vec2(sceneMax) - glm::vec2(sceneMin), glm::vec2(1e-4f));
+		float cellSize = std::max(std::sqrt(size.x * size.y / count), extentSum / count);
+		cellSize = std::max(cellSize, std::sqrt(size.x * size.y / s_MaxCells));
+
+		m_GridMin = glm::vec2(sceneMin);
+		m_CellSize = cellSize;
+		m_Columns = std::max(1u, (uint32_t)std::ceil(size.x / cellSize));
+		m_Rows = std::max(1u, (uint32_t)std::ceil(size.y / cellSize));
+
+		auto cellRange = [this](const glm::vec2& min, const glm::vec2& max, glm::uvec2& first, glm::uvec2& last)
+		{
+			glm::vec2 gridSize = { (float)(m_Columns - 1), (float)(m_Rows - 1) };
+			first = glm::uvec2(glm::clamp((min - m_GridMin) / m_CellSize, glm::vec2(0.0f), gridSize));
+			last = glm::uvec2(glm::clamp((max - m_GridMin) / m_CellSize, glm::vec2(0.0f), gridSize));
+		};
+
+		// Counting sort, count the entries of every cell, then fill each cell's range
+		m_CellStart.assign((size_t)m_Columns * m_Rows + 1, 0);
+		for (uint32_t i = 0; i < count; i++)
+		{
+			glm::uvec2 first, last;
+			cellRange(m_Bounds[i].Min, m_Bounds[i].Max, first, last);
+			if ((last.x - first.x + 1) * (last.y - first.y + 1) > s_MaxCellsPerSprite)
+			{
+				m_LargeSprites.push_back(i);
+				continue;
+			}
+
+			for (uint32_t y = first.y; y <= last.y; y++)
+				for (uint32_t x = first.x; x <= last.x; x++)
+					m_CellStart[y * m_Columns + x + 1]++;
+		}
+
+		for (size_t cell = 1; cell < m_CellStart.size(); cell++)
+			m_CellStart[cell] += m_CellStart[cell - 1];
+
+		std::vector<uint32_t> cursor(m_CellStart.begin(), m_CellStart.end() - 1);
+		m_CellEntries.resize(m_CellStart.back());
+		for (uint32_t i = 0; i < count; i++)
+		{
+			glm::uvec2 first, last;
+			cellRange(m_Bounds[i].Min, m_Bounds[i].Max, first, last);
+			if ((last.x - first.x + 1) * (last.y - first.y + 1) > s_MaxCellsPerSprite)
+				continue;
+
+			for (uint32_t y = first.y; y <= last.y; y++)
+				for (uint32_t x = first.x; x <= last.x; x++)
+					m_CellEntries[cursor[y * m_Columns + x]++] = i;
+		}
+	}
+
+	Entity SpriteGrid::Raycast(const glm::vec3& origin, const glm::vec3& direction) const
+	{
+		DY_PROFILE_FUNCTION();
+
+		if (m_Bounds.empty())
+			return {};
+
+		// The part of the ray between the lowest and highest sprite, projected onto the XY plane
+		glm::vec2 segmentMin, segmentMax;
+		bool searchAll = false;
+		if (std::abs(direction.z) > 1e-6f)
+		{
+			float t0 = std::max((m_MinZ - origin.z) / direction.z, 0.0f);
+			float t1 = std::max((m_MaxZ - origin.z) / direction.z, 0.0f);
+			glm::vec2 p0 = glm::vec2(origin + t0 * direction);
+			glm::vec2 p1 = glm::vec2(origin + t1 * direction);
+			segmentMin = glm::min(p0, p1);
+			segmentMax = glm::max(p0, p1);
+		}
+		else
+		{
+			// Looking along the plane, the segment is unbounded
+			segmentMin = glm::vec2(std::numeric_limits<float>::lowest());
+			segmentMax = glm::vec2(std::numeric_limits<float>::max());
+			searchAll = true;
+		}
+
+		uint32_t closest = std::numeric_limits<uint32_t>::max();
+		float closestT = std::numeric_limits<float>::max();
+		auto test = [&](uint32_t index)
+		{
+			float t;
+			if (!TestSprite(index, origin, direction, segmentMin, segmentMax, t))
+				return;
+
+			// Coplanar sprites reach t through different inverse transforms, so compare with a tolerance
+			float tolerance = 1e-5f * std::max(1.0f, std::abs(t));
+			bool tied = std::abs(t - closestT) <= tolerance;
+			if ((tied && index < closest) || (!tied && t < closestT))
+			{
+				closestT = t;
+				closest = index;
+			}
+		};
+
+		if (searchAll)
+		{
+			for (uint32_t i = 0; i < (uint32_t)m_Bounds.size(); i++)
+				test(i);
+		}
+		else
+		{
+			glm::vec2 gridMax = m_GridMin + glm::vec2(m_Columns, m_Rows) * m_CellSize;
+			if (segmentMax.x >= m_GridMin.x && segmentMax.y >= m_GridMin.y && segmentMin.x <= gridMax.x && segmentMin.y <= gridMax.y)
+			{
+				glm::vec2 gridSize = { (float)(m_Columns - 1), (float)(m_Rows - 1) };
+				glm::uvec2 first = glm::uvec2(glm::clamp((segmentMin - m_GridMin) / m_CellSize, glm::vec2(0.0f), gridSize));
+				glm::uvec2 last = glm::uvec2(glm::clamp((segmentMax - m_GridMin) / m_CellSize, glm::vec2(0.0f), gridSize));
+
+				for (uint32_t y = first.y; y <= last.y; y++)
+				{
+					for (uint32_t x = first.x; x <= last.x; x++)
+					{
+						uint32_t cell = y * m_Columns + x;
+						for (uint32_t entry = m_CellStart[cell]; entry < m_CellStart[cell + 1]; entry++)
+							test(m_CellEntries[entry]);
+					}
+				}
+			}
+
+			for (uint32_t index : m_LargeSprites)
+				test(index);
+		}
+
+		if (closest == std::numeric_limits<uint32_t>::max())
+			return {};
+		return { m_Bounds[closest].Handle, m_Scene };
+	}
+
+	bool SpriteGrid::TestSprite(uint32_t index, const glm::vec3& origin, const glm::vec3& direction, const glm::vec2& segmentMin, const glm::vec2& segmentMax, float& t) const
+	{
+		const Bounds& bounds = m_Bounds[index];
+		if (bounds.Max.x < segmentMin.x || bounds.Max.y < segmentMin.y || bounds.Min.x > segmentMax.x || bounds.Min.y > segmentMax.y)
+			return false;
+
+		// Exact test in the quad's local space, where it is the unit square on z = 0.
+		// The transform is affine, so t along the local ray is t along the world ray.
+		const auto& transform = m_Scene->m_Registry.get<TransformComponent>(bounds.Handle);
+		glm::mat4 inverse = glm::inverse(transform.GetTransform());
+		glm::vec3 localOrigin = inverse * glm::vec4(origin, 1.0f);
+		glm::vec3 localDirection = inverse * glm::vec4(direction, 0.0f);
+		if (std::abs(localDirection.z) < 1e-8f)
+			return false;
+
+		t = -localOrigin.z / localDirection.z;
+		if (t < 0.0f)
+			return false;
+
+		glm::vec3 hit = localOrigin + t * localDirection;
+		return std::abs(hit.x) <= 0.5f && std::abs(hit.y) <= 0.5f;
+	}
+
+}
@@ -0,0 +1,51 @@
+#pragma once
+
+#include "Dymatic/Scene/Entity.h"
+
+#include <glm/glm.hpp>
+
+#include <vector>
+
+namespace Dymatic {
+
+	// Uniform grid over the world space XY bounds of every sprite in a scene, for picking.
+	// Components are written in place without change notifications, so the grid is a snapshot:
+	// rebuild it before querying a scene that may have changed.
+	class SpriteGrid
+	{
+	public:
+		// Includes prefab instances that draw their prefab's sprite
+		void Build(Scene* scene);
+
+		// Closest sprite hit by origin + t * direction for t >= 0, empty entity if nothing was hit.
+		// Sprites hit at the same distance resolve to the one Scene draws first, which is the one
+		// the viewport shows since its depth test keeps the first fragment at a given depth.
+		Entity Raycast(const glm::vec3& origin, const glm::vec3& direction) const;
+
+		uint32_t GetSpriteCount() const { return (uint32_t)m_Bounds.size(); }
+	private:
+		bool TestSprite(uint32_t index, const glm::vec3& origin, const glm::vec3& direction, const glm::vec2& segmentMin, const glm::vec2& segmentMax, float& t) const;
+	private:
+		struct Bounds
+		{
+			glm::vec2 Min, Max;
+			entt::entity Handle;
+		};
+
+		Scene* m_Scene = nullptr;
+		// In the order Scene draws the sprites
+		std::vector<Bounds> m_Bounds;
+
+		// Indices into m_Bounds sorted by cell, the indices of cell i are [m_CellStart[i], m_CellStart[i + 1])
+		std::vector<uint32_t> m_CellEntries;
+		std::vector<uint32_t> m_CellStart;
+		// Sprites that would cover too many cells are tested on every query instead
+		std::vector<uint32_t> m_LargeSprites;
+
+		glm::vec2 m_GridMin = { 0.0f, 0.0f };
+		float m_CellSize = 1.0f;
+		uint32_t m_Columns = 0, m_Rows = 0;
+		float m_MinZ = 0.0f, m_MaxZ = 0.0f;
+	};
+
+}
@@ -0,0 +1,163 @@
+#include "dypch.h"
+#include "Dymatic/Utils/FileWatcher.h"
+
+#include <filesystem>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <chrono>
+
+#ifdef DY_PLATFORM_LINUX
+	#include <sys/inotify.h>
+	#include <poll.h>
+	#include <unistd.h>
+#endif
+
+namespace Dymatic {
+
+	struct WatchedFile
+	{
+		std::string Filepath;             // As passed to Watch
+		std::filesystem::path Absolute;
+		std::filesystem::file_time_type LastWriteTime;
+	};
+
+	struct FileWatcherData
+	{
+		std::mutex Mutex;
+		std::vector<WatchedFile> Files;
+		std::unordered_set<std::string> Changed;
+
+		std::thread Thread;
+		std::atomic<bool> Running = true;
+
+	#ifdef DY_PLATFORM_LINUX
+		int InotifyFD = -1;
+		std::unordered_map<int, std::filesystem::path> WatchDescriptors; // Directory per watch descriptor
+	#endif
+	};
+
+	static void MarkChanged(FileWatcherData& data, const std::filesystem::path& absolute)
+	{
+		std::lock_guard lock(data.Mutex);
+		for (auto& file : data.Files)
+		{
+			if (file.Absolute == absolute)
+				data.Changed.insert(file.Filepath);
+		}
+	}
+
+#ifdef DY_PLATFORM_LINUX
+	static void WatchThread(FileWatcherData& data)
+	{
+		// Editors often save through a temporary file and a rename, so both events count as a write
+		alignas(inotify_event) char buffer[4096];
+		while (data.Running)
+		{
+			pollfd descriptor = { data.InotifyFD, POLLIN, 0 };
+			if (poll(&descriptor, 1, 100) <= 0)
+				continue;
+
+			ssize_t length = read(data.InotifyFD, buffer, sizeof(buffer));
+			for (ssize_t offset = 0; offset < length;)
+			{
+				const inotify_event* event = (const inotify_event*)(buffer + offset);
+				offset += sizeof(inotify_event) + event->len;
+				if (event->len == 0)
+					continue;
+
+				std::filesystem::path directory;
+				{
+					std::lock_guard lock(data.Mutex);
+					auto it = data.WatchDescriptors.find(event->wd);
+					if (it == data.WatchDescriptors.end())
+						continue;
+					directory = it->second;
+				}
+				MarkChanged(data, directory / event->name);
+			}
+		}
+	}
+#else
+	static void WatchThread(FileWatcherData& data)
+	{
+		while (data.Running)
+		{
+			std::this_thread::sleep_for(std::chrono::milliseconds(250));
+
+			std::lock_guard lock(data.Mutex);
+			for (auto& file : data.Files)
+			{
+				std::error_code error;
+				auto writeTime = std::filesystem::last_write_time(file.Absolute, error);
+				if (!error && writeTime != file.LastWriteTime)
+				{
+					file.LastWriteTime = writeTime;
+					data.Changed.insert(file.Filepath);
+				}
+			}
+		}
+	}
+#endif
+
+	FileWatcher::FileWatcher()
+		: m_Data(CreateScope<FileWatcherData>())
+	{
+	#ifdef DY_PLATFORM_LINUX
+		m_Data->InotifyFD = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+		DY_CORE_ASSERT(m_Data->InotifyFD != -1, "Failed to initialize inotify!");
+	#endif
+
+		m_Data->Thread = std::thread(WatchThread, std::ref(*m_Data));
+	}
+
+	FileWatcher::~FileWatcher()
+	{
+		m_Data->Running = false;
+		m_Data->Thread.join();
+
+	#ifdef DY_PLATFORM_LINUX
+		close(m_Data->InotifyFD);
+	#endif
+	}
+
+	void FileWatcher::Watch(const std::string& filepath)
+	{
+		DY_PROFILE_FUNCTION();
+
+		std::error_code error;
+		WatchedFile file;
+		file.Filepath = filepath;
+		file.Absolute = std::filesystem::absolute(filepath, error).lexically_normal();
+		file.LastWriteTime = std::filesystem::last_write_time(file.Absolute, error);
+
+		std::lock_guard lock(m_Data->Mutex);
+		for (auto& watched : m_Data->Files)
+		{
+			if (watched.Filepath == filepath)
+				return;
+		}
+
+	#ifdef DY_PLATFORM_LINUX
+		std::filesystem::path directory = file.Absolute.parent_path();
+		int wd = inotify_add_watch(m_Data->InotifyFD, directory.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO);
+		if (wd == -1)
+		{
+			DY_CORE_WARN("Could not watch '{0}'", filepath);
+			return;
+		}
+		m_Data->WatchDescriptors[wd] = directory;
+	#endif
+
+		m_Data->Files.push_back(std::move(file));
+	}
+
+	std::vector<std::string> FileWatcher::GetChangedFiles()
+	{
+		std::lock_guard lock(m_Data->Mutex);
+		std::vector<std::string> changed(m_Data->Changed.begin(), m_Data->Changed.end());
+		m_Data->Changed.clear();
+		return changed;
+	}
+
+}
@@ -0,0 +1,28 @@
+#pragma once
+
+#include "Dymatic/Core/Base.h"
+
+#include <string>
+#include <vector>
+
+namespace Dymatic {
+
+	struct FileWatcherData;
+
+	// Watches individual files from a background thread. Uses inotify on Linux and
+	// compares modification times elsewhere. Changes are collected until the owner asks for them.
+	class FileWatcher
+	{
+	public:
+		FileWatcher();
+		~FileWatcher();
+
+		void Watch(const std::string& filepath);
+
+		// Files written since the last call, each reported once with the path passed to Watch
+		std::vector<std::string> GetChangedFiles();
+	private:
+		Scope<FileWatcherData> m_Data;
+	};
+
+}
@@ -13,4 +13,11 @@ namespace Dymatic {
 		static std::optional<std::string> SaveFile(const char* filter);
 	};
 
+	class Time
+	{
+	public:
+		// Seconds from a monotonic high resolution clock, only meaningful relative to other values
+		static double GetTime();
+	};
+
 }
\ No newline at end of file
@@ -0,0 +1,136 @@
+#include "dypch.h"
+#include "Dymatic/Utils/PlatformUtils.h"
+
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <filesystem>
+
+namespace Dymatic {
+
+	namespace Utils {
+
+		static std::string ShellQuote(const std::string& string)
+		{
+			std::string result = "'";
+			for (char c : string)
+			{
+				if (c == '\'')
+					result += "'\\''";
+				else
+					result += c;
+			}
+			return result + "'";
+		}
+
+		static bool HasCommand(const char* name)
+		{
+			std::string command = std::string("command -v ") + name + " > /dev/null 2>&1";
+			return std::system(command.c_str()) == 0;
+		}
+
+		// Filters use the Windows layout, "Name\0*.ext;*.ext2\0" pairs ending with an empty string
+		static std::vector<std::pair<std::string, std::string>> ParseFilter(const char* filter)
+		{
+			std::vector<std::pair<std::string, std::string>> result;
+			while (filter && *filter)
+			{
+				std::string name = filter;
+				filter += name.size() + 1;
+				std::string patterns = filter;
+				filter += patterns.size() + 1;
+
+				std::replace(patterns.begin(), patterns.end(), ';', ' ');
+				result.emplace_back(name, patterns);
+			}
+			return result;
+		}
+
+		static std::string GetDialogCommand(const char* filter, bool save)
+		{
+			auto filters = ParseFilter(filter);
+
+			// zenity goes through xdg-desktop-portal when one is running, which gives the native dialog on Wayland
+			if (HasCommand("zenity"))
+			{
+				std::string command = "GTK_USE_PORTAL=1 zenity --file-selection";
+				if (save)
+					command += " --save";
+				for (auto& [name, patterns] : filters)
+					command += " --file-filter=" + ShellQuote(name + " | " + patterns);
+				return command;
+			}
+
+			if (HasCommand("kdialog"))
+			{
+				std::string patterns;
+				for (auto& [name, pattern] : filters)
+					patterns += (patterns.empty() ? "" : "\n") + pattern + "|" + name;
+				return std::string("kdialog ") + (save ? "--getsavefilename" : "--getopenfilename") + " . " + ShellQuote(patterns);
+			}
+
+			return {};
+		}
+
+		static std::optional<std::string> RunDialog(const char* filter, bool save)
+		{
+			std::string command = GetDialogCommand(filter, save);
+			if (command.empty())
+			{
+				DY_CORE_ERROR("No file dialog available, install zenity or kdialog");
+				return std::nullopt;
+			}
+
+			FILE* pipe = popen((command + " 2> /dev/null").c_str(), "r");
+			if (!pipe)
+				return std::nullopt;
+
+			std::string result;
+			char buffer[512];
+			while (fgets(buffer, sizeof(buffer), pipe))
+				result += buffer;
+
+			// A cancelled dialog exits with a non-zero status
+			if (pclose(pipe) != 0)
+				return std::nullopt;
+
+			while (!result.empty() && (result.back() == '\n' || result.back() == '\r'))
+				result.pop_back();
+			if (result.empty())
+				return std::nullopt;
+			return result;
+		}
+
+	}
+
+	std::optional<std::string> FileDialogs::OpenFile(const char* filter)
+	{
+		return Utils::RunDialog(filter, false);
+	}
+
+	std::optional<std::string> FileDialogs::SaveFile(const char* filter)
+	{
+		std::optional<std::string> filepath = Utils::RunDialog(filter, true);
+		if (!filepath)
+			return std::nullopt;
+
+		// Sets the default extension by extracting it from the filter, like the Windows dialog does
+		auto filters = Utils::ParseFilter(filter);
+		if (!filters.empty() && !std::filesystem::path(*filepath).has_extension())
+		{
+			const std::string& pattern = filters.front().second;
+			auto dot = pattern.find('.');
+			if (dot != std::string::npos)
+				*filepath += pattern.substr(dot, pattern.find(' ', dot) - dot);
+		}
+		return filepath;
+	}
+
+	double Time::GetTime()
+	{
+		timespec time;
+		clock_gettime(CLOCK_MONOTONIC, &time);
+		return (double)time.tv_sec + (double)time.tv_nsec * 1e-9;
+	}
+
+}
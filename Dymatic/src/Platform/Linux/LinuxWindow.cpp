@@ -0,0 +1,205 @@
+#include "dypch.h"
+#include "Platform/Linux/LinuxWindow.h"
+
+#include "Dymatic/Core/Input.h"
+
+#include "Dymatic/Events/ApplicationEvent.h"
+#include "Dymatic/Events/MouseEvent.h"
+#include "Dymatic/Events/KeyEvent.h"
+
+#include "Dymatic/Renderer/Renderer.h"
+
+#include "Platform/OpenGL/OpenGLContext.h"
+
+namespace Dymatic {
+
+	static uint8_t s_GLFWWindowCount = 0;
+
+	static void GLFWErrorCallback(int error, const char* description)
+	{
+		DY_CORE_ERROR("GLFW Error ({0}): {1}", error, description);
+	}
+
+	LinuxWindow::LinuxWindow(const WindowProps& props)
+	{
+		DY_PROFILE_FUNCTION();
+
+		Init(props);
+	}
+
+	LinuxWindow::~LinuxWindow()
+	{
+		DY_PROFILE_FUNCTION();
+
+		Shutdown();
+	}
+
+	void LinuxWindow::Init(const WindowProps& props)
+	{
+		DY_PROFILE_FUNCTION();
+
+		m_Data.Title = props.Title;
+		m_Data.Width = props.Width;
+		m_Data.Height = props.Height;
+
+		DY_CORE_INFO("Creating window {0} ({1}, {2})", props.Title, props.Width, props.Height);
+
+		if (s_GLFWWindowCount == 0)
+		{
+			DY_PROFILE_SCOPE("glfwInit");
+			// GLFW is built for X11, Wayland sessions run the window through XWayland
+			int success = glfwInit();
+			DY_CORE_ASSERT(success, "Could not initialize GLFW!");
+			glfwSetErrorCallback(GLFWErrorCallback);
+		}
+
+		{
+			DY_PROFILE_SCOPE("glfwCreateWindow");
+#if defined(DY_DEBUG)
+			if (Renderer::GetAPI() == RendererAPI::API::OpenGL)
+				glfwWindowHint(GLFW_OPENGL_DEBUG_CONTEXT, GLFW_TRUE);
+#endif
+			m_Window = glfwCreateWindow((int)props.Width, (int)props.Height, m_Data.Title.c_str(), nullptr, nullptr);
+			++s_GLFWWindowCount;
+		}
+
+		m_Context = GraphicsContext::Create(m_Window);
+		m_Context->Init();
+
+		glfwSetWindowUserPointer(m_Window, &m_Data);
+		SetVSync(true);
+
+		// Set GLFW callbacks
+		glfwSetWindowSizeCallback(m_Window, [](GLFWwindow* window, int width, int height)
+		{
+			WindowData& data = *(WindowData*)glfwGetWindowUserPointer(window);
+			data.Width = width;
+			data.Height = height;
+
+			data.Queue->Push(WindowResizeEvent(width, height));
+		});
+
+		glfwSetWindowCloseCallback(m_Window, [](GLFWwindow* window)
+		{
+			WindowData& data = *(WindowData*)glfwGetWindowUserPointer(window);
+			data.Queue->Push(WindowCloseEvent());
+		});
+
+		glfwSetWindowFocusCallback(m_Window, [](GLFWwindow* window, int focused)
+		{
+			WindowData& data = *(WindowData*)glfwGetWindowUserPointer(window);
+			if (!focused)
+				data.Queue->Push(WindowLostFocusEvent());
+		});
+
+		glfwSetKeyCallback(m_Window, [](GLFWwindow* window, int key, int, int action, int)
+		{
+			WindowData& data = *(WindowData*)glfwGetWindowUserPointer(window);
+
+			switch (action)
+			{
+			case GLFW_PRESS:
+			{
+				data.Queue->Push(KeyPressedEvent(key, 0));
+				break;
+			}
+			case GLFW_RELEASE:
+			{
+				data.Queue->Push(KeyReleasedEvent(key));
+				break;
+			}
+			case GLFW_REPEAT:
+			{
+				data.Queue->Push(KeyPressedEvent(key, 1));
+				break;
+			}
+			}
+		});
+
+		glfwSetCharCallback(m_Window, [](GLFWwindow* window, unsigned int keycode)
+		{
+			WindowData& data = *(WindowData*)glfwGetWindowUserPointer(window);
+
+			data.Queue->Push(KeyTypedEvent(keycode));
+		});
+
+		glfwSetMouseButtonCallback(m_Window, [](GLFWwindow* window, int button, int action, int)
+		{
+			WindowData& data = *(WindowData*)glfwGetWindowUserPointer(window);
+
+			switch (action)
+			{
+			case GLFW_PRESS:
+			{
+				data.Queue->Push(MouseButtonPressedEvent(button));
+				break;
+			}
+			case GLFW_RELEASE:
+			{
+				data.Queue->Push(MouseButtonReleasedEvent(button));
+				break;
+			}
+			}
+		});
+
+		glfwSetScrollCallback(m_Window, [](GLFWwindow* window, double xOffset, double yOffset)
+		{
+			WindowData& data = *(WindowData*)glfwGetWindowUserPointer(window);
+
+			data.Queue->Push(MouseScrolledEvent((float)xOffset, (float)yOffset));
+		});
+
+		glfwSetCursorPosCallback(m_Window, [](GLFWwindow* window, double xPos, double yPos)
+		{
+			WindowData& data = *(WindowData*)glfwGetWindowUserPointer(window);
+
+			data.Queue->Push(MouseMovedEvent((float)xPos, (float)yPos));
+		});
+	}
+
+	void LinuxWindow::Shutdown()
+	{
+		DY_PROFILE_FUNCTION();
+
+		glfwDestroyWindow(m_Window);
+		--s_GLFWWindowCount;
+
+		if (s_GLFWWindowCount == 0)
+		{
+			glfwTerminate();
+		}
+	}
+
+	void LinuxWindow::OnUpdate()
+	{
+		DY_PROFILE_FUNCTION();
+
+		glfwPollEvents();
+		m_Context->SwapBuffers();
+	}
+
+	void LinuxWindow::WaitEvents(double timeout)
+	{
+		DY_PROFILE_FUNCTION();
+
+		glfwWaitEventsTimeout(timeout);
+	}
+
+	void LinuxWindow::SetVSync(bool enabled)
+	{
+		DY_PROFILE_FUNCTION();
+
+		if (enabled)
+			glfwSwapInterval(1);
+		else
+			glfwSwapInterval(0);
+
+		m_Data.VSync = enabled;
+	}
+
+	bool LinuxWindow::IsVSync() const
+	{
+		return m_Data.VSync;
+	}
+
+}
\ No newline at end of file
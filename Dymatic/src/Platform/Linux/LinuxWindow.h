@@ -0,0 +1,47 @@
+#pragma once
+
+#include "Dymatic/Core/Window.h"
+#include "Dymatic/Renderer/GraphicsContext.h"
+
+#include <GLFW/glfw3.h>
+
+namespace Dymatic {
+
+	class LinuxWindow : public Window
+	{
+	public:
+		LinuxWindow(const WindowProps& props);
+		virtual ~LinuxWindow();
+
+		void OnUpdate() override;
+		void WaitEvents(double timeout) override;
+
+		unsigned int GetWidth() const override { return m_Data.Width; }
+		unsigned int GetHeight() const override { return m_Data.Height; }
+
+		// Window attributes
+		void SetEventQueue(EventQueue* queue) override { m_Data.Queue = queue; }
+		void SetVSync(bool enabled) override;
+		bool IsVSync() const override;
+
+		virtual void* GetNativeWindow() const { return m_Window; }
+	private:
+		virtual void Init(const WindowProps& props);
+		virtual void Shutdown();
+	private:
+		GLFWwindow* m_Window;
+		Scope<GraphicsContext> m_Context;
+
+		struct WindowData
+		{
+			std::string Title;
+			unsigned int Width, Height;
+			bool VSync;
+
+			EventQueue* Queue = nullptr;
+		};
+
+		WindowData m_Data;
+	};
+
+}
\ No newline at end of file
@@ -0,0 +1,25 @@
+#pragma once
+
+#include "Dymatic/Renderer/RendererAPI.h"
+
+namespace Dymatic {
+
+	// Draws nothing and needs no context, for running renderer code headless. Timestamp queries
+	// keep the RendererAPI defaults, so GPU profiler scopes all report zero.
+	class NullRendererAPI : public RendererAPI
+	{
+	public:
+		virtual void Init() override {}
+		virtual void SetViewport(uint32_t, uint32_t, uint32_t, uint32_t) override {}
+
+		virtual void SetClearColor(const glm::vec4&) override {}
+		virtual void Clear() override {}
+
+		virtual void DrawIndexed(const Ref<VertexArray>&, uint32_t = 0) override {}
+		virtual void DrawIndexedInstanced(const Ref<VertexArray>&, uint32_t, uint32_t) override {}
+
+		virtual bool SupportsCompute() const override { return false; }
+		virtual void DispatchCompute(uint32_t, uint32_t, uint32_t) override {}
+	};
+
+}
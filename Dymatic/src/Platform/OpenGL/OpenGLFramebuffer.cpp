@@ -6,48 +6,185 @@
 namespace Dymatic {
 
 	static const uint32_t s_MaxFramebufferSize = 8192;
+	// Attachments are allocated in steps of this size so dragging a viewport edge rarely reallocates
+	static const uint32_t s_AllocationGranularity = 256;
+
+	namespace Utils {
+
+		static bool IsDepthFormat(FramebufferTextureFormat format)
+		{
+			switch (format)
+			{
+				case FramebufferTextureFormat::DEPTH24STENCIL8:
+				case FramebufferTextureFormat::DEPTH32F:
+					return true;
+				default:
+					return false;
+			}
+		}
+
+		static bool IsIntegerFormat(FramebufferTextureFormat format)
+		{
+			return format == FramebufferTextureFormat::RED_INTEGER;
+		}
+
+		static GLenum DymaticFBTextureFormatToGL(FramebufferTextureFormat format)
+		{
+			switch (format)
+			{
+				case FramebufferTextureFormat::RGBA8:           return GL_RGBA8;
+				case FramebufferTextureFormat::RGBA16F:         return GL_RGBA16F;
+				case FramebufferTextureFormat::RED_INTEGER:     return GL_R32I;
+				case FramebufferTextureFormat::DEPTH24STENCIL8: return GL_DEPTH24_STENCIL8;
+				case FramebufferTextureFormat::DEPTH32F:        return GL_DEPTH_COMPONENT32F;
+				default:                                        break;
+			}
+
+			DY_CORE_ASSERT(false, "Unknown framebuffer texture format!");
+			return 0;
+		}
+
+		static GLenum DepthAttachmentType(FramebufferTextureFormat format)
+		{
+			return format == FramebufferTextureFormat::DEPTH24STENCIL8 ? GL_DEPTH_STENCIL_ATTACHMENT : GL_DEPTH_ATTACHMENT;
+		}
+
+		static uint32_t RoundUpAllocation(uint32_t size)
+		{
+			uint32_t rounded = (size + s_AllocationGranularity - 1) / s_AllocationGranularity * s_AllocationGranularity;
+			return std::min(rounded, s_MaxFramebufferSize);
+		}
+
+		static uint32_t CreateAttachmentTexture(FramebufferTextureFormat format, uint32_t samples, uint32_t width, uint32_t height)
+		{
+			bool multisampled = samples > 1;
+
+			uint32_t id;
+			glCreateTextures(multisampled ? GL_TEXTURE_2D_MULTISAMPLE : GL_TEXTURE_2D, 1, &id);
+			if (multisampled)
+			{
+				glTextureStorage2DMultisample(id, samples, DymaticFBTextureFormatToGL(format), width, height, GL_FALSE);
+			}
+			else
+			{
+				glTextureStorage2D(id, 1, DymaticFBTextureFormatToGL(format), width, height);
+
+				// Integer textures can't be filtered
+				GLenum filter = IsIntegerFormat(format) ? GL_NEAREST : GL_LINEAR;
+				glTextureParameteri(id, GL_TEXTURE_MIN_FILTER, filter);
+				glTextureParameteri(id, GL_TEXTURE_MAG_FILTER, filter);
+				glTextureParameteri(id, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+				glTextureParameteri(id, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+			}
+			return id;
+		}
+
+		static void SetDrawBuffers(uint32_t framebuffer, size_t count)
+		{
+			DY_CORE_ASSERT(count <= 4, "Framebuffers support at most 4 color attachments!");
+			if (count == 0)
+			{
+				// Depth only pass
+				glNamedFramebufferDrawBuffer(framebuffer, GL_NONE);
+				return;
+			}
+
+			GLenum buffers[4] = { GL_COLOR_ATTACHMENT0, GL_COLOR_ATTACHMENT1, GL_COLOR_ATTACHMENT2, GL_COLOR_ATTACHMENT3 };
+			glNamedFramebufferDrawBuffers(framebuffer, (GLsizei)count, buffers);
+		}
+
+	}
 
 	OpenGLFramebuffer::OpenGLFramebuffer(const FramebufferSpecification& spec)
 		: m_Specification(spec)
 	{
+		for (auto attachment : m_Specification.Attachments.Attachments)
+		{
+			if (!Utils::IsDepthFormat(attachment.TextureFormat))
+				m_ColorAttachmentSpecifications.emplace_back(attachment);
+			else
+				m_DepthAttachmentSpecification = attachment;
+		}
+
 		Invalidate();
 	}
 
 	OpenGLFramebuffer::~OpenGLFramebuffer()
+	{
+		Release();
+	}
+
+	void OpenGLFramebuffer::Release()
 	{
 		glDeleteFramebuffers(1, &m_RendererID);
-		glDeleteTextures(1, &m_ColorAttachment);
+		glDeleteTextures((GLsizei)m_ColorAttachments.size(), m_ColorAttachments.data());
 		glDeleteTextures(1, &m_DepthAttachment);
+
+		if (m_ResolveRendererID)
+		{
+			glDeleteFramebuffers(1, &m_ResolveRendererID);
+			glDeleteTextures((GLsizei)m_ResolveAttachments.size(), m_ResolveAttachments.data());
+		}
+
+		m_RendererID = 0;
+		m_ResolveRendererID = 0;
+		m_DepthAttachment = 0;
+		m_ColorAttachments.clear();
+		m_ResolveAttachments.clear();
 	}
 
 	void OpenGLFramebuffer::Invalidate()
 	{
+		DY_PROFILE_FUNCTION();
+
 		if (m_RendererID)
+			Release();
+
+		m_AllocatedWidth = Utils::RoundUpAllocation(m_Specification.Width);
+		m_AllocatedHeight = Utils::RoundUpAllocation(m_Specification.Height);
+
+		uint32_t samples = std::max(m_Specification.Samples, 1u);
+		bool multisample = samples > 1;
+
+		glCreateFramebuffers(1, &m_RendererID);
+
+		// Attachments
+		m_ColorAttachments.resize(m_ColorAttachmentSpecifications.size());
+		for (size_t i = 0; i < m_ColorAttachments.size(); i++)
 		{
-			glDeleteFramebuffers(1, &m_RendererID);
-			glDeleteTextures(1, &m_ColorAttachment);
-			glDeleteTextures(1, &m_DepthAttachment);
+			m_ColorAttachments[i] = Utils::CreateAttachmentTexture(m_ColorAttachmentSpecifications[i].TextureFormat, samples, m_AllocatedWidth, m_AllocatedHeight);
+			glNamedFramebufferTexture(m_RendererID, GL_COLOR_ATTACHMENT0 + (GLenum)i, m_ColorAttachments[i], 0);
+			s_AllocationCount++;
 		}
 
-		glCreateFramebuffers(1, &m_RendererID);
-		glBindFramebuffer(GL_FRAMEBUFFER, m_RendererID);
+		if (m_DepthAttachmentSpecification.TextureFormat != FramebufferTextureFormat::None)
+		{
+			m_DepthAttachment = Utils::CreateAttachmentTexture(m_DepthAttachmentSpecification.TextureFormat, samples, m_AllocatedWidth, m_AllocatedHeight);
+			glNamedFramebufferTexture(m_RendererID, Utils::DepthAttachmentType(m_DepthAttachmentSpecification.TextureFormat), m_DepthAttachment, 0);
+			s_AllocationCount++;
+		}
 
-		glCreateTextures(GL_TEXTURE_2D, 1, &m_ColorAttachment);
-		glBindTexture(GL_TEXTURE_2D, m_ColorAttachment);
-		glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, m_Specification.Width, m_Specification.Height, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+		Utils::SetDrawBuffers(m_RendererID, m_ColorAttachments.size());
 
-		glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, m_ColorAttachment, 0);
+		DY_CORE_ASSERT(glCheckNamedFramebufferStatus(m_RendererID, GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE, "Framebuffer is incomplete!");
 
-		glCreateTextures(GL_TEXTURE_2D, 1, &m_DepthAttachment);
-		glBindTexture(GL_TEXTURE_2D, m_DepthAttachment);
-		glTexStorage2D(GL_TEXTURE_2D, 1, GL_DEPTH24_STENCIL8, m_Specification.Width, m_Specification.Height);
-		glFramebufferTexture2D(GL_FRAMEBUFFER, GL_DEPTH_STENCIL_ATTACHMENT, GL_TEXTURE_2D, m_DepthAttachment, 0);
+		// Resolve target, depth is never sampled so only the color attachments get a single sampled copy
+		if (multisample && !m_ColorAttachments.empty())
+		{
+			glCreateFramebuffers(1, &m_ResolveRendererID);
 
-		DY_CORE_ASSERT(glCheckFramebufferStatus(GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE, "Framebuffer is incomplete!");
+			m_ResolveAttachments.resize(m_ColorAttachmentSpecifications.size());
+			for (size_t i = 0; i < m_ResolveAttachments.size(); i++)
+			{
+				m_ResolveAttachments[i] = Utils::CreateAttachmentTexture(m_ColorAttachmentSpecifications[i].TextureFormat, 1, m_AllocatedWidth, m_AllocatedHeight);
+				glNamedFramebufferTexture(m_ResolveRendererID, GL_COLOR_ATTACHMENT0 + (GLenum)i, m_ResolveAttachments[i], 0);
+				s_AllocationCount++;
+			}
 
-		glBindFramebuffer(GL_FRAMEBUFFER, 0);
+			Utils::SetDrawBuffers(m_ResolveRendererID, m_ResolveAttachments.size());
+
+			DY_CORE_ASSERT(glCheckNamedFramebufferStatus(m_ResolveRendererID, GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE, "Resolve framebuffer is incomplete!");
+		}
 	}
 
 	void OpenGLFramebuffer::Bind()
@@ -58,6 +195,20 @@ namespace Dymatic {
 
 	void OpenGLFramebuffer::Unbind()
 	{
+		if (m_ResolveRendererID)
+		{
+			// Blit every color attachment separately, a blit only copies one read buffer
+			uint32_t width = m_Specification.Width, height = m_Specification.Height;
+			for (size_t i = 0; i < m_ColorAttachments.size(); i++)
+			{
+				glNamedFramebufferReadBuffer(m_RendererID, GL_COLOR_ATTACHMENT0 + (GLenum)i);
+				glNamedFramebufferDrawBuffer(m_ResolveRendererID, GL_COLOR_ATTACHMENT0 + (GLenum)i);
+				glBlitNamedFramebuffer(m_RendererID, m_ResolveRendererID, 0, 0, width, height, 0, 0, width, height, GL_COLOR_BUFFER_BIT, GL_NEAREST);
+			}
+			glNamedFramebufferReadBuffer(m_RendererID, GL_COLOR_ATTACHMENT0);
+			Utils::SetDrawBuffers(m_ResolveRendererID, m_ResolveAttachments.size());
+		}
+
 		glBindFramebuffer(GL_FRAMEBUFFER, 0);
 	}
 
@@ -71,7 +222,70 @@ namespace Dymatic {
 		m_Specification.Width = width;
 		m_Specification.Height = height;
 
+		// Reuse the current attachments while the size stays within the same allocation step
+		if (Utils::RoundUpAllocation(width) == m_AllocatedWidth && Utils::RoundUpAllocation(height) == m_AllocatedHeight)
+			return;
+
 		Invalidate();
 	}
 
+	int OpenGLFramebuffer::ReadPixel(uint32_t attachmentIndex, int x, int y)
+	{
+		DY_CORE_ASSERT(attachmentIndex < m_ColorAttachments.size(), "Attachment index out of range!");
+
+		if (x < 0 || y < 0 || x >= (int)m_Specification.Width || y >= (int)m_Specification.Height)
+			return -1;
+
+		uint32_t source = m_ResolveRendererID ? m_ResolveRendererID : m_RendererID;
+
+		GLint previous;
+		glGetIntegerv(GL_READ_FRAMEBUFFER_BINDING, &previous);
+
+		glNamedFramebufferReadBuffer(source, GL_COLOR_ATTACHMENT0 + attachmentIndex);
+		glBindFramebuffer(GL_READ_FRAMEBUFFER, source);
+
+		int pixelData = -1;
+		if (Utils::IsIntegerFormat(m_ColorAttachmentSpecifications[attachmentIndex].TextureFormat))
+		{
+			glReadPixels(x, y, 1, 1, GL_RED_INTEGER, GL_INT, &pixelData);
+		}
+		else
+		{
+			float value;
+			glReadPixels(x, y, 1, 1, GL_RED, GL_FLOAT, &value);
+			pixelData = (int)value;
+		}
+
+		glNamedFramebufferReadBuffer(source, GL_COLOR_ATTACHMENT0);
+		glBindFramebuffer(GL_READ_FRAMEBUFFER, previous);
+		return pixelData;
+	}
+
+	void OpenGLFramebuffer::ClearAttachment(uint32_t attachmentIndex, int value)
+	{
+		DY_CORE_ASSERT(attachmentIndex < m_ColorAttachments.size(), "Attachment index out of range!");
+
+		if (Utils::IsIntegerFormat(m_ColorAttachmentSpecifications[attachmentIndex].TextureFormat))
+		{
+			GLint values[4] = { value, value, value, value };
+			glClearNamedFramebufferiv(m_RendererID, GL_COLOR, attachmentIndex, values);
+		}
+		else
+		{
+			GLfloat values[4] = { (float)value, (float)value, (float)value, (float)value };
+			glClearNamedFramebufferfv(m_RendererID, GL_COLOR, attachmentIndex, values);
+		}
+	}
+
+	uint32_t OpenGLFramebuffer::GetColorAttachmentRendererID(uint32_t index) const
+	{
+		DY_CORE_ASSERT(index < m_ColorAttachments.size(), "Attachment index out of range!");
+		return m_ResolveRendererID ? m_ResolveAttachments[index] : m_ColorAttachments[index];
+	}
+
+	glm::vec2 OpenGLFramebuffer::GetTextureCoordinateScale() const
+	{
+		return { (float)m_Specification.Width / (float)m_AllocatedWidth, (float)m_Specification.Height / (float)m_AllocatedHeight };
+	}
+
 }
@@ -16,14 +16,31 @@ namespace Dymatic {
 		virtual void Unbind() override;
 
 		virtual void Resize(uint32_t width, uint32_t height) override;
+		virtual int ReadPixel(uint32_t attachmentIndex, int x, int y) override;
 
-		virtual uint32_t GetColorAttachmentRendererID() const override { return m_ColorAttachment; }
+		virtual void ClearAttachment(uint32_t attachmentIndex, int value) override;
+
+		virtual uint32_t GetColorAttachmentRendererID(uint32_t index = 0) const override;
+		virtual glm::vec2 GetTextureCoordinateScale() const override;
 
 		virtual const FramebufferSpecification& GetSpecification() const override { return m_Specification; };
+	private:
+		void Release();
 	private:
 		uint32_t m_RendererID = 0;
-		uint32_t m_ColorAttachment = 0, m_DepthAttachment = 0;
+		// Single sampled copy of the color attachments, only created when multisampling
+		uint32_t m_ResolveRendererID = 0;
 		FramebufferSpecification m_Specification;
+
+		// Size of the attachment textures, at least the specification's size
+		uint32_t m_AllocatedWidth = 0, m_AllocatedHeight = 0;
+
+		std::vector<FramebufferTextureSpecification> m_ColorAttachmentSpecifications;
+		FramebufferTextureSpecification m_DepthAttachmentSpecification = FramebufferTextureFormat::None;
+
+		std::vector<uint32_t> m_ColorAttachments;
+		std::vector<uint32_t> m_ResolveAttachments;
+		uint32_t m_DepthAttachment = 0;
 	};
 
 }
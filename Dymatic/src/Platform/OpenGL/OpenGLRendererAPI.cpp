@@ -60,9 +60,65 @@ namespace Dymatic {
 
 	void OpenGLRendererAPI::DrawIndexed(const Ref<VertexArray>& vertexArray, uint32_t indexCount)
 	{
+		vertexArray->Bind();
 		uint32_t count = indexCount ? indexCount : vertexArray->GetIndexBuffer()->GetCount();
 		glDrawElements(GL_TRIANGLES, count, GL_UNSIGNED_INT, nullptr);
 		glBindTexture(GL_TEXTURE_2D, 0);
 	}
 
+	void OpenGLRendererAPI::DrawIndexedInstanced(const Ref<VertexArray>& vertexArray, uint32_t indexCount, uint32_t instanceCount)
+	{
+		vertexArray->Bind();
+		uint32_t count = indexCount ? indexCount : vertexArray->GetIndexBuffer()->GetCount();
+		glDrawElementsInstanced(GL_TRIANGLES, count, GL_UNSIGNED_INT, nullptr, instanceCount);
+	}
+
+	bool OpenGLRendererAPI::SupportsCompute() const
+	{
+		// Compute shaders are core since 4.3
+		return GLAD_GL_VERSION_4_3;
+	}
+
+	void OpenGLRendererAPI::DispatchCompute(uint32_t groupsX, uint32_t groupsY, uint32_t groupsZ)
+	{
+		glDispatchCompute(groupsX, groupsY, groupsZ);
+		glMemoryBarrier(GL_SHADER_STORAGE_BARRIER_BIT | GL_VERTEX_ATTRIB_ARRAY_BARRIER_BIT | GL_BUFFER_UPDATE_BARRIER_BIT);
+	}
+
+	void OpenGLRendererAPI::CreateTimestampQueries(uint32_t count, uint32_t* queryIDs)
+	{
+		glCreateQueries(GL_TIMESTAMP, count, queryIDs);
+	}
+
+	void OpenGLRendererAPI::DeleteTimestampQueries(uint32_t count, const uint32_t* queryIDs)
+	{
+		glDeleteQueries(count, queryIDs);
+	}
+
+	void OpenGLRendererAPI::RecordTimestamp(uint32_t queryID)
+	{
+		glQueryCounter(queryID, GL_TIMESTAMP);
+	}
+
+	bool OpenGLRendererAPI::GetTimestampResult(uint32_t queryID, uint64_t& outNanoseconds)
+	{
+		// Never wait on the driver here, callers poll again on a later frame
+		GLint available = GL_FALSE;
+		glGetQueryObjectiv(queryID, GL_QUERY_RESULT_AVAILABLE, &available);
+		if (available == GL_FALSE)
+			return false;
+
+		GLuint64 result = 0;
+		glGetQueryObjectui64v(queryID, GL_QUERY_RESULT, &result);
+		outNanoseconds = result;
+		return true;
+	}
+
+	uint64_t OpenGLRendererAPI::GetCurrentTimestamp()
+	{
+		GLint64 timestamp = 0;
+		glGetInteger64v(GL_TIMESTAMP, &timestamp);
+		return (uint64_t)timestamp;
+	}
+
 }
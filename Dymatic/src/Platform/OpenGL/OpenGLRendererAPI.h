@@ -14,6 +14,16 @@ namespace Dymatic {
 		virtual void Clear() override;
 
 		virtual void DrawIndexed(const Ref<VertexArray>& vertexArray, uint32_t indexCount = 0) override;
+		virtual void DrawIndexedInstanced(const Ref<VertexArray>& vertexArray, uint32_t indexCount, uint32_t instanceCount) override;
+
+		virtual bool SupportsCompute() const override;
+		virtual void DispatchCompute(uint32_t groupsX, uint32_t groupsY, uint32_t groupsZ) override;
+
+		virtual void CreateTimestampQueries(uint32_t count, uint32_t* queryIDs) override;
+		virtual void DeleteTimestampQueries(uint32_t count, const uint32_t* queryIDs) override;
+		virtual void RecordTimestamp(uint32_t queryID) override;
+		virtual bool GetTimestampResult(uint32_t queryID, uint64_t& outNanoseconds) override;
+		virtual uint64_t GetCurrentTimestamp() override;
 	};
 
 }
\ No newline at end of file
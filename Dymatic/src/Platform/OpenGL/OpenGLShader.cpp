@@ -1,41 +1,177 @@
 #include "dypch.h"
 #include "Platform/OpenGL/OpenGLShader.h"
 
+#include "Dymatic/Core/Timer.h"
+
 #include <fstream>
+#include <filesystem>
 #include <glad/glad.h>
+#include <GLFW/glfw3.h>
 
 #include <glm/gtc/type_ptr.hpp>
 
+// GL_KHR_parallel_shader_compile, not part of the generated loader
+#ifndef GL_COMPLETION_STATUS_KHR
+	#define GL_MAX_SHADER_COMPILER_THREADS_KHR 0x91B0
+	#define GL_COMPLETION_STATUS_KHR 0x91B1
+	typedef void (APIENTRYP PFNGLMAXSHADERCOMPILERTHREADSKHRPROC)(GLuint count);
+#endif
+
 namespace Dymatic {
 
+	namespace Utils {
+
+		static const char* GetCacheDirectory()
+		{
+			return "assets/cache/shader/opengl";
+		}
+
+		// The cache lives in the assets directory of the working directory. Without one the
+		// application was started from somewhere else, and writing would scatter cache folders.
+		static bool CreateCacheDirectoryIfNeeded()
+		{
+			static bool s_Warned = false;
+			if (!std::filesystem::is_directory("assets"))
+			{
+				if (!s_Warned)
+					DY_CORE_WARN("No assets directory in '{0}', shader binaries are not cached", std::filesystem::current_path().string());
+				s_Warned = true;
+				return false;
+			}
+
+			std::error_code error;
+			std::filesystem::create_directories(GetCacheDirectory(), error);
+			if (error)
+			{
+				if (!s_Warned)
+					DY_CORE_WARN("Could not create shader cache directory '{0}': {1}", GetCacheDirectory(), error.message());
+				s_Warned = true;
+				return false;
+			}
+			return true;
+		}
+
+		static uint64_t HashFNV1a(const void* data, size_t size, uint64_t hash = 14695981039346656037ull)
+		{
+			const uint8_t* bytes = (const uint8_t*)data;
+			for (size_t i = 0; i < size; i++)
+			{
+				hash ^= bytes[i];
+				hash *= 1099511628211ull;
+			}
+			return hash;
+		}
+
+		static uint64_t HashString(const std::string& string, uint64_t hash = 14695981039346656037ull)
+		{
+			return HashFNV1a(string.data(), string.size(), hash);
+		}
+
+		static uint64_t HashShaderSources(const std::unordered_map<GLenum, std::string>& shaderSources)
+		{
+			// Stages are hashed in a fixed order, the map order is unspecified
+			std::vector<GLenum> stages;
+			for (auto& kv : shaderSources)
+				stages.push_back(kv.first);
+			std::sort(stages.begin(), stages.end());
+
+			uint64_t hash = 14695981039346656037ull;
+			for (GLenum stage : stages)
+			{
+				hash = HashFNV1a(&stage, sizeof(GLenum), hash);
+				hash = HashString(shaderSources.at(stage), hash);
+			}
+			return hash;
+		}
+
+		// A driver update or another GPU invalidates every cached binary
+		static uint64_t GetDriverHash()
+		{
+			static uint64_t s_DriverHash = 0;
+			if (s_DriverHash == 0)
+			{
+				for (GLenum name : { GL_VENDOR, GL_RENDERER, GL_VERSION })
+				{
+					const char* value = (const char*)glGetString(name);
+					s_DriverHash = HashString(value ? value : "", s_DriverHash ? s_DriverHash : 14695981039346656037ull);
+				}
+			}
+			return s_DriverHash;
+		}
+
+		static bool IsProgramBinarySupported()
+		{
+			GLint formats = 0;
+			glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formats);
+			return formats > 0;
+		}
+
+		static bool IsParallelCompileSupported()
+		{
+			static int s_Supported = -1;
+			if (s_Supported == -1)
+			{
+				s_Supported = glfwExtensionSupported("GL_KHR_parallel_shader_compile") || glfwExtensionSupported("GL_ARB_parallel_shader_compile");
+				if (s_Supported)
+				{
+					// Let the driver pick as many compiler threads as it likes
+					auto maxShaderCompilerThreads = (PFNGLMAXSHADERCOMPILERTHREADSKHRPROC)glfwGetProcAddress("glMaxShaderCompilerThreadsKHR");
+					if (!maxShaderCompilerThreads)
+						maxShaderCompilerThreads = (PFNGLMAXSHADERCOMPILERTHREADSKHRPROC)glfwGetProcAddress("glMaxShaderCompilerThreadsARB");
+					if (maxShaderCompilerThreads)
+						maxShaderCompilerThreads(0xFFFFFFFF);
+				}
+				DY_CORE_INFO("Parallel shader compilation: {0}", s_Supported ? "supported" : "not supported");
+			}
+			return s_Supported;
+		}
+
+		struct ProgramBinaryHeader
+		{
+			static const uint32_t CurrentMagic = 0x42534744; // "DGSB"
+			static const uint32_t CurrentVersion = 1;
+
+			uint32_t Magic = CurrentMagic;
+			uint32_t Version = CurrentVersion;
+			uint64_t SourceHash = 0;
+			uint64_t DriverHash = 0;
+			uint32_t BinaryFormat = 0;
+			uint32_t BinarySize = 0;
+		};
+
+	}
+
 	static GLenum ShaderTypeFromString(const std::string& type)
 	{
 		if (type == "vertex")
 			return GL_VERTEX_SHADER;
 		if (type == "fragment" || type == "pixel")
 			return GL_FRAGMENT_SHADER;
+		if (type == "compute")
+			return GL_COMPUTE_SHADER;
 
 		DY_CORE_ASSERT(false, "Unknown shader type!");
 		return 0;
 	}
 
-	OpenGLShader::OpenGLShader(const std::string& filepath)
+	OpenGLShader::OpenGLShader(const std::string& filepath, bool wait)
+		: m_Filepath(filepath)
 	{
 		DY_PROFILE_FUNCTION();
 
-		std::string source = ReadFile(filepath);
-		auto shaderSources = PreProcess(source);
-		Compile(shaderSources);
-
 		// Extract name from filepath
 		auto lastSlash = filepath.find_last_of("/\\");
 		lastSlash = lastSlash == std::string::npos ? 0 : lastSlash + 1;
 		auto lastDot = filepath.rfind('.');
 		auto count = lastDot == std::string::npos ? filepath.size() - lastSlash : lastDot - lastSlash;
 		m_Name = filepath.substr(lastSlash, count);
+
+		std::string source = ReadFile(filepath);
+		auto shaderSources = PreProcess(source);
+		CreateProgram(shaderSources, wait);
 	}
 
-	OpenGLShader::OpenGLShader(const std::string& name, const std::string& vertexSrc, const std::string& fragmentSrc)
+	OpenGLShader::OpenGLShader(const std::string& name, const std::string& vertexSrc, const std::string& fragmentSrc, bool wait)
 		: m_Name(name)
 	{
 		DY_PROFILE_FUNCTION();
@@ -43,13 +179,15 @@ namespace Dymatic {
 		std::unordered_map<GLenum, std::string> sources;
 		sources[GL_VERTEX_SHADER] = vertexSrc;
 		sources[GL_FRAGMENT_SHADER] = fragmentSrc;
-		Compile(sources);
+		CreateProgram(sources, wait);
 	}
 
 	OpenGLShader::~OpenGLShader()
 	{
 		DY_PROFILE_FUNCTION();
 
+		for (auto id : m_PendingShaderIDs)
+			glDeleteShader(id);
 		glDeleteProgram(m_RendererID);
 	}
 
@@ -109,14 +247,114 @@ namespace Dymatic {
 		return shaderSources;
 	}
 
+	void OpenGLShader::CreateProgram(const std::unordered_map<GLenum, std::string>& shaderSources, bool wait)
+	{
+		DY_PROFILE_FUNCTION();
+
+		m_CompileTimer.Reset();
+		m_CacheSupported = Shader::IsBinaryCacheEnabled() && Utils::IsProgramBinarySupported();
+		m_SourceHash = Utils::HashShaderSources(shaderSources);
+
+		if (m_CacheSupported && LoadCachedBinary(m_SourceHash))
+		{
+			DY_CORE_TRACE("Shader '{0}' loaded from cache in {1}ms", m_Name, m_CompileTimer.ElapsedMillis());
+			return;
+		}
+
+		Compile(shaderSources);
+		if (wait)
+			FinishCompile();
+	}
+
+	std::string OpenGLShader::GetCachePath() const
+	{
+		// Names are not unique, so the file is keyed by the source file, or the sources for shaders built from strings
+		uint64_t key = m_Filepath.empty() ? m_SourceHash : Utils::HashString(std::filesystem::path(m_Filepath).lexically_normal().generic_string());
+
+		char keyString[17];
+		snprintf(keyString, sizeof(keyString), "%016llx", (unsigned long long)key);
+		return (std::filesystem::path(Utils::GetCacheDirectory()) / (m_Name + "-" + keyString + ".glbin")).string();
+	}
+
+	bool OpenGLShader::LoadCachedBinary(uint64_t sourceHash)
+	{
+		DY_PROFILE_FUNCTION();
+
+		std::ifstream in(GetCachePath(), std::ios::in | std::ios::binary);
+		if (!in)
+			return false;
+
+		Utils::ProgramBinaryHeader header;
+		in.read((char*)&header, sizeof(header));
+		if (!in || header.Magic != Utils::ProgramBinaryHeader::CurrentMagic || header.Version != Utils::ProgramBinaryHeader::CurrentVersion
+			|| header.SourceHash != sourceHash || header.DriverHash != Utils::GetDriverHash())
+			return false;
+
+		std::vector<char> binary(header.BinarySize);
+		in.read(binary.data(), binary.size());
+		if (!in)
+			return false;
+
+		GLuint program = glCreateProgram();
+		glProgramBinary(program, header.BinaryFormat, binary.data(), (GLsizei)binary.size());
+
+		// The driver may still reject a binary it produced, recompile from source in that case
+		GLint isLinked = 0;
+		glGetProgramiv(program, GL_LINK_STATUS, &isLinked);
+		if (isLinked == GL_FALSE)
+		{
+			DY_CORE_WARN("Cached binary of shader '{0}' was rejected by the driver, recompiling", m_Name);
+			glDeleteProgram(program);
+			return false;
+		}
+
+		m_RendererID = program;
+		Reflect();
+		return true;
+	}
+
+	void OpenGLShader::SaveCachedBinary(uint64_t sourceHash)
+	{
+		DY_PROFILE_FUNCTION();
+
+		GLint length = 0;
+		glGetProgramiv(m_RendererID, GL_PROGRAM_BINARY_LENGTH, &length);
+		if (length <= 0)
+			return;
+
+		Utils::ProgramBinaryHeader header;
+		header.SourceHash = sourceHash;
+		header.DriverHash = Utils::GetDriverHash();
+
+		std::vector<char> binary(length);
+		GLenum format = 0;
+		glGetProgramBinary(m_RendererID, length, &length, &format, binary.data());
+		header.BinaryFormat = format;
+		header.BinarySize = (uint32_t)length;
+
+		if (!Utils::CreateCacheDirectoryIfNeeded())
+			return;
+
+		std::ofstream out(GetCachePath(), std::ios::out | std::ios::binary);
+		if (!out)
+		{
+			DY_CORE_WARN("Could not write shader cache file '{0}'", GetCachePath());
+			return;
+		}
+
+		out.write((const char*)&header, sizeof(header));
+		out.write(binary.data(), header.BinarySize);
+	}
+
 	void OpenGLShader::Compile(const std::unordered_map<GLenum, std::string>& shaderSources)
 	{
 		DY_PROFILE_FUNCTION();
 
+		// Only issues the work, no status is queried here so the driver can compile in the background
 		GLuint program = glCreateProgram();
+		glProgramParameteri(program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+
 		DY_CORE_ASSERT(shaderSources.size() <= 2, "We only support 2 shaders for now");
-		std::array<GLenum, 2> glShaderIDs;
-		int glShaderIDIndex = 0;
 		for (auto& kv : shaderSources)
 		{
 			GLenum type = kv.first;
@@ -129,66 +367,196 @@ namespace Dymatic {
 
 			glCompileShader(shader);
 
-			GLint isCompiled = 0;
-			glGetShaderiv(shader, GL_COMPILE_STATUS, &isCompiled);
-			if (isCompiled == GL_FALSE)
-			{
-				GLint maxLength = 0;
-				glGetShaderiv(shader, GL_INFO_LOG_LENGTH, &maxLength);
-
-				std::vector<GLchar> infoLog(maxLength);
-				glGetShaderInfoLog(shader, maxLength, &maxLength, &infoLog[0]);
-
-				glDeleteShader(shader);
-
-				DY_CORE_ERROR("{0}", infoLog.data());
-				DY_CORE_ASSERT(false, "Shader compilation failure!");
-				break;
-			}
-
 			glAttachShader(program, shader);
-			glShaderIDs[glShaderIDIndex++] = shader;
+			m_PendingShaderIDs.push_back(shader);
 		}
 
 		m_RendererID = program;
 
 		// Link our program
 		glLinkProgram(program);
+	}
+
+	bool OpenGLShader::IsReady()
+	{
+		if (m_PendingShaderIDs.empty())
+			return true;
+
+		// Without the extension the status query below would block, so just finish
+		if (Utils::IsParallelCompileSupported())
+		{
+			GLint completed = GL_FALSE;
+			glGetProgramiv(m_RendererID, GL_COMPLETION_STATUS_KHR, &completed);
+			if (completed == GL_FALSE)
+				return false;
+		}
+
+		FinishCompile();
+		return true;
+	}
+
+	void OpenGLShader::FinishCompile()
+	{
+		DY_PROFILE_FUNCTION();
+
+		if (m_PendingShaderIDs.empty())
+			return;
+
+		GLuint program = m_RendererID;
 
 		// Note the different functions here: glGetProgram* instead of glGetShader*.
 		GLint isLinked = 0;
 		glGetProgramiv(program, GL_LINK_STATUS, (int*)&isLinked);
 		if (isLinked == GL_FALSE)
 		{
+			// Report the failing stage first, its log is more useful than the link log
+			for (auto id : m_PendingShaderIDs)
+			{
+				GLint isCompiled = 0;
+				glGetShaderiv(id, GL_COMPILE_STATUS, &isCompiled);
+				if (isCompiled == GL_FALSE)
+				{
+					GLint maxLength = 0;
+					glGetShaderiv(id, GL_INFO_LOG_LENGTH, &maxLength);
+
+					std::vector<GLchar> infoLog(maxLength + 1);
+					glGetShaderInfoLog(id, maxLength, &maxLength, &infoLog[0]);
+
+					DY_CORE_ERROR("{0}", infoLog.data());
+					if (m_AssertOnFailure)
+						DY_CORE_ASSERT(false, "Shader compilation failure!");
+				}
+			}
+
 			GLint maxLength = 0;
 			glGetProgramiv(program, GL_INFO_LOG_LENGTH, &maxLength);
 
 			// The maxLength includes the NULL character
-			std::vector<GLchar> infoLog(maxLength);
+			std::vector<GLchar> infoLog(maxLength + 1);
 			glGetProgramInfoLog(program, maxLength, &maxLength, &infoLog[0]);
 
 			// We don't need the program anymore.
 			glDeleteProgram(program);
 
-			for (auto id : glShaderIDs)
+			for (auto id : m_PendingShaderIDs)
 				glDeleteShader(id);
+			m_PendingShaderIDs.clear();
+			m_RendererID = 0;
 
 			DY_CORE_ERROR("{0}", infoLog.data());
-			DY_CORE_ASSERT(false, "Shader link failure!");
+			if (m_AssertOnFailure)
+				DY_CORE_ASSERT(false, "Shader link failure!");
 			return;
 		}
 
-		for (auto id : glShaderIDs)
+		for (auto id : m_PendingShaderIDs)
 		{
 			glDetachShader(program, id);
 			glDeleteShader(id);
 		}
+		m_PendingShaderIDs.clear();
+
+		Reflect();
+
+		if (m_CacheSupported)
+			SaveCachedBinary(m_SourceHash);
+
+		DY_CORE_TRACE("Shader '{0}' compiled in {1}ms", m_Name, m_CompileTimer.ElapsedMillis());
+	}
+
+	void OpenGLShader::Reload()
+	{
+		DY_PROFILE_FUNCTION();
+
+		if (m_Filepath.empty())
+			return;
+
+		// A reload still compiling is superseded by the newer source
+		m_Reload = CreateScope<OpenGLShader>(m_Filepath, false);
+		m_Reload->m_AssertOnFailure = false;
+	}
+
+	bool OpenGLShader::ProcessReload()
+	{
+		DY_PROFILE_FUNCTION();
+
+		if (!m_Reload)
+			return false;
+
+		if (!m_Reload->IsReady())
+			return true;
+
+		if (m_Reload->m_RendererID != 0)
+		{
+			std::swap(m_RendererID, m_Reload->m_RendererID);
+			std::swap(m_UniformLocations, m_Reload->m_UniformLocations);
+			std::swap(m_SourceHash, m_Reload->m_SourceHash);
+			DY_CORE_INFO("Shader '{0}' reloaded in {1}ms", m_Name, m_Reload->m_CompileTimer.ElapsedMillis());
+		}
+		else
+		{
+			DY_CORE_ERROR("Shader '{0}' failed to reload, keeping the previous program", m_Name);
+		}
+
+		// Deletes whichever program lost
+		m_Reload.reset();
+		return false;
+	}
+
+	void OpenGLShader::Reflect()
+	{
+		DY_PROFILE_FUNCTION();
+
+		m_UniformLocations.Clear();
+
+		GLint uniformCount = 0, maxNameLength = 0;
+		glGetProgramiv(m_RendererID, GL_ACTIVE_UNIFORMS, &uniformCount);
+		glGetProgramiv(m_RendererID, GL_ACTIVE_UNIFORM_MAX_LENGTH, &maxNameLength);
+
+		m_UniformLocations.Reserve((uint32_t)uniformCount);
+
+		std::vector<GLchar> nameBuffer(maxNameLength + 1);
+		for (GLint i = 0; i < uniformCount; i++)
+		{
+			GLint size = 0;
+			GLenum type = 0;
+			GLsizei length = 0;
+			glGetActiveUniform(m_RendererID, i, (GLsizei)nameBuffer.size(), &length, &size, &type, nameBuffer.data());
+
+			// Members of uniform blocks have no location, they are set through UniformBuffer
+			std::string name(nameBuffer.data(), length);
+			GLint location = glGetUniformLocation(m_RendererID, name.c_str());
+			if (location == -1)
+				continue;
+
+			m_UniformLocations.Insert(name, location);
+			if (size > 1 || name.back() == ']')
+			{
+				std::string baseName = name.substr(0, name.find('['));
+				m_UniformLocations.Insert(baseName, location);
+				for (GLint element = 1; element < size; element++)
+				{
+					std::string elementName = baseName + "[" + std::to_string(element) + "]";
+					m_UniformLocations.Insert(elementName, glGetUniformLocation(m_RendererID, elementName.c_str()));
+				}
+			}
+		}
+	}
+
+	int OpenGLShader::GetUniformLocation(const std::string& name) const
+	{
+		// Bind() finishes pending compilation, so the locations are known by the time uniforms are set
+		return m_UniformLocations.Find(name);
 	}
 
 	void OpenGLShader::Bind() const
 	{
 		DY_PROFILE_FUNCTION();
 
+		// Binding a shader that is still compiling waits for it
+		if (!m_PendingShaderIDs.empty())
+			const_cast<OpenGLShader*>(this)->FinishCompile();
+
 		glUseProgram(m_RendererID);
 	}
 
@@ -241,49 +609,49 @@ namespace Dymatic {
 
 	void OpenGLShader::UploadUniformInt(const std::string& name, int value)
 	{
-		GLint location = glGetUniformLocation(m_RendererID, name.c_str());
+		GLint location = GetUniformLocation(name);
 		glUniform1i(location, value);
 	}
 
 	void OpenGLShader::UploadUniformIntArray(const std::string& name, int* values, uint32_t count)
 	{
-		GLint location = glGetUniformLocation(m_RendererID, name.c_str());
+		GLint location = GetUniformLocation(name);
 		glUniform1iv(location, count, values);
 	}
 
 	void OpenGLShader::UploadUniformFloat(const std::string& name, float value)
 	{
-		GLint location = glGetUniformLocation(m_RendererID, name.c_str());
+		GLint location = GetUniformLocation(name);
 		glUniform1f(location, value);
 	}
 
 	void OpenGLShader::UploadUniformFloat2(const std::string& name, const glm::vec2& value)
 	{
-		GLint location = glGetUniformLocation(m_RendererID, name.c_str());
+		GLint location = GetUniformLocation(name);
 		glUniform2f(location, value.x, value.y);
 	}
 
 	void OpenGLShader::UploadUniformFloat3(const std::string& name, const glm::vec3& value)
 	{
-		GLint location = glGetUniformLocation(m_RendererID, name.c_str());
+		GLint location = GetUniformLocation(name);
 		glUniform3f(location, value.x, value.y, value.z);
 	}
 
 	void OpenGLShader::UploadUniformFloat4(const std::string& name, const glm::vec4& value)
 	{
-		GLint location = glGetUniformLocation(m_RendererID, name.c_str());
+		GLint location = GetUniformLocation(name);
 		glUniform4f(location, value.x, value.y, value.z, value.w);
 	}
 
 	void OpenGLShader::UploadUniformMat3(const std::string& name, const glm::mat3& matrix)
 	{
-		GLint location = glGetUniformLocation(m_RendererID, name.c_str());
+		GLint location = GetUniformLocation(name);
 		glUniformMatrix3fv(location, 1, GL_FALSE, glm::value_ptr(matrix));
 	}
 
 	void OpenGLShader::UploadUniformMat4(const std::string& name, const glm::mat4& matrix)
 	{
-		GLint location = glGetUniformLocation(m_RendererID, name.c_str());
+		GLint location = GetUniformLocation(name);
 		glUniformMatrix4fv(location, 1, GL_FALSE, glm::value_ptr(matrix));
 	}
 
@@ -1,6 +1,8 @@
 #pragma once
 
 #include "Dymatic/Renderer/Shader.h"
+#include "Dymatic/Core/Timer.h"
+#include "Platform/OpenGL/OpenGLUniformLocationMap.h"
 #include <glm/glm.hpp>
 
 //REMOVE LATER (BAD CODE)
@@ -11,8 +13,9 @@ namespace Dymatic {
 	class OpenGLShader : public Shader
 	{
 	public:
-		OpenGLShader(const std::string& filepath);
-		OpenGLShader(const std::string& name, const std::string& vertexSrc, const std::string& fragmentSrc);
+		// With wait = false compilation is only issued, IsReady() polls it and Bind() waits for it
+		OpenGLShader(const std::string& filepath, bool wait = true);
+		OpenGLShader(const std::string& name, const std::string& vertexSrc, const std::string& fragmentSrc, bool wait = true);
 		virtual ~OpenGLShader();
 
 		virtual void Bind() const override;
@@ -27,6 +30,13 @@ namespace Dymatic {
 
 		virtual const std::string& GetName() const override { return m_Name; }
 
+		virtual bool IsReady() override;
+
+		virtual const std::string& GetFilepath() const override { return m_Filepath; }
+
+		virtual void Reload() override;
+		virtual bool ProcessReload() override;
+
 		void UploadUniformInt(const std::string& name, int value);
 		void UploadUniformIntArray(const std::string& name, int* values, uint32_t count);
 
@@ -40,10 +50,33 @@ namespace Dymatic {
 	private:
 		std::string ReadFile(const std::string& filepath);
 		std::unordered_map<GLenum, std::string> PreProcess(const std::string& source);
+		void CreateProgram(const std::unordered_map<GLenum, std::string>& shaderSources, bool wait);
 		void Compile(const std::unordered_map<GLenum, std::string>& shaderSources);
+		void FinishCompile();
+		void Reflect();
+
+		int GetUniformLocation(const std::string& name) const;
+
+		// Program binary cache, keyed by the sources and the driver that produced the binary
+		bool LoadCachedBinary(uint64_t sourceHash);
+		void SaveCachedBinary(uint64_t sourceHash);
+		std::string GetCachePath() const;
 	private:
-		uint32_t m_RendererID;
+		uint32_t m_RendererID = 0;
 		std::string m_Name;
+		std::string m_Filepath;
+
+		// Filled by Reflect() once the program is linked, arrays are also stored without their "[0]"
+		OpenGLUniformLocationMap m_UniformLocations;
+
+		std::vector<uint32_t> m_PendingShaderIDs;
+		uint64_t m_SourceHash = 0;
+		bool m_CacheSupported = false;
+		Timer m_CompileTimer;
+
+		// Compiled next to the live program, a failure is only logged so a typo does not stop the application
+		Scope<OpenGLShader> m_Reload;
+		bool m_AssertOnFailure = true;
 	};
 
 }
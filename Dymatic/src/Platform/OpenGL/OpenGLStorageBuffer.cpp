@@ -0,0 +1,44 @@
+#include "dypch.h"
+#include "Platform/OpenGL/OpenGLStorageBuffer.h"
+
+#include <glad/glad.h>
+
+namespace Dymatic {
+
+	OpenGLStorageBuffer::OpenGLStorageBuffer(uint32_t size, uint32_t binding)
+		: m_Binding(binding)
+	{
+		DY_PROFILE_FUNCTION();
+
+		glCreateBuffers(1, &m_RendererID);
+		glNamedBufferData(m_RendererID, size, nullptr, GL_DYNAMIC_DRAW);
+		glBindBufferBase(GL_SHADER_STORAGE_BUFFER, binding, m_RendererID);
+	}
+
+	OpenGLStorageBuffer::~OpenGLStorageBuffer()
+	{
+		DY_PROFILE_FUNCTION();
+
+		glDeleteBuffers(1, &m_RendererID);
+	}
+
+	void OpenGLStorageBuffer::SetData(const void* data, uint32_t size, uint32_t offset)
+	{
+		DY_PROFILE_FUNCTION();
+
+		glNamedBufferSubData(m_RendererID, offset, size, data);
+	}
+
+	void OpenGLStorageBuffer::GetData(void* data, uint32_t size, uint32_t offset) const
+	{
+		DY_PROFILE_FUNCTION();
+
+		glGetNamedBufferSubData(m_RendererID, offset, size, data);
+	}
+
+	void OpenGLStorageBuffer::Bind() const
+	{
+		glBindBufferBase(GL_SHADER_STORAGE_BUFFER, m_Binding, m_RendererID);
+	}
+
+}
@@ -0,0 +1,22 @@
+#pragma once
+
+#include "Dymatic/Renderer/StorageBuffer.h"
+
+namespace Dymatic {
+
+	class OpenGLStorageBuffer : public StorageBuffer
+	{
+	public:
+		OpenGLStorageBuffer(uint32_t size, uint32_t binding);
+		virtual ~OpenGLStorageBuffer();
+
+		virtual void SetData(const void* data, uint32_t size, uint32_t offset = 0) override;
+		virtual void GetData(void* data, uint32_t size, uint32_t offset = 0) const override;
+
+		virtual void Bind() const override;
+	private:
+		uint32_t m_RendererID = 0;
+		uint32_t m_Binding;
+	};
+
+}
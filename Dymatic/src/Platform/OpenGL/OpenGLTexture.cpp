@@ -3,31 +3,86 @@
 
 #include <stb_image.h>
 
+#ifndef GL_COMPRESSED_RGB_S3TC_DXT1_EXT
+	#define GL_COMPRESSED_RGB_S3TC_DXT1_EXT 0x83F0
+	#define GL_COMPRESSED_RGBA_S3TC_DXT1_EXT 0x83F1
+	#define GL_COMPRESSED_RGBA_S3TC_DXT5_EXT 0x83F3
+#endif
+#ifndef GL_COMPRESSED_SRGB_S3TC_DXT1_EXT
+	#define GL_COMPRESSED_SRGB_S3TC_DXT1_EXT 0x8C4C
+	#define GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT1_EXT 0x8C4D
+	#define GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT5_EXT 0x8C4F
+#endif
+
 namespace Dymatic {
 
-	OpenGLTexture2D::OpenGLTexture2D(uint32_t width, uint32_t height)
-		: m_Width(width), m_Height(height)
-	{
-		DY_PROFILE_FUNCTION();
+	namespace Utils {
 
-		m_InternalFormat = GL_RGBA8;
-		m_DataFormat = GL_RGBA;
+		static uint32_t CalculateMipCount(uint32_t width, uint32_t height)
+		{
+			return (uint32_t)std::floor(std::log2(std::max(width, height))) + 1;
+		}
 
-		glCreateTextures(GL_TEXTURE_2D, 1, &m_RendererID);
-		glTextureStorage2D(m_RendererID, 1, m_InternalFormat, m_Width, m_Height);
+		static GLenum CompressedFormatToGL(CompressedTextureFormat format, bool srgb)
+		{
+			switch (format)
+			{
+			case CompressedTextureFormat::BC1:  return srgb ? GL_COMPRESSED_SRGB_S3TC_DXT1_EXT : GL_COMPRESSED_RGB_S3TC_DXT1_EXT;
+			case CompressedTextureFormat::BC1A: return srgb ? GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT1_EXT : GL_COMPRESSED_RGBA_S3TC_DXT1_EXT;
+			case CompressedTextureFormat::BC3:  return srgb ? GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT5_EXT : GL_COMPRESSED_RGBA_S3TC_DXT5_EXT;
+			case CompressedTextureFormat::BC7:  return srgb ? GL_COMPRESSED_SRGB_ALPHA_BPTC_UNORM : GL_COMPRESSED_RGBA_BPTC_UNORM;
+			default:                            break;
+			}
+
+			DY_CORE_ASSERT(false, "Unknown compressed texture format!");
+			return 0;
+		}
 
-		glTextureParameteri(m_RendererID, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-		glTextureParameteri(m_RendererID, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+		static uint32_t BitsPerPixel(GLenum internalFormat)
+		{
+			switch (internalFormat)
+			{
+			case GL_RGBA8: return 32;
+			case GL_RGB8:  return 24;
+			case GL_COMPRESSED_RGB_S3TC_DXT1_EXT:
+			case GL_COMPRESSED_RGBA_S3TC_DXT1_EXT:
+			case GL_COMPRESSED_SRGB_S3TC_DXT1_EXT:
+			case GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT1_EXT: return 4;
+			case GL_COMPRESSED_RGBA_S3TC_DXT5_EXT:
+			case GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT5_EXT:
+			case GL_COMPRESSED_RGBA_BPTC_UNORM:
+			case GL_COMPRESSED_SRGB_ALPHA_BPTC_UNORM: return 8;
+			}
+			return 32;
+		}
 
-		glTextureParameteri(m_RendererID, GL_TEXTURE_WRAP_S, GL_REPEAT);
-		glTextureParameteri(m_RendererID, GL_TEXTURE_WRAP_T, GL_REPEAT);
 	}
 
-	OpenGLTexture2D::OpenGLTexture2D(const std::string& path)
+	OpenGLTexture2D::OpenGLTexture2D(uint32_t width, uint32_t height)
+	{
+		DY_PROFILE_FUNCTION();
+
+		Allocate(width, height, GL_RGBA8, GL_RGBA);
+	}
+
+	OpenGLTexture2D::OpenGLTexture2D(const std::string& path, bool loadImmediately)
 		: m_Path(path)
 	{
 		DY_PROFILE_FUNCTION();
 
+		if (!loadImmediately)
+			return;
+
+		if (CompressedImage::IsCompressedFile(path))
+		{
+			CompressedImage image;
+			bool loaded = CompressedImage::Load(path, image);
+			DY_CORE_ASSERT(loaded, "Failed to load compressed image!");
+			if (loaded)
+				Upload(image);
+			return;
+		}
+
 		int width, height, channels;
 		stbi_set_flip_vertically_on_load(1);
 		stbi_uc* data = nullptr;
@@ -36,8 +91,6 @@ namespace Dymatic {
 			data = stbi_load(path.c_str(), &width, &height, &channels, 0);
 		}
 		DY_CORE_ASSERT(data, "Failed to load image!");
-		m_Width = width;
-		m_Height = height;
 
 		GLenum internalFormat = 0, dataFormat = 0;
 		if (channels == 4)
@@ -51,39 +104,93 @@ namespace Dymatic {
 			dataFormat = GL_RGB;
 		}
 
+		DY_CORE_ASSERT(internalFormat & dataFormat, "Format not supported!");
+
+		Allocate(width, height, internalFormat, dataFormat, 0);
+
+		glTextureSubImage2D(m_RendererID, 0, 0, 0, m_Width, m_Height, dataFormat, GL_UNSIGNED_BYTE, data);
+		glGenerateTextureMipmap(m_RendererID);
+
+		stbi_image_free(data);
+	}
+
+	OpenGLTexture2D::~OpenGLTexture2D()
+	{
+		DY_PROFILE_FUNCTION();
+
+		glDeleteTextures(1, &m_RendererID);
+	}
+
+	void OpenGLTexture2D::Allocate(uint32_t width, uint32_t height, GLenum internalFormat, GLenum dataFormat, uint32_t mipLevels)
+	{
+		m_Width = width;
+		m_Height = height;
 		m_InternalFormat = internalFormat;
 		m_DataFormat = dataFormat;
-
-		DY_CORE_ASSERT(internalFormat & dataFormat, "Format not supported!");
+		m_MipLevels = mipLevels ? mipLevels : Utils::CalculateMipCount(width, height);
 
 		glCreateTextures(GL_TEXTURE_2D, 1, &m_RendererID);
-		glTextureStorage2D(m_RendererID, 1, internalFormat, m_Width, m_Height);
+		glTextureStorage2D(m_RendererID, m_MipLevels, m_InternalFormat, m_Width, m_Height);
 
-		glTextureParameteri(m_RendererID, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+		glTextureParameteri(m_RendererID, GL_TEXTURE_MIN_FILTER, m_MipLevels > 1 ? GL_LINEAR_MIPMAP_LINEAR : GL_LINEAR);
 		glTextureParameteri(m_RendererID, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
 
 		glTextureParameteri(m_RendererID, GL_TEXTURE_WRAP_S, GL_REPEAT);
 		glTextureParameteri(m_RendererID, GL_TEXTURE_WRAP_T, GL_REPEAT);
 
-		glTextureSubImage2D(m_RendererID, 0, 0, 0, m_Width, m_Height, dataFormat, GL_UNSIGNED_BYTE, data);
-
-		stbi_image_free(data);
+		m_IsLoaded = true;
 	}
 
-	OpenGLTexture2D::~OpenGLTexture2D()
+	void OpenGLTexture2D::Upload(const CompressedImage& image)
 	{
 		DY_PROFILE_FUNCTION();
 
-		glDeleteTextures(1, &m_RendererID);
+		GLenum internalFormat = Utils::CompressedFormatToGL(image.Format, image.SRGB);
+		Allocate(image.Width, image.Height, internalFormat, 0, (uint32_t)image.Levels.size());
+		m_Compressed = true;
+
+		for (uint32_t level = 0; level < image.Levels.size(); level++)
+		{
+			const auto& info = image.Levels[level];
+			glCompressedTextureSubImage2D(m_RendererID, level, 0, 0, info.Width, info.Height, internalFormat, (GLsizei)info.Size, image.GetLevelData(level));
+		}
+	}
+
+	uint64_t OpenGLTexture2D::GetMemorySize() const
+	{
+		uint64_t size = 0;
+		for (uint32_t level = 0; level < m_MipLevels; level++)
+		{
+			uint64_t width = std::max(m_Width >> level, 1u), height = std::max(m_Height >> level, 1u);
+			if (m_Compressed)
+				width = (width + 3) & ~3ull, height = (height + 3) & ~3ull;
+			size += width * height * Utils::BitsPerPixel(m_InternalFormat) / 8;
+		}
+		return size;
 	}
 
 	void OpenGLTexture2D::SetData(void* data, uint32_t size)
 	{
 		DY_PROFILE_FUNCTION();
 
+		DY_CORE_ASSERT(!m_Compressed, "Compressed textures can not be written to!");
+
 		uint32_t bpp = m_DataFormat == GL_RGBA ? 4 : 3;
 		DY_CORE_ASSERT(size == m_Width * m_Height * bpp, "Data must be entire texture!");
 		glTextureSubImage2D(m_RendererID, 0, 0, 0, m_Width, m_Height, m_DataFormat, GL_UNSIGNED_BYTE, data);
+		if (m_MipLevels > 1)
+			glGenerateTextureMipmap(m_RendererID);
+	}
+
+	void OpenGLTexture2D::SetSubData(void* data, uint32_t x, uint32_t y, uint32_t width, uint32_t height)
+	{
+		DY_PROFILE_FUNCTION();
+
+		DY_CORE_ASSERT(!m_Compressed, "Compressed textures can not be written to!");
+		DY_CORE_ASSERT(x + width <= m_Width && y + height <= m_Height, "Region must lie inside the texture!");
+		glTextureSubImage2D(m_RendererID, 0, x, y, width, height, m_DataFormat, GL_UNSIGNED_BYTE, data);
+		if (m_MipLevels > 1)
+			glGenerateTextureMipmap(m_RendererID);
 	}
 
 	void OpenGLTexture2D::Bind(uint32_t slot) const
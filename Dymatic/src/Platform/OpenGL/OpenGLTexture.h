@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Dymatic/Renderer/Texture.h"
+#include "Dymatic/Renderer/CompressedImage.h"
 
 #include <glad/glad.h>
 
@@ -10,7 +11,8 @@ namespace Dymatic {
 	{
 	public:
 		OpenGLTexture2D(uint32_t width, uint32_t height);
-		OpenGLTexture2D(const std::string& path);
+		// With loadImmediately = false no storage is created, OpenGLTextureLoader uploads the image later
+		OpenGLTexture2D(const std::string& path, bool loadImmediately = true);
 		virtual ~OpenGLTexture2D();
 
 		virtual uint32_t GetWidth() const override { return m_Width; }
@@ -18,18 +20,32 @@ namespace Dymatic {
 		virtual uint32_t GetRendererID() const override { return m_RendererID; }
 
 		virtual void SetData(void* data, uint32_t size) override;
+		virtual void SetSubData(void* data, uint32_t x, uint32_t y, uint32_t width, uint32_t height) override;
 
 		virtual void Bind(uint32_t slot = 0) const override;
 
+		virtual bool IsLoaded() const override { return m_IsLoaded; }
+		virtual uint32_t GetMipLevelCount() const override { return m_MipLevels; }
+		virtual uint64_t GetMemorySize() const override;
+
 		virtual bool operator == (const Texture& other) const override
 		{
 			return m_RendererID == ((OpenGLTexture2D&)other).m_RendererID;
 		}
+	private:
+		// mipLevels = 0 allocates the full mip chain
+		void Allocate(uint32_t width, uint32_t height, GLenum internalFormat, GLenum dataFormat, uint32_t mipLevels = 1);
+		void Upload(const CompressedImage& image);
 	private:
 		std::string m_Path;
-		uint32_t m_Width, m_Height;
-		uint32_t m_RendererID;
-		GLenum m_InternalFormat, m_DataFormat;
+		bool m_IsLoaded = false;
+		uint32_t m_Width = 0, m_Height = 0;
+		uint32_t m_RendererID = 0;
+		GLenum m_InternalFormat = 0, m_DataFormat = 0;
+		uint32_t m_MipLevels = 1;
+		bool m_Compressed = false;
+
+		friend class OpenGLTextureLoader;
 	};
 
-}
\ No newline at end of file
+}
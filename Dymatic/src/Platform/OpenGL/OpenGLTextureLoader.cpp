@@ -0,0 +1,293 @@
+#include "dypch.h"
+#include "Platform/OpenGL/OpenGLTextureLoader.h"
+
+#include "Platform/OpenGL/OpenGLTexture.h"
+#include "Dymatic/Core/JobSystem.h"
+
+#include <stb_image.h>
+#include <glad/glad.h>
+
+#include <atomic>
+#include <mutex>
+#include <deque>
+
+namespace Dymatic {
+
+	struct DecodedImage
+	{
+		Ref<OpenGLTexture2D> Texture;
+		Texture2D::LoadedCallbackFn OnLoaded;
+
+		stbi_uc* Pixels = nullptr;
+		uint32_t Width = 0, Height = 0;
+
+		// Set instead of Pixels for .dds/.ktx2 files
+		Scope<CompressedImage> Compressed;
+	};
+
+	struct StagingRegion
+	{
+		uint32_t Offset = 0, Size = 0;
+		GLsync Fence = nullptr;
+	};
+
+	struct OpenGLTextureLoaderData
+	{
+		static const uint32_t StagingBufferSize = 64 * 1024 * 1024;
+		static const uint32_t MaxUploadBytesPerFrame = 16 * 1024 * 1024;
+
+		// Filled by workers, drained by the render thread
+		std::mutex DecodedMutex;
+		std::vector<DecodedImage> Decoded;
+
+		// Render thread only
+		std::deque<DecodedImage> UploadQueue;
+		std::deque<StagingRegion> InFlight;
+
+		uint32_t StagingBuffer = 0;
+		uint8_t* StagingBufferPtr = nullptr;
+		uint32_t StagingHead = 0;
+
+		std::atomic<uint32_t> PendingCount = 0;
+	};
+
+	static OpenGLTextureLoaderData* s_LoaderData = nullptr;
+
+	static void RetireStagingRegions()
+	{
+		auto& inFlight = s_LoaderData->InFlight;
+		while (!inFlight.empty())
+		{
+			GLenum status = glClientWaitSync(inFlight.front().Fence, 0, 0);
+			if (status != GL_ALREADY_SIGNALED && status != GL_CONDITION_SATISFIED)
+				break;
+
+			glDeleteSync(inFlight.front().Fence);
+			inFlight.pop_front();
+		}
+
+		if (inFlight.empty())
+			s_LoaderData->StagingHead = 0;
+	}
+
+	// Ring allocation in the staging buffer, fails instead of waiting on the GPU when full
+	static bool AllocateStaging(uint32_t size, uint32_t& outOffset)
+	{
+		auto& data = *s_LoaderData;
+		const uint32_t capacity = OpenGLTextureLoaderData::StagingBufferSize;
+
+		if (data.InFlight.empty())
+		{
+			if (size > capacity)
+				return false;
+			outOffset = 0;
+			return true;
+		}
+
+		uint32_t tail = data.InFlight.front().Offset;
+		if (data.StagingHead >= tail)
+		{
+			if (data.StagingHead + size <= capacity)
+			{
+				outOffset = data.StagingHead;
+				return true;
+			}
+			if (size < tail)
+			{
+				outOffset = 0;
+				return true;
+			}
+			return false;
+		}
+
+		if (data.StagingHead + size < tail)
+		{
+			outOffset = data.StagingHead;
+			return true;
+		}
+		return false;
+	}
+
+	static void FinishLoad(DecodedImage& image)
+	{
+		stbi_image_free(image.Pixels);
+		image.Pixels = nullptr;
+
+		s_LoaderData->PendingCount--;
+
+		if (image.OnLoaded)
+			image.OnLoaded(image.Texture);
+	}
+
+	void OpenGLTextureLoader::Init()
+	{
+		DY_PROFILE_FUNCTION();
+
+		s_LoaderData = new OpenGLTextureLoaderData();
+
+		const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+		glCreateBuffers(1, &s_LoaderData->StagingBuffer);
+		glNamedBufferStorage(s_LoaderData->StagingBuffer, OpenGLTextureLoaderData::StagingBufferSize, nullptr, flags);
+		s_LoaderData->StagingBufferPtr = (uint8_t*)glMapNamedBufferRange(s_LoaderData->StagingBuffer, 0, OpenGLTextureLoaderData::StagingBufferSize, flags);
+	}
+
+	void OpenGLTextureLoader::Shutdown()
+	{
+		DY_PROFILE_FUNCTION();
+
+		if (!s_LoaderData)
+			return;
+
+		{
+			std::lock_guard lock(s_LoaderData->DecodedMutex);
+			for (auto& image : s_LoaderData->Decoded)
+				stbi_image_free(image.Pixels);
+		}
+		for (auto& image : s_LoaderData->UploadQueue)
+			stbi_image_free(image.Pixels);
+		for (auto& region : s_LoaderData->InFlight)
+			glDeleteSync(region.Fence);
+
+		glUnmapNamedBuffer(s_LoaderData->StagingBuffer);
+		glDeleteBuffers(1, &s_LoaderData->StagingBuffer);
+
+		delete s_LoaderData;
+		s_LoaderData = nullptr;
+	}
+
+	Ref<Texture2D> OpenGLTextureLoader::Load(const std::string& path, const Texture2D::LoadedCallbackFn& onLoaded)
+	{
+		DY_PROFILE_FUNCTION();
+
+		DY_CORE_ASSERT(s_LoaderData, "OpenGLTextureLoader not initialized!");
+
+		Ref<OpenGLTexture2D> texture = CreateRef<OpenGLTexture2D>(path, false);
+		s_LoaderData->PendingCount++;
+
+		JobSystem::Submit([texture, onLoaded, path]()
+		{
+			DY_PROFILE_SCOPE("stbi_load - OpenGLTextureLoader::Load");
+
+			DecodedImage image;
+			image.Texture = texture;
+			image.OnLoaded = onLoaded;
+
+			if (CompressedImage::IsCompressedFile(path))
+			{
+				image.Compressed = CreateScope<CompressedImage>();
+				if (!CompressedImage::Load(path, *image.Compressed))
+					image.Compressed = nullptr;
+			}
+			else
+			{
+				// Always expand to RGBA so every staging offset stays 4-byte aligned
+				int width, height, channels;
+				stbi_set_flip_vertically_on_load_thread(1);
+				image.Pixels = stbi_load(path.c_str(), &width, &height, &channels, 4);
+				if (image.Pixels)
+				{
+					image.Width = width;
+					image.Height = height;
+				}
+				else
+				{
+					DY_CORE_ERROR("Failed to load image '{0}'", path);
+				}
+			}
+
+			if (!s_LoaderData)
+			{
+				stbi_image_free(image.Pixels);
+				return;
+			}
+
+			std::lock_guard lock(s_LoaderData->DecodedMutex);
+			s_LoaderData->Decoded.push_back(std::move(image));
+		});
+
+		return texture;
+	}
+
+	void OpenGLTextureLoader::ProcessUploads()
+	{
+		DY_PROFILE_FUNCTION();
+
+		if (!s_LoaderData)
+			return;
+
+		auto& data = *s_LoaderData;
+		{
+			std::lock_guard lock(data.DecodedMutex);
+			for (auto& image : data.Decoded)
+				data.UploadQueue.push_back(std::move(image));
+			data.Decoded.clear();
+		}
+
+		if (data.UploadQueue.empty())
+			return;
+
+		RetireStagingRegions();
+
+		uint32_t uploadedBytes = 0;
+		while (!data.UploadQueue.empty() && uploadedBytes < OpenGLTextureLoaderData::MaxUploadBytesPerFrame)
+		{
+			DecodedImage& image = data.UploadQueue.front();
+			if (image.Compressed)
+			{
+				// Block compressed data is small, it is uploaded straight from client memory
+				image.Texture->Upload(*image.Compressed);
+				uploadedBytes += (uint32_t)image.Compressed->Data.size();
+
+				FinishLoad(image);
+				data.UploadQueue.pop_front();
+				continue;
+			}
+
+			if (!image.Pixels)
+			{
+				// Decoding failed, the texture stays a placeholder
+				FinishLoad(image);
+				data.UploadQueue.pop_front();
+				continue;
+			}
+
+			uint32_t size = image.Width * image.Height * 4;
+			uint32_t offset = 0;
+			bool staged = AllocateStaging(size, offset);
+			if (!staged && size <= OpenGLTextureLoaderData::StagingBufferSize)
+				break; // Staging buffer is busy, try again next frame
+
+			auto& texture = *image.Texture;
+			texture.Allocate(image.Width, image.Height, GL_RGBA8, GL_RGBA, 0);
+
+			if (staged)
+			{
+				memcpy(data.StagingBufferPtr + offset, image.Pixels, size);
+
+				glBindBuffer(GL_PIXEL_UNPACK_BUFFER, data.StagingBuffer);
+				glTextureSubImage2D(texture.m_RendererID, 0, 0, 0, image.Width, image.Height, GL_RGBA, GL_UNSIGNED_BYTE, (const void*)(uintptr_t)offset);
+				glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+
+				data.InFlight.push_back({ offset, size, glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0) });
+				data.StagingHead = offset + size;
+			}
+			else
+			{
+				// Larger than the whole staging buffer, upload directly from client memory
+				glTextureSubImage2D(texture.m_RendererID, 0, 0, 0, image.Width, image.Height, GL_RGBA, GL_UNSIGNED_BYTE, image.Pixels);
+			}
+
+			glGenerateTextureMipmap(texture.m_RendererID);
+			uploadedBytes += size;
+
+			FinishLoad(image);
+			data.UploadQueue.pop_front();
+		}
+	}
+
+	uint32_t OpenGLTextureLoader::GetPendingCount()
+	{
+		return s_LoaderData ? s_LoaderData->PendingCount.load() : 0;
+	}
+
+}
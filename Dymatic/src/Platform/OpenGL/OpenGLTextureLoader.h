@@ -0,0 +1,21 @@
+#pragma once
+
+#include "Dymatic/Renderer/Texture.h"
+
+namespace Dymatic {
+
+	// Asynchronous Texture2D loading: images are decoded on JobSystem workers and uploaded
+	// on the render thread through a persistently mapped pixel unpack buffer.
+	class OpenGLTextureLoader
+	{
+	public:
+		static void Init();
+		static void Shutdown();
+
+		static Ref<Texture2D> Load(const std::string& path, const Texture2D::LoadedCallbackFn& onLoaded);
+
+		static void ProcessUploads();
+		static uint32_t GetPendingCount();
+	};
+
+}
@@ -0,0 +1,115 @@
+#include "dypch.h"
+#include "Platform/OpenGL/OpenGLUniformLocationMap.h"
+
+namespace Dymatic {
+
+	static const uint32_t s_MinCapacity = 32;
+
+	OpenGLUniformLocationMap::OpenGLUniformLocationMap()
+	{
+		Rehash(s_MinCapacity);
+	}
+
+	bool OpenGLUniformLocationMap::Insert(std::string_view name, int location)
+	{
+		// Keep the load factor at or below one half so probe sequences stay short
+		if ((m_Size + 1) * 2 > (uint32_t)m_Entries.size())
+			Rehash((uint32_t)m_Entries.size() * 2);
+
+		uint64_t hash = Hash(name);
+		for (uint32_t slot = GetHomeSlot(hash);; slot = (slot + 1) & m_Mask)
+		{
+			Entry& entry = m_Entries[slot];
+			if (entry.Hash == hash && std::string_view(m_Names).substr(entry.NameOffset, entry.NameLength) == name)
+			{
+				entry.Location = location;
+				return false;
+			}
+
+			if (entry.Hash == 0)
+			{
+				entry.Hash = hash;
+				entry.NameOffset = (uint32_t)m_Names.size();
+				entry.NameLength = (uint32_t)name.size();
+				entry.Location = location;
+				m_Names.append(name);
+				m_Size++;
+				return true;
+			}
+		}
+	}
+
+	int OpenGLUniformLocationMap::Find(std::string_view name) const
+	{
+		uint64_t hash = Hash(name);
+		for (uint32_t slot = GetHomeSlot(hash);; slot = (slot + 1) & m_Mask)
+		{
+			const Entry& entry = m_Entries[slot];
+			if (entry.Hash == hash && std::string_view(m_Names).substr(entry.NameOffset, entry.NameLength) == name)
+				return entry.Location;
+			if (entry.Hash == 0)
+				return -1;
+		}
+	}
+
+	void OpenGLUniformLocationMap::Reserve(uint32_t count)
+	{
+		uint32_t capacity = (uint32_t)m_Entries.size();
+		while (count * 2 > capacity)
+			capacity *= 2;
+
+		if (capacity != m_Entries.size())
+			Rehash(capacity);
+	}
+
+	void OpenGLUniformLocationMap::Clear()
+	{
+		m_Entries.assign(m_Entries.size(), Entry());
+		m_Names.clear();
+		m_Size = 0;
+	}
+
+	uint64_t OpenGLUniformLocationMap::Hash(std::string_view name)
+	{
+		// FNV-1a, uniform names are short so a byte at a time is fine
+		uint64_t hash = 0xCBF29CE484222325ull;
+		for (char c : name)
+		{
+			hash ^= (uint8_t)c;
+			hash *= 0x100000001B3ull;
+		}
+		return hash != 0 ? hash : 1;
+	}
+
+	uint32_t OpenGLUniformLocationMap::GetHomeSlot(uint64_t hash) const
+	{
+		// Fibonacci hashing, the slot comes from the top bits of the product so every bit of the hash counts
+		return (uint32_t)((hash * 0x9E3779B97F4A7C15ull) >> m_Shift);
+	}
+
+	void OpenGLUniformLocationMap::Rehash(uint32_t capacity)
+	{
+		DY_CORE_ASSERT((capacity & (capacity - 1)) == 0, "Capacity must be a power of two!");
+
+		std::vector<Entry> entries(capacity);
+		std::swap(entries, m_Entries);
+
+		m_Mask = capacity - 1;
+		m_Shift = 64;
+		for (uint32_t size = capacity; size > 1; size >>= 1)
+			m_Shift--;
+
+		// The names stay where they are, only the slots move
+		for (const Entry& entry : entries)
+		{
+			if (entry.Hash == 0)
+				continue;
+
+			uint32_t slot = GetHomeSlot(entry.Hash);
+			while (m_Entries[slot].Hash != 0)
+				slot = (slot + 1) & m_Mask;
+			m_Entries[slot] = entry;
+		}
+	}
+
+}
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace Dymatic {
+
+	// Open addressing hash map from uniform name to location with linear probing over one flat
+	// array, like EntityIDMap. The names are packed into a single string, so a lookup touches two
+	// contiguous buffers and compares names only when their full hash matches. Filled once per
+	// linked program, so there is no erase.
+	class OpenGLUniformLocationMap
+	{
+	public:
+		OpenGLUniformLocationMap();
+
+		// Returns false and updates the location if the name was already present
+		bool Insert(std::string_view name, int location);
+		// -1 when the name is not present, which glUniform* ignores
+		int Find(std::string_view name) const;
+
+		void Reserve(uint32_t count);
+		void Clear();
+
+		uint32_t GetSize() const { return m_Size; }
+	private:
+		static uint64_t Hash(std::string_view name);
+		uint32_t GetHomeSlot(uint64_t hash) const;
+		void Rehash(uint32_t capacity);
+	private:
+		// Hash 0 marks an empty slot, Hash() never returns it
+		struct Entry
+		{
+			uint64_t Hash = 0;
+			uint32_t NameOffset = 0;
+			uint32_t NameLength = 0;
+			int Location = -1;
+		};
+
+		std::vector<Entry> m_Entries;
+		std::string m_Names;
+		uint32_t m_Size = 0;
+		uint32_t m_Mask = 0;
+		uint32_t m_Shift = 0;
+	};
+
+}
@@ -50,4 +50,18 @@ namespace Dymatic {
 		return std::nullopt;
 	}
 
+	double Time::GetTime()
+	{
+		static const double s_Period = []()
+		{
+			LARGE_INTEGER frequency;
+			QueryPerformanceFrequency(&frequency);
+			return 1.0 / (double)frequency.QuadPart;
+		}();
+
+		LARGE_INTEGER counter;
+		QueryPerformanceCounter(&counter);
+		return (double)counter.QuadPart * s_Period;
+	}
+
 }
\ No newline at end of file
@@ -75,15 +75,20 @@ namespace Dymatic {
 			data.Width = width;
 			data.Height = height;
 
-			WindowResizeEvent event(width, height);
-			data.EventCallback(event);
+			data.Queue->Push(WindowResizeEvent(width, height));
 		});
 
 		glfwSetWindowCloseCallback(m_Window, [](GLFWwindow* window)
 		{
 			WindowData& data = *(WindowData*)glfwGetWindowUserPointer(window);
-			WindowCloseEvent event;
-			data.EventCallback(event);
+			data.Queue->Push(WindowCloseEvent());
+		});
+
+		glfwSetWindowFocusCallback(m_Window, [](GLFWwindow* window, int focused)
+		{
+			WindowData& data = *(WindowData*)glfwGetWindowUserPointer(window);
+			if (!focused)
+				data.Queue->Push(WindowLostFocusEvent());
 		});
 
 		glfwSetKeyCallback(m_Window, [](GLFWwindow* window, int key, int scancode, int action, int mods)
@@ -94,20 +99,17 @@ namespace Dymatic {
 			{
 			case GLFW_PRESS:
 			{
-				KeyPressedEvent event(key, 0);
-				data.EventCallback(event);
+				data.Queue->Push(KeyPressedEvent(key, 0));
 				break;
 			}
 			case GLFW_RELEASE:
 			{
-				KeyReleasedEvent event(key);
-				data.EventCallback(event);
+				data.Queue->Push(KeyReleasedEvent(key));
 				break;
 			}
 			case GLFW_REPEAT:
 			{
-				KeyPressedEvent event(key, 1);
-				data.EventCallback(event);
+				data.Queue->Push(KeyPressedEvent(key, 1));
 				break;
 			}
 			}
@@ -117,8 +119,7 @@ namespace Dymatic {
 		{
 			WindowData& data = *(WindowData*)glfwGetWindowUserPointer(window);
 
-			KeyTypedEvent event(keycode);
-			data.EventCallback(event);
+			data.Queue->Push(KeyTypedEvent(keycode));
 		});
 
 		glfwSetMouseButtonCallback(m_Window, [](GLFWwindow* window, int button, int action, int mods)
@@ -129,14 +130,12 @@ namespace Dymatic {
 			{
 			case GLFW_PRESS:
 			{
-				MouseButtonPressedEvent event(button);
-				data.EventCallback(event);
+				data.Queue->Push(MouseButtonPressedEvent(button));
 				break;
 			}
 			case GLFW_RELEASE:
 			{
-				MouseButtonReleasedEvent event(button);
-				data.EventCallback(event);
+				data.Queue->Push(MouseButtonReleasedEvent(button));
 				break;
 			}
 			}
@@ -146,16 +145,14 @@ namespace Dymatic {
 		{
 			WindowData& data = *(WindowData*)glfwGetWindowUserPointer(window);
 
-			MouseScrolledEvent event((float)xOffset, (float)yOffset);
-			data.EventCallback(event);
+			data.Queue->Push(MouseScrolledEvent((float)xOffset, (float)yOffset));
 		});
 
 		glfwSetCursorPosCallback(m_Window, [](GLFWwindow* window, double xPos, double yPos)
 		{
 			WindowData& data = *(WindowData*)glfwGetWindowUserPointer(window);
 
-			MouseMovedEvent event((float)xPos, (float)yPos);
-			data.EventCallback(event);
+			data.Queue->Push(MouseMovedEvent((float)xPos, (float)yPos));
 		});
 	}
 
@@ -180,6 +177,13 @@ namespace Dymatic {
 		m_Context->SwapBuffers();
 	}
 
+	void WindowsWindow::WaitEvents(double timeout)
+	{
+		DY_PROFILE_FUNCTION();
+
+		glfwWaitEventsTimeout(timeout);
+	}
+
 	void WindowsWindow::SetVSync(bool enabled)
 	{
 		DY_PROFILE_FUNCTION();
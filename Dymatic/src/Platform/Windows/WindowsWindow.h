@@ -14,12 +14,13 @@ namespace Dymatic {
 		virtual ~WindowsWindow();
 
 		void OnUpdate() override;
+		void WaitEvents(double timeout) override;
 
 		unsigned int GetWidth() const override { return m_Data.Width; }
 		unsigned int GetHeight() const override { return m_Data.Height; }
 
 		// Window attributes
-		void SetEventCallback(const EventCallbackFn& callback) override { m_Data.EventCallback = callback; }
+		void SetEventQueue(EventQueue* queue) override { m_Data.Queue = queue; }
 		void SetVSync(bool enabled) override;
 		bool IsVSync() const override;
 
@@ -37,7 +38,7 @@ namespace Dymatic {
 			unsigned int Width, Height;
 			bool VSync;
 
-			EventCallbackFn EventCallback;
+			EventQueue* Queue = nullptr;
 		};
 
 		WindowData m_Data;
@@ -0,0 +1,83 @@
+#include "CommandHistory.h"
+
+namespace Dymatic {
+
+	void CommandHistory::Push(Scope<EditorCommand> command, bool mergeable)
+	{
+		m_ChangeCount++;
+
+		// Whatever was undone can't be redone anymore
+		while (m_Commands.size() > m_Position)
+		{
+			m_MemoryUsage -= m_Commands.back()->GetMemoryUsage();
+			m_Commands.pop_back();
+		}
+
+		if (mergeable && m_MergeOpen && !m_Commands.empty())
+		{
+			EditorCommand& last = *m_Commands.back();
+			size_t lastUsage = last.GetMemoryUsage();
+			if (last.MergeWith(*command))
+			{
+				m_MemoryUsage = m_MemoryUsage - lastUsage + last.GetMemoryUsage();
+				EnforceBudget();
+				return;
+			}
+		}
+
+		m_MemoryUsage += command->GetMemoryUsage();
+		m_Commands.push_back(std::move(command));
+		m_Position = m_Commands.size();
+		m_MergeOpen = mergeable;
+
+		EnforceBudget();
+	}
+
+	bool CommandHistory::Undo()
+	{
+		if (!CanUndo())
+			return false;
+
+		m_MergeOpen = false;
+		m_ChangeCount++;
+		m_Commands[--m_Position]->Undo();
+		return true;
+	}
+
+	bool CommandHistory::Redo()
+	{
+		if (!CanRedo())
+			return false;
+
+		m_MergeOpen = false;
+		m_ChangeCount++;
+		m_Commands[m_Position++]->Execute();
+		return true;
+	}
+
+	void CommandHistory::Clear()
+	{
+		m_Commands.clear();
+		m_Position = 0;
+		m_MemoryUsage = 0;
+		m_MergeOpen = false;
+	}
+
+	void CommandHistory::SetMemoryBudget(size_t bytes)
+	{
+		m_MemoryBudget = bytes;
+		EnforceBudget();
+	}
+
+	void CommandHistory::EnforceBudget()
+	{
+		// Only applied commands are dropped and the newest command is always kept
+		while (m_MemoryUsage > m_MemoryBudget && m_Position > 0 && m_Commands.size() > 1)
+		{
+			m_MemoryUsage -= m_Commands.front()->GetMemoryUsage();
+			m_Commands.pop_front();
+			m_Position--;
+		}
+	}
+
+}
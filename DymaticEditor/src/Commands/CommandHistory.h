@@ -0,0 +1,44 @@
+#pragma once
+
+#include "EditorCommand.h"
+
+#include <deque>
+
+namespace Dymatic {
+
+	// Linear undo stack, undo and redo only move an index. Pushing a command discards everything
+	// that was undone, and the oldest commands are dropped once the budget is exceeded.
+	class CommandHistory
+	{
+	public:
+		// Mergeable commands fold into the previous command until EndMerge is called,
+		// so a whole drag becomes one undo step
+		void Push(Scope<EditorCommand> command, bool mergeable = false);
+		void EndMerge() { m_MergeOpen = false; }
+
+		bool Undo();
+		bool Redo();
+		bool CanUndo() const { return m_Position > 0; }
+		bool CanRedo() const { return m_Position < m_Commands.size(); }
+
+		void Clear();
+
+		void SetMemoryBudget(size_t bytes);
+		size_t GetMemoryBudget() const { return m_MemoryBudget; }
+		size_t GetMemoryUsage() const { return m_MemoryUsage; }
+		size_t GetCommandCount() const { return m_Commands.size(); }
+		// Counts pushes, undos and redos, every one of them changed the scene
+		uint64_t GetChangeCount() const { return m_ChangeCount; }
+	private:
+		void EnforceBudget();
+	private:
+		std::deque<Scope<EditorCommand>> m_Commands;
+		size_t m_Position = 0; // Commands before this index are applied
+
+		size_t m_MemoryUsage = 0;
+		size_t m_MemoryBudget = 16 * 1024 * 1024;
+		bool m_MergeOpen = false;
+		uint64_t m_ChangeCount = 0;
+	};
+
+}
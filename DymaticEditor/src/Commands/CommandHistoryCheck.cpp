@@ -0,0 +1,120 @@
+#include "CommandHistoryCheck.h"
+#include "EntityCommand.h"
+
+namespace Dymatic {
+
+	namespace Utils {
+
+		static bool TransformsEqual(const TransformComponent& a, const TransformComponent& b)
+		{
+			return a.Translation == b.Translation && a.Rotation == b.Rotation && a.Scale == b.Scale;
+		}
+
+	}
+
+	CommandHistoryCheck::Result CommandHistoryCheck::Run()
+	{
+		Result result;
+		auto check = [&result](bool passed, const char* what)
+		{
+			result.Checks++;
+			if (!passed)
+			{
+				result.Failures++;
+				DY_ERROR("Undo/redo check failed: {0}", what);
+			}
+		};
+
+		Ref<Scene> scene = CreateRef<Scene>();
+		CommandHistory history;
+
+		// A gizmo drag pushes one mergeable command per frame, like EditorLayer::OnImGuiRender
+		Entity dragged = scene->CreateEntity("Dragged");
+		TransformComponent& tc = dragged.GetComponent<TransformComponent>();
+		TransformComponent dragStart = tc;
+		for (int frame = 0; frame < 100; frame++)
+		{
+			TransformComponent before = tc;
+			tc.Translation += glm::vec3{ 0.01f, 0.02f, 0.0f };
+			tc.Rotation.z += 0.01f;
+			history.Push(CreateScope<ComponentCommand<TransformComponent>>(scene, dragged.GetUUID(), &before, &tc), true);
+		}
+		history.EndMerge();
+		TransformComponent dragEnd = tc;
+
+		check(history.GetCommandCount() == 1, "drag did not merge into one command");
+		check(history.Undo() && Utils::TransformsEqual(dragged.GetComponent<TransformComponent>(), dragStart), "undoing the drag did not restore its start");
+		check(history.Redo() && Utils::TransformsEqual(dragged.GetComponent<TransformComponent>(), dragEnd), "redoing the drag did not restore its end");
+
+		// Editing a shared component of a prefab instance overrides it first, then the following
+		// frames of the edit merge in, like DrawComponent in SceneHierarchyPanel
+		const glm::vec4 prefabColor = { 1.0f, 0.0f, 0.0f, 1.0f };
+		const glm::vec4 overrideColor = { 0.0f, 0.0f, 1.0f, 1.0f };
+
+		Entity source = scene->CreateEntity("Source");
+		source.AddComponent<SpriteRendererComponent>(prefabColor);
+		Ref<Prefab> prefab = Prefab::Create(source);
+		Entity instance = scene->InstantiatePrefab(prefab);
+		check(!instance.HasComponent<SpriteRendererComponent>(), "prefab instance does not share its sprite");
+
+		SpriteRendererComponent component = instance.GetEffectiveComponent<SpriteRendererComponent>();
+		component.Color = { 0.0f, 1.0f, 0.0f, 1.0f };
+		instance.OverrideComponent<SpriteRendererComponent>() = component;
+		history.Push(CreateScope<ComponentCommand<SpriteRendererComponent>>(scene, instance.GetUUID(), nullptr, &instance.GetComponent<SpriteRendererComponent>()), true);
+
+		SpriteRendererComponent& sprite = instance.GetComponent<SpriteRendererComponent>();
+		SpriteRendererComponent before = sprite;
+		sprite.Color = overrideColor;
+		history.Push(CreateScope<ComponentCommand<SpriteRendererComponent>>(scene, instance.GetUUID(), &before, &sprite), true);
+		history.EndMerge();
+
+		check(history.GetCommandCount() == 2, "override did not merge into one command");
+		check(history.Undo() && !instance.HasComponent<SpriteRendererComponent>(), "undoing the override did not remove it");
+		check(instance.GetEffectiveComponent<SpriteRendererComponent>().Color == prefabColor, "instance did not revert to the prefab's sprite");
+		check(history.Redo() && instance.HasComponent<SpriteRendererComponent>(), "redoing the override did not add it back");
+		check(instance.GetEffectiveComponent<SpriteRendererComponent>().Color == overrideColor, "redoing the override did not restore its last edit");
+
+		// Both steps in a row, back to where the scene started and forward again
+		check(history.Undo() && history.Undo() && !history.CanUndo(), "could not undo both commands");
+		check(Utils::TransformsEqual(dragged.GetComponent<TransformComponent>(), dragStart) && !instance.HasComponent<SpriteRendererComponent>(), "undoing both commands did not restore the scene");
+		check(history.Redo() && history.Redo() && !history.CanRedo(), "could not redo both commands");
+		check(Utils::TransformsEqual(dragged.GetComponent<TransformComponent>(), dragEnd) && instance.GetEffectiveComponent<SpriteRendererComponent>().Color == overrideColor, "redoing both commands did not restore the scene");
+
+		// Deleting an entity and turning one into a prefab record EntityCommands, like the context
+		// menu in SceneHierarchyPanel. Undoing them brings the entities back under their UUIDs, so
+		// commands recorded for them earlier still apply.
+		UUID draggedID = dragged.GetUUID(), sourceID = source.GetUUID();
+		{
+			EntitySnapshot before(dragged);
+			scene->DestroyEntity(dragged);
+			history.Push(CreateScope<EntityCommand>(scene, &before, nullptr));
+		}
+		{
+			Ref<Prefab> sourcePrefab = Prefab::Create(source);
+			EntitySnapshot before(source);
+			TransformComponent transform = source.GetComponent<TransformComponent>();
+			scene->DestroyEntity(source);
+
+			Entity replacement = scene->InstantiatePrefabWithUUID(sourcePrefab, sourceID);
+			replacement.GetComponent<TransformComponent>() = transform;
+			EntitySnapshot after(replacement);
+			history.Push(CreateScope<EntityCommand>(scene, &before, &after));
+		}
+		check(!scene->GetEntityByUUID(draggedID) && scene->GetEntityByUUID(sourceID).HasComponent<PrefabInstanceComponent>(), "entity commands were not applied");
+
+		check(history.Undo() && history.Undo(), "could not undo the entity commands");
+		Entity restoredSource = scene->GetEntityByUUID(sourceID);
+		check(restoredSource && !restoredSource.HasComponent<PrefabInstanceComponent>() && restoredSource.GetComponent<SpriteRendererComponent>().Color == prefabColor, "undoing Create Prefab did not restore the entity");
+		Entity restoredDragged = scene->GetEntityByUUID(draggedID);
+		check(restoredDragged && restoredDragged.GetComponent<TagComponent>().Tag == "Dragged" && Utils::TransformsEqual(restoredDragged.GetComponent<TransformComponent>(), dragEnd), "undoing the delete did not restore the entity");
+		check(history.Undo() && history.Undo() && Utils::TransformsEqual(scene->GetEntityByUUID(draggedID).GetComponent<TransformComponent>(), dragStart), "the drag did not undo on the restored entity");
+
+		check(history.Redo() && history.Redo() && history.Redo() && history.Redo() && !history.CanRedo(), "could not redo every command");
+		check(!scene->GetEntityByUUID(draggedID) && scene->GetEntityByUUID(sourceID).HasComponent<PrefabInstanceComponent>(), "redoing the entity commands did not restore the scene");
+
+		if (result.Passed())
+			DY_INFO("Undo/redo check passed {0} checks", result.Checks);
+		return result;
+	}
+
+}
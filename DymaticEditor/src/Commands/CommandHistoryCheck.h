@@ -0,0 +1,25 @@
+#pragma once
+
+#include "CommandHistory.h"
+
+namespace Dymatic {
+
+	// Replays a gizmo drag of a TransformComponent, a prefab override, deleting an entity and
+	// turning one into a prefab through a CommandHistory on a scratch scene, the same way the
+	// editor records them. Checks that drags and overrides merge into one undo step, and that
+	// everything undoes and redoes exactly. Needs no window or GPU resources.
+	class CommandHistoryCheck
+	{
+	public:
+		struct Result
+		{
+			uint32_t Checks = 0;
+			uint32_t Failures = 0;
+
+			bool Passed() const { return Checks > 0 && Failures == 0; }
+		};
+
+		static Result Run();
+	};
+
+}
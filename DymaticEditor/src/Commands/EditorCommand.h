@@ -0,0 +1,204 @@
+#pragma once
+
+#include "Dymatic.h"
+
+#include <cstring>
+#include <type_traits>
+
+namespace Dymatic {
+
+	// An undoable edit. Commands are pushed to the CommandHistory after they have been applied.
+	class EditorCommand
+	{
+	public:
+		virtual ~EditorCommand() = default;
+
+		virtual void Execute() = 0;
+		virtual void Undo() = 0;
+
+		// Folds the command that was applied right after this one into it
+		virtual bool MergeWith(EditorCommand&) { return false; }
+
+		virtual size_t GetMemoryUsage() const = 0;
+	};
+
+	namespace Utils {
+
+		// Heap memory owned by a component that a command keeps a whole copy of
+		template<typename T>
+		inline size_t GetComponentHeapSize(const T&) { return 0; }
+
+		template<>
+		inline size_t GetComponentHeapSize<TagComponent>(const TagComponent& component) { return component.Tag.capacity(); }
+
+		// Runtime state is neither kept alive by the history nor rolled back by it
+		template<typename T>
+		inline void StripRuntimeState(T&) {}
+
+		template<>
+		inline void StripRuntimeState<ParticleEmitterComponent>(ParticleEmitterComponent& component) { component.System = nullptr; }
+
+		template<>
+		inline void StripRuntimeState<NativeScriptComponent>(NativeScriptComponent& component) { component.Instance = nullptr; }
+
+		template<typename T>
+		inline void AssignComponent(T& dst, const T& src) { dst = src; }
+
+		template<>
+		inline void AssignComponent<ParticleEmitterComponent>(ParticleEmitterComponent& dst, const ParticleEmitterComponent& src)
+		{
+			Ref<ParticleSystem> system = dst.System;
+			float emitRemainder = dst.EmitRemainder;
+			dst = src;
+			dst.System = system;
+			dst.EmitRemainder = emitRemainder;
+		}
+
+	}
+
+	// Adds, removes or changes one component of one entity, which is looked up by UUID so the
+	// command survives handles being reused. Changes to trivially copyable components only keep
+	// the bytes between the first and last that differ, everything else keeps whole copies.
+	template<typename T>
+	class ComponentCommand : public EditorCommand
+	{
+	public:
+		// A null before or after means the entity does not have the component at that point
+		ComponentCommand(const Ref<Scene>& scene, UUID entity, const T* before, const T* after)
+			: m_Scene(scene), m_Entity(entity)
+		{
+			if constexpr (std::is_trivially_copyable_v<T>)
+			{
+				if (before && after)
+				{
+					SetDelta(*before, *after);
+					return;
+				}
+			}
+
+			m_Before = CopyState(before);
+			m_After = CopyState(after);
+		}
+
+		virtual void Execute() override { Apply(m_After.get(), false); }
+		virtual void Undo() override { Apply(m_Before.get(), true); }
+
+		virtual bool MergeWith(EditorCommand& next) override
+		{
+			auto* other = dynamic_cast<ComponentCommand<T>*>(&next);
+			if (!other || other->m_Scene != m_Scene || (uint64_t)other->m_Entity != (uint64_t)m_Entity)
+				return false;
+
+			if constexpr (std::is_trivially_copyable_v<T>)
+			{
+				if (other->m_IsDelta)
+				{
+					if (m_IsDelta)
+					{
+						// The component now holds the state after both commands, rolling both back
+						// on a copy recovers the state before them
+						Entity entity = m_Scene->GetEntityByUUID(m_Entity);
+						if (!entity || !entity.HasComponent<T>())
+							return false;
+
+						const T& current = entity.GetComponent<T>();
+						T original = current;
+						other->PatchDelta(original, true);
+						PatchDelta(original, true);
+						SetDelta(original, current);
+						return true;
+					}
+
+					if (!m_After)
+						return false;
+
+					other->PatchDelta(*m_After, false);
+					return true;
+				}
+			}
+
+			if (m_IsDelta || other->m_IsDelta)
+				return false;
+
+			m_After = std::move(other->m_After);
+			return true;
+		}
+
+		virtual size_t GetMemoryUsage() const override
+		{
+			size_t size = sizeof(*this) + m_DeltaBytes.capacity();
+			if (m_Before)
+				size += sizeof(T) + Utils::GetComponentHeapSize(*m_Before);
+			if (m_After)
+				size += sizeof(T) + Utils::GetComponentHeapSize(*m_After);
+			return size;
+		}
+	private:
+		static Scope<T> CopyState(const T* state)
+		{
+			if (!state)
+				return nullptr;
+
+			Scope<T> copy = CreateScope<T>(*state);
+			Utils::StripRuntimeState(*copy);
+			return copy;
+		}
+
+		void SetDelta(const T& before, const T& after)
+		{
+			const uint8_t* oldBytes = reinterpret_cast<const uint8_t*>(&before);
+			const uint8_t* newBytes = reinterpret_cast<const uint8_t*>(&after);
+
+			uint32_t first = 0, last = sizeof(T);
+			while (first < last && oldBytes[first] == newBytes[first])
+				first++;
+			while (last > first && oldBytes[last - 1] == newBytes[last - 1])
+				last--;
+
+			// Old bytes followed by new bytes
+			m_IsDelta = true;
+			m_DeltaOffset = first;
+			m_DeltaBytes.assign(oldBytes + first, oldBytes + last);
+			m_DeltaBytes.insert(m_DeltaBytes.end(), newBytes + first, newBytes + last);
+			m_DeltaBytes.shrink_to_fit();
+		}
+
+		void PatchDelta(T& component, bool undo) const
+		{
+			size_t size = m_DeltaBytes.size() / 2;
+			std::memcpy(reinterpret_cast<uint8_t*>(&component) + m_DeltaOffset, m_DeltaBytes.data() + (undo ? 0 : size), size);
+		}
+
+		void Apply(const T* state, bool undo)
+		{
+			Entity entity = m_Scene->GetEntityByUUID(m_Entity);
+			if (!entity)
+				return;
+
+			if (m_IsDelta)
+			{
+				if (entity.HasComponent<T>())
+					entity.PatchComponent<T>([&](T& component) { PatchDelta(component, undo); });
+			}
+			else if (!state)
+			{
+				if (entity.HasComponent<T>())
+					entity.RemoveComponent<T>();
+			}
+			else if (entity.HasComponent<T>())
+				entity.PatchComponent<T>([&](T& component) { Utils::AssignComponent(component, *state); });
+			else
+				entity.AddComponent<T>(*state);
+		}
+	private:
+		Ref<Scene> m_Scene;
+		UUID m_Entity;
+
+		bool m_IsDelta = false;
+		uint32_t m_DeltaOffset = 0;
+		std::vector<uint8_t> m_DeltaBytes;
+
+		Scope<T> m_Before, m_After;
+	};
+
+}
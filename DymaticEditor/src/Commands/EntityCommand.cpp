@@ -0,0 +1,87 @@
+#include "EntityCommand.h"
+
+namespace Dymatic {
+
+	namespace Utils {
+
+		template<typename T>
+		static void CopyComponent(Entity entity, std::optional<T>& copy)
+		{
+			if (!entity.HasComponent<T>())
+				return;
+
+			copy = entity.GetComponent<T>();
+			StripRuntimeState(*copy);
+		}
+
+		// Also removes what the entity was created with but the snapshot does not have
+		template<typename T>
+		static void RestoreComponent(Entity entity, const std::optional<T>& copy)
+		{
+			if (!copy)
+			{
+				if (entity.HasComponent<T>())
+					entity.RemoveComponent<T>();
+			}
+			else if (entity.HasComponent<T>())
+				entity.GetComponent<T>() = *copy;
+			else
+				entity.AddComponent<T>(*copy);
+		}
+
+	}
+
+	EntitySnapshot::EntitySnapshot(Entity entity)
+		: m_ID(entity.GetUUID())
+	{
+		std::apply([&](auto&... copies) { (Utils::CopyComponent(entity, copies), ...); }, m_Components);
+	}
+
+	Entity EntitySnapshot::Restore(Scene& scene) const
+	{
+		const auto& prefabInstance = std::get<std::optional<PrefabInstanceComponent>>(m_Components);
+		Entity entity = prefabInstance ? scene.InstantiatePrefabWithUUID(prefabInstance->Source, m_ID) : scene.CreateEntityWithUUID(m_ID);
+
+		std::apply([&](const auto&... copies) { (Utils::RestoreComponent(entity, copies), ...); }, m_Components);
+		return entity;
+	}
+
+	size_t EntitySnapshot::GetMemoryUsage() const
+	{
+		size_t size = sizeof(*this);
+		std::apply([&](const auto&... copies) { ((size += copies ? Utils::GetComponentHeapSize(*copies) : 0), ...); }, m_Components);
+		return size;
+	}
+
+	EntityCommand::EntityCommand(const Ref<Scene>& scene, const EntitySnapshot* before, const EntitySnapshot* after)
+		: m_Scene(scene), m_Entity(before ? before->GetUUID() : after->GetUUID())
+	{
+		DY_CORE_ASSERT(before || after, "Entity command without a state!");
+		DY_CORE_ASSERT(!before || !after || (uint64_t)before->GetUUID() == (uint64_t)after->GetUUID(), "Entity command changes the UUID!");
+
+		if (before)
+			m_Before = CreateScope<EntitySnapshot>(*before);
+		if (after)
+			m_After = CreateScope<EntitySnapshot>(*after);
+	}
+
+	size_t EntityCommand::GetMemoryUsage() const
+	{
+		size_t size = sizeof(*this);
+		if (m_Before)
+			size += m_Before->GetMemoryUsage();
+		if (m_After)
+			size += m_After->GetMemoryUsage();
+		return size;
+	}
+
+	void EntityCommand::Apply(const EntitySnapshot* state)
+	{
+		if (Entity entity = m_Scene->GetEntityByUUID(m_Entity))
+			m_Scene->DestroyEntity(entity);
+
+		if (state)
+			state->Restore(*m_Scene);
+	}
+
+}
@@ -0,0 +1,53 @@
+#pragma once
+
+#include "EditorCommand.h"
+
+#include <optional>
+#include <tuple>
+
+namespace Dymatic {
+
+	// A copy of every component an entity owns, components shared through a prefab are not
+	// copied. Runtime state is left out, see Utils::StripRuntimeState.
+	class EntitySnapshot
+	{
+	public:
+		EntitySnapshot(Entity entity);
+
+		UUID GetUUID() const { return m_ID; }
+
+		// Creates the entity in scene again under the same UUID, which must not be in use
+		Entity Restore(Scene& scene) const;
+
+		size_t GetMemoryUsage() const;
+	private:
+		template<typename... Component>
+		using ComponentCopies = std::tuple<std::optional<Component>...>;
+
+		UUID m_ID;
+		ComponentCopies<TagComponent, TransformComponent, SpriteRendererComponent, CameraComponent,
+			ParticleEmitterComponent, NativeScriptComponent, PrefabInstanceComponent> m_Components;
+	};
+
+	// Creates, destroys or replaces one entity. Entities are recreated from snapshots with their
+	// UUID, so ComponentCommands recorded for them before keep working.
+	class EntityCommand : public EditorCommand
+	{
+	public:
+		// A null before or after means the entity does not exist at that point, both must have the same UUID
+		EntityCommand(const Ref<Scene>& scene, const EntitySnapshot* before, const EntitySnapshot* after);
+
+		virtual void Execute() override { Apply(m_After.get()); }
+		virtual void Undo() override { Apply(m_Before.get()); }
+
+		virtual size_t GetMemoryUsage() const override;
+	private:
+		void Apply(const EntitySnapshot* state);
+	private:
+		Ref<Scene> m_Scene;
+		UUID m_Entity;
+
+		Scope<EntitySnapshot> m_Before, m_After;
+	};
+
+}
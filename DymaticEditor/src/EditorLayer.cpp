@@ -17,20 +17,28 @@ namespace Dymatic {
 	EditorLayer::EditorLayer()
 		: Layer("EditorLayer"), m_CameraController(1280.0f / 720.0f), m_SquareColor({ 0.2f, 0.3f, 0.8f, 1.0f })
 	{
+		m_CameraController.BindEventHandlers(m_EventHandlers);
+		m_EventHandlers.Bind<KeyPressedEvent, &EditorLayer::OnKeyPressed>(this);
 	}
 
 	void EditorLayer::OnAttach()
 	{
 		DY_PROFILE_FUNCTION();
 
-		m_CheckerboardTexture = Texture2D::Create("assets/textures/Checkerboard.png");
+		m_CheckerboardTexture = AssetManager::GetTexture("assets/textures/Checkerboard.png");
+
+		// Edited shaders are recompiled while the editor keeps running
+		Renderer::GetShaderLibrary()->EnableHotReload();
 
 		FramebufferSpecification fbSpec;
+		fbSpec.Attachments = { FramebufferTextureFormat::RGBA8, FramebufferTextureFormat::Depth };
 		fbSpec.Width = 1280;
 		fbSpec.Height = 720;
+		fbSpec.Samples = 4;
 		m_Framebuffer = Framebuffer::Create(fbSpec);
 
-		m_ActiveScene = CreateRef<Scene>();
+		m_EditorScene = CreateRef<Scene>();
+		m_ActiveScene = m_EditorScene;
 
 #if 0
 		// Entity
@@ -84,11 +92,37 @@ namespace Dymatic {
 #endif
 
 		m_SceneHierarchyPanel.SetContext(m_ActiveScene);
+		m_SceneHierarchyPanel.SetCommandHistory(&m_CommandHistory);
+
+		Application::Get().SetRenderOnDemand(m_RenderOnDemand);
 	}
 
 	void EditorLayer::OnDetach()
 	{
 		DY_PROFILE_FUNCTION();
+
+		Application::Get().SetRenderOnDemand(false);
+	}
+
+	bool EditorLayer::IsViewportOutdated()
+	{
+		return !m_RenderOnDemand || m_ViewportDirty || IsViewportAnimated()
+			|| m_RenderedEntityChanges != m_ActiveScene->GetEntityChangeCount()
+			|| m_RenderedCommandChanges != m_CommandHistory.GetChangeCount()
+			|| m_RenderedShaderReloads != Renderer::GetShaderLibrary()->GetReloadCount();
+	}
+
+	bool EditorLayer::IsSpriteGridOutdated()
+	{
+		// Edit mode changes go through the command history, scripts move sprites without it while playing
+		return m_SpriteGridDirty || m_SceneState == SceneState::Play
+			|| m_SpriteGridEntityChanges != m_ActiveScene->GetEntityChangeCount()
+			|| m_SpriteGridCommandChanges != m_CommandHistory.GetChangeCount();
+	}
+
+	bool EditorLayer::IsViewportAnimated()
+	{
+		return m_SceneState == SceneState::Play || m_ActiveScene->IsAnimated() || Renderer::GetShaderLibrary()->IsReloading();
 	}
 
 	void EditorLayer::OnUpdate(Timestep ts)
@@ -104,22 +138,60 @@ namespace Dymatic {
 			m_CameraController.OnResize(m_ViewportSize.x, m_ViewportSize.y);
 
 			m_ActiveScene->OnViewportResize((uint32_t)m_ViewportSize.x, (uint32_t)m_ViewportSize.y);
+			m_ViewportDirty = true;
+		}
+
+		// Sample rates once a second, by wall clock since render on demand sleeps between frames
+		m_FrameCount++;
+		double time = Time::GetTime();
+		float sampleTime = (float)(time - m_SampleStartTime);
+		if (sampleTime >= 1.0f)
+		{
+			uint64_t allocations = Framebuffer::GetAllocationCount();
+			m_FramebufferAllocationRate = (float)(allocations - m_AllocationSampleCount) / sampleTime;
+			m_AllocationSampleCount = allocations;
+
+			m_FrameRate = m_FrameCount / sampleTime;
+			m_ViewportRedrawRate = m_ViewportRedrawCount / sampleTime;
+			m_FrameCount = 0;
+			m_ViewportRedrawCount = 0;
+			m_SampleStartTime = time;
 		}
 
 		// Update
 		if (m_ViewportFocused)
 			m_CameraController.OnUpdate(ts);
 
+		// The last image stays in the framebuffer while nothing it shows changed
+		if (!IsViewportOutdated())
+			return;
+
+		if (IsViewportAnimated())
+			Application::Get().RequestFrame();
+
+		m_ViewportDirty = false;
+		m_RenderedEntityChanges = m_ActiveScene->GetEntityChangeCount();
+		m_RenderedCommandChanges = m_CommandHistory.GetChangeCount();
+		m_RenderedShaderReloads = Renderer::GetShaderLibrary()->GetReloadCount();
+		m_ViewportRedrawCount++;
+
 		// Render
 		Renderer2D::ResetStats();
-		m_Framebuffer->Bind();
-		RenderCommand::SetClearColor({ 0.1f, 0.1f, 0.1f, 1 });
-		RenderCommand::Clear();
+		{
+			DY_PROFILE_GPU_SCOPE("EditorLayer Viewport Pass");
 
-		// Update scene
-		m_ActiveScene->OnUpdate(ts);
+			m_Framebuffer->Bind();
+			RenderCommand::SetClearColor({ 0.1f, 0.1f, 0.1f, 1 });
+			RenderCommand::Clear();
 
-		m_Framebuffer->Unbind();
+			// Update scene
+			if (m_SceneState == SceneState::Play)
+				m_ActiveScene->OnUpdate(ts);
+			else
+				m_ActiveScene->OnUpdateEditor(ts);
+
+			m_Framebuffer->Unbind();
+		}
 	}
 
 	void EditorLayer::OnImGuiRender()
@@ -192,10 +264,36 @@ namespace Dymatic {
 				if (ImGui::MenuItem("Save As...", "Ctrl+Shift+S"))
 					SaveSceneAs();
 
+				ImGui::Separator();
+				if (ImGui::MenuItem("Cook Textures"))
+					TextureCooker::CookDirectory("assets/textures");
+
 				if (ImGui::MenuItem("Exit")) Application::Get().Close();
 				ImGui::EndMenu();
 			}
 
+			if (ImGui::BeginMenu("Edit"))
+			{
+				if (ImGui::MenuItem("Undo", "Ctrl+Z", false, m_CommandHistory.CanUndo()))
+					Undo();
+
+				if (ImGui::MenuItem("Redo", "Ctrl+Y", false, m_CommandHistory.CanRedo()))
+					Redo();
+
+				ImGui::EndMenu();
+			}
+
+			if (ImGui::BeginMenu("Scene"))
+			{
+				if (ImGui::MenuItem("Play", "F5", false, m_SceneState == SceneState::Edit))
+					OnScenePlay();
+
+				if (ImGui::MenuItem("Stop", "F5", false, m_SceneState == SceneState::Play))
+					OnSceneStop();
+
+				ImGui::EndMenu();
+			}
+
 			ImGui::EndMenuBar();
 		}
 
@@ -210,6 +308,37 @@ namespace Dymatic {
 		ImGui::Text("Vertices: %d", stats.GetTotalVertexCount());
 		ImGui::Text("Indices: %d", stats.GetTotalIndexCount());
 
+		ImGui::Separator();
+		ImGui::Text("GPU Timings:");
+		for (auto& result : GPUProfiler::GetResults())
+			ImGui::Text("%s: %.3fms", result.Name, result.Milliseconds);
+
+		ImGui::Separator();
+		auto assetStats = AssetManager::GetStats();
+		ImGui::Text("Assets: %d (%.2f MB)", assetStats.AssetCount, assetStats.MemoryUsage / (1024.0f * 1024.0f));
+		ImGui::Text("Loads: %d, Cache Hits: %d, Evictions: %d", assetStats.Loads, assetStats.CacheHits, assetStats.Evictions);
+
+		ImGui::Separator();
+		auto& eventStats = Application::Get().GetEventQueue().GetStats();
+		ImGui::Text("Events: %d raw, %d delivered", eventStats.RawEvents, eventStats.DeliveredEvents);
+		ImGui::Text("Framebuffer Reallocations: %.1f/s", m_FramebufferAllocationRate);
+		if (ImGui::Checkbox("Render On Demand", &m_RenderOnDemand))
+			Application::Get().SetRenderOnDemand(m_RenderOnDemand);
+		ImGui::Text("Frames: %.1f/s, Viewport Redraws: %.1f/s", m_FrameRate, m_ViewportRedrawRate);
+		ImGui::Text("Play Mode Scene Copy: %.3fms", m_SceneCopyMillis);
+		ImGui::Text("Picking: grid build %.3fms, raycast %.3fms", m_PickBuildMillis, m_PickRaycastMillis);
+		ImGui::Text("Undo History: %d commands, %.1f/%.0f KB", (int)m_CommandHistory.GetCommandCount(), m_CommandHistory.GetMemoryUsage() / 1024.0f, m_CommandHistory.GetMemoryBudget() / 1024.0f);
+		if (ImGui::Button("Check Undo/Redo"))
+			m_CommandHistoryCheck = CommandHistoryCheck::Run();
+		if (m_CommandHistoryCheck.Checks > 0)
+		{
+			ImGui::SameLine();
+			if (m_CommandHistoryCheck.Passed())
+				ImGui::Text("%d checks passed", m_CommandHistoryCheck.Checks);
+			else
+				ImGui::Text("%d of %d checks failed, see log", m_CommandHistoryCheck.Failures, m_CommandHistoryCheck.Checks);
+		}
+
 		ImGui::End();
 
 		ImGui::PushStyleVar(ImGuiStyleVar_WindowPadding, ImVec2{ 0, 0 });
@@ -219,11 +348,14 @@ namespace Dymatic {
 		m_ViewportHovered = ImGui::IsWindowHovered();
 		Application::Get().GetImGuiLayer()->BlockEvents(!m_ViewportFocused && !m_ViewportHovered);
 
+		ImVec2 viewportOffset = ImGui::GetCursorScreenPos();
 		ImVec2 viewportPanelSize = ImGui::GetContentRegionAvail();
 		m_ViewportSize = { viewportPanelSize.x, viewportPanelSize.y };
 
+		// The attachments may be larger than the viewport, only show the part that was rendered to
 		uint64_t textureID = m_Framebuffer->GetColorAttachmentRendererID();
-		ImGui::Image(reinterpret_cast<void*>(textureID), ImVec2{ m_ViewportSize.x, m_ViewportSize.y }, ImVec2{ 0, 1 }, ImVec2{ 1, 0 });
+		glm::vec2 uvScale = m_Framebuffer->GetTextureCoordinateScale();
+		ImGui::Image(reinterpret_cast<void*>(textureID), ImVec2{ m_ViewportSize.x, m_ViewportSize.y }, ImVec2{ 0, uvScale.y }, ImVec2{ uvScale.x, 0 });
 
 		// Gizmos
 		Entity selectedEntity = m_SceneHierarchyPanel.GetSelectedEntity();
@@ -263,6 +395,8 @@ namespace Dymatic {
 
 			if (ImGuizmo::IsUsing())
 			{
+				TransformComponent before = tc;
+
 				glm::vec3 translation, rotation, scale;
 				Math::DecomposeTransform(transform, translation, rotation, scale);
 
@@ -271,22 +405,33 @@ namespace Dymatic {
 				tc.Rotation += deltaRotation;
 				tc.Scale = scale;
 
+				// Every frame of the drag merges into one undo step
+				if (m_SceneState == SceneState::Edit)
+					m_CommandHistory.Push(CreateScope<ComponentCommand<TransformComponent>>(m_ActiveScene, selectedEntity.GetUUID(), &before, &tc), true);
 			}
 
 		}
 
+		// Clicks on the gizmo belong to the gizmo
+		bool overGizmo = selectedEntity && m_GizmoType != -1 && ImGuizmo::IsOver();
+		if (m_ViewportHovered && ImGui::IsMouseClicked(ImGuiMouseButton_Left) && !overGizmo)
+		{
+			ImVec2 mousePosition = ImGui::GetMousePos();
+			PickEntity({ mousePosition.x - viewportOffset.x, mousePosition.y - viewportOffset.y });
+		}
+
 		ImGui::End();
 		ImGui::PopStyleVar();
 
 		ImGui::End();
-	}
 
-	void EditorLayer::OnEvent(Event& e)
-	{
-		m_CameraController.OnEvent(e);
+		// A drag ends when its widget or the gizmo is released
+		if (!ImGui::IsAnyItemActive() && !ImGuizmo::IsUsing())
+			m_CommandHistory.EndMerge();
 
-		EventDispatcher dispatcher(e);
-		dispatcher.Dispatch<KeyPressedEvent>(DY_BIND_EVENT_FN(EditorLayer::OnKeyPressed));
+		// Edits made by the panels show up in the viewport next frame, which must not wait for input
+		if (IsViewportOutdated())
+			Application::Get().RequestFrame();
 	}
 
 	bool EditorLayer::OnKeyPressed(KeyPressedEvent& e)
@@ -320,6 +465,32 @@ namespace Dymatic {
 
 				break;
 			}
+			case Key::Z:
+			{
+				if (control && shift)
+					Redo();
+				else if (control)
+					Undo();
+
+				break;
+			}
+			case Key::Y:
+			{
+				if (control)
+					Redo();
+
+				break;
+			}
+
+			case Key::F5:
+			{
+				if (m_SceneState == SceneState::Edit)
+					OnScenePlay();
+				else
+					OnSceneStop();
+
+				break;
+			}
 
 			//Gizmos
 			case Key::Q:
@@ -335,13 +506,22 @@ namespace Dymatic {
 				m_GizmoType = ImGuizmo::OPERATION::SCALE;
 				break;
 		}
+
+		return false;
 	}
 
 	void EditorLayer::NewScene()
 	{
-		m_ActiveScene = CreateRef<Scene>();
-		m_ActiveScene->OnViewportResize((uint32_t)m_ViewportSize.x, (uint32_t)m_ViewportSize.y);
+		if (m_SceneState == SceneState::Play)
+			OnSceneStop();
+
+		m_EditorScene = CreateRef<Scene>();
+		m_EditorScene->OnViewportResize((uint32_t)m_ViewportSize.x, (uint32_t)m_ViewportSize.y);
+		m_ActiveScene = m_EditorScene;
 		m_SceneHierarchyPanel.SetContext(m_ActiveScene);
+		m_ViewportDirty = true;
+		m_SpriteGridDirty = true;
+		m_CommandHistory.Clear();
 	}
 
 	void EditorLayer::OpenScene()
@@ -349,9 +529,16 @@ namespace Dymatic {
 		std::optional<std::string> filepath = FileDialogs::OpenFile("Dymatic Scene (*.dymatic)\0*.dymatic\0");
 		if (filepath)
 		{
-			m_ActiveScene = CreateRef<Scene>();
-			m_ActiveScene->OnViewportResize((uint32_t)m_ViewportSize.x, (uint32_t)m_ViewportSize.y);
+			if (m_SceneState == SceneState::Play)
+				OnSceneStop();
+
+			m_EditorScene = CreateRef<Scene>();
+			m_EditorScene->OnViewportResize((uint32_t)m_ViewportSize.x, (uint32_t)m_ViewportSize.y);
+			m_ActiveScene = m_EditorScene;
 			m_SceneHierarchyPanel.SetContext(m_ActiveScene);
+			m_ViewportDirty = true;
+			m_SpriteGridDirty = true;
+			m_CommandHistory.Clear();
 
 			SceneSerializer serializer(m_ActiveScene);
 			serializer.Deserialize(*filepath);
@@ -363,9 +550,97 @@ namespace Dymatic {
 		std::optional<std::string> filepath = FileDialogs::SaveFile("Dymatic Scene (*.dymatic)\0*.dymatic\0");
 		if (filepath)
 		{
-			SceneSerializer serializer(m_ActiveScene);
+			// Changes made while playing are not saved
+			SceneSerializer serializer(m_EditorScene);
 			serializer.Serialize(*filepath);
 		}
 	}
 
+	void EditorLayer::OnScenePlay()
+	{
+		Timer timer;
+		m_ActiveScene = Scene::Copy(m_EditorScene);
+		m_SceneCopyMillis = timer.ElapsedMillis();
+
+		m_SceneState = SceneState::Play;
+		m_SceneHierarchyPanel.SetContext(m_ActiveScene);
+		m_ViewportDirty = true;
+		m_SpriteGridDirty = true;
+		m_SceneHierarchyPanel.SetCommandHistory(nullptr);
+	}
+
+	void EditorLayer::OnSceneStop()
+	{
+		m_SceneState = SceneState::Edit;
+		m_ActiveScene = m_EditorScene;
+		m_ActiveScene->OnViewportResize((uint32_t)m_ViewportSize.x, (uint32_t)m_ViewportSize.y);
+		m_SceneHierarchyPanel.SetContext(m_ActiveScene);
+		m_ViewportDirty = true;
+		m_SpriteGridDirty = true;
+		m_SceneHierarchyPanel.SetCommandHistory(&m_CommandHistory);
+	}
+
+	void EditorLayer::PickEntity(const glm::vec2& viewportPosition)
+	{
+		DY_PROFILE_FUNCTION();
+
+		Entity cameraEntity = m_ActiveScene->GetPrimaryCameraEntity();
+		if (!cameraEntity || m_ViewportSize.x <= 0.0f || m_ViewportSize.y <= 0.0f)
+			return;
+
+		// Unproject the point onto the near and far planes of the camera the viewport renders with
+		const auto& camera = cameraEntity.GetComponent<CameraComponent>().Camera;
+		glm::mat4 inverseViewProjection = cameraEntity.GetComponent<TransformComponent>().GetTransform() * glm::inverse(camera.GetProjection());
+
+		glm::vec2 ndc = { viewportPosition.x / m_ViewportSize.x * 2.0f - 1.0f, 1.0f - viewportPosition.y / m_ViewportSize.y * 2.0f };
+		glm::vec4 nearPoint = inverseViewProjection * glm::vec4(ndc, -1.0f, 1.0f);
+		glm::vec4 farPoint = inverseViewProjection * glm::vec4(ndc, 1.0f, 1.0f);
+		glm::vec3 origin = glm::vec3(nearPoint) / nearPoint.w;
+		glm::vec3 direction = glm::vec3(farPoint) / farPoint.w - origin;
+
+		Timer timer;
+		if (IsSpriteGridOutdated())
+		{
+			m_SpriteGrid.Build(m_ActiveScene.get());
+			m_PickBuildMillis = timer.ElapsedMillis();
+
+			m_SpriteGridDirty = false;
+			m_SpriteGridEntityChanges = m_ActiveScene->GetEntityChangeCount();
+			m_SpriteGridCommandChanges = m_CommandHistory.GetChangeCount();
+		}
+
+		timer.Reset();
+		Entity picked = m_SpriteGrid.Raycast(origin, direction);
+		m_PickRaycastMillis = timer.ElapsedMillis();
+
+		m_SceneHierarchyPanel.SetSelectedEntity(picked);
+	}
+
+	void EditorLayer::Undo()
+	{
+		if (m_SceneState != SceneState::Edit)
+			return;
+
+		UUID selected = GetSelectedUUID();
+		m_CommandHistory.Undo();
+		m_SceneHierarchyPanel.SetSelectedEntity(m_ActiveScene->GetEntityByUUID(selected));
+	}
+
+	void EditorLayer::Redo()
+	{
+		if (m_SceneState != SceneState::Edit)
+			return;
+
+		UUID selected = GetSelectedUUID();
+		m_CommandHistory.Redo();
+		m_SceneHierarchyPanel.SetSelectedEntity(m_ActiveScene->GetEntityByUUID(selected));
+	}
+
+	UUID EditorLayer::GetSelectedUUID() const
+	{
+		// Undo and redo may destroy the selected entity or recreate it under another handle
+		Entity selected = m_SceneHierarchyPanel.GetSelectedEntity();
+		return selected ? selected.GetUUID() : UUID(0);
+	}
+
 }
\ No newline at end of file
@@ -2,6 +2,8 @@
 
 #include "Dymatic.h"
 #include "Panels/SceneHierarchyPanel.h"
+#include "Commands/CommandHistory.h"
+#include "Commands/CommandHistoryCheck.h"
 
 namespace Dymatic {
 
@@ -16,13 +18,29 @@ namespace Dymatic {
 
 		void OnUpdate(Timestep ts) override;
 		virtual void OnImGuiRender() override;
-		void OnEvent(Event& e) override;
 	private:
 		bool OnKeyPressed(KeyPressedEvent& e);
 
 		void NewScene();
 		void OpenScene();
 		void SaveSceneAs();
+
+		void OnScenePlay();
+		void OnSceneStop();
+
+		void Undo();
+		void Redo();
+		UUID GetSelectedUUID() const;
+
+		// Something the viewport shows changed since it was last drawn
+		bool IsViewportOutdated();
+		// The viewport changes every frame without any edit
+		bool IsViewportAnimated();
+		// The scene changed since the picking grid was built
+		bool IsSpriteGridOutdated();
+
+		// Selects the closest sprite under a point given in viewport pixels
+		void PickEntity(const glm::vec2& viewportPosition);
 	private:
 		Dymatic::OrthographicCameraController m_CameraController;
 
@@ -31,7 +49,13 @@ namespace Dymatic {
 		Ref<Shader> m_FlatColorShader;
 		Ref<Framebuffer> m_Framebuffer;
 
+		// Play mode runs on a copy, m_ActiveScene is the copy while playing and m_EditorScene otherwise
+		enum class SceneState { Edit = 0, Play = 1 };
+		SceneState m_SceneState = SceneState::Edit;
+		float m_SceneCopyMillis = 0.0f;
+
 		Ref<Scene> m_ActiveScene;
+		Ref<Scene> m_EditorScene;
 		Entity m_SquareEntity;
 		Entity m_CameraEntity;
 		Entity m_SecondCamera;
@@ -43,11 +67,36 @@ namespace Dymatic {
 		bool m_ViewportFocused = false, m_ViewportHovered = false;
 		glm::vec2 m_ViewportSize = { 0.0f, 0.0f };
 
+		float m_FramebufferAllocationRate = 0.0f;
+		uint64_t m_AllocationSampleCount = 0;
+
+		double m_SampleStartTime = 0.0;
+		float m_FrameRate = 0.0f, m_ViewportRedrawRate = 0.0f;
+		uint64_t m_FrameCount = 0, m_ViewportRedrawCount = 0;
+
+		// Render on demand, the viewport is drawn again only when one of these changed
+		bool m_RenderOnDemand = true;
+		bool m_ViewportDirty = true;
+		uint64_t m_RenderedEntityChanges = 0;
+		uint64_t m_RenderedCommandChanges = 0;
+		uint64_t m_RenderedShaderReloads = 0;
+
 		glm::vec4 m_SquareColor = { 0.2f, 0.3f, 0.8f, 1.0f };
 
 		int m_GizmoType = -1;
 		int m_GizmoSpace = 0;
 
+		// Kept between clicks, rebuilt only when the same changes that redraw the viewport happened
+		SpriteGrid m_SpriteGrid;
+		bool m_SpriteGridDirty = true;
+		uint64_t m_SpriteGridEntityChanges = 0;
+		uint64_t m_SpriteGridCommandChanges = 0;
+		float m_PickBuildMillis = 0.0f, m_PickRaycastMillis = 0.0f;
+
+		// Edits to the editor scene, play mode is not recorded
+		CommandHistory m_CommandHistory;
+		CommandHistoryCheck::Result m_CommandHistoryCheck;
+
 		// Panels
 		SceneHierarchyPanel m_SceneHierarchyPanel;
 	};
@@ -0,0 +1,140 @@
+#include "EntityNameIndex.h"
+
+#include <algorithm>
+#include <cctype>
+
+namespace Dymatic {
+
+	namespace Utils {
+
+		static std::string ToLower(const std::string& string)
+		{
+			std::string result = string;
+			for (char& c : result)
+				c = (char)std::tolower((unsigned char)c);
+			return result;
+		}
+
+		static uint32_t GetTrigram(const std::string& string, size_t offset)
+		{
+			return (uint32_t)(uint8_t)string[offset] | (uint32_t)(uint8_t)string[offset + 1] << 8 | (uint32_t)(uint8_t)string[offset + 2] << 16;
+		}
+
+	}
+
+	uint32_t EntityNameIndex::Acquire(const std::string& name)
+	{
+		std::string lowercase = Utils::ToLower(name);
+
+		auto it = m_Lookup.find(lowercase);
+		if (it != m_Lookup.end())
+		{
+			m_Entries[it->second].References++;
+			return it->second;
+		}
+
+		uint32_t id;
+		if (m_FreeEntries.empty())
+		{
+			id = (uint32_t)m_Entries.size();
+			m_Entries.emplace_back();
+		}
+		else
+		{
+			id = m_FreeEntries.back();
+			m_FreeEntries.pop_back();
+		}
+
+		Entry& entry = m_Entries[id];
+		entry.Name = lowercase;
+		entry.References = 1;
+		m_Lookup[lowercase] = id;
+		IndexTrigrams(id);
+
+		return id;
+	}
+
+	void EntityNameIndex::Release(uint32_t id)
+	{
+		Entry& entry = m_Entries[id];
+		if (--entry.References > 0)
+			return;
+
+		m_Lookup.erase(entry.Name);
+		entry.Name.clear();
+		m_FreeEntries.push_back(id);
+
+		if (++m_StaleEntries > m_Lookup.size() + 1024)
+			RebuildTrigrams();
+	}
+
+	void EntityNameIndex::Clear()
+	{
+		m_Entries.clear();
+		m_FreeEntries.clear();
+		m_Lookup.clear();
+		m_Trigrams.clear();
+		m_StaleEntries = 0;
+	}
+
+	void EntityNameIndex::Find(const std::string& query, std::vector<bool>& matches) const
+	{
+		matches.assign(m_Entries.size(), false);
+
+		std::string lowercase = Utils::ToLower(query);
+
+		// Too short to have a sequence, only the distinct names are compared
+		if (lowercase.size() < 3)
+		{
+			for (uint32_t id = 0; id < m_Entries.size(); id++)
+				if (m_Entries[id].References > 0 && m_Entries[id].Name.find(lowercase) != std::string::npos)
+					matches[id] = true;
+			return;
+		}
+
+		const std::vector<uint32_t>* candidates = nullptr;
+		for (size_t offset = 0; offset + 3 <= lowercase.size(); offset++)
+		{
+			auto it = m_Trigrams.find(Utils::GetTrigram(lowercase, offset));
+			if (it == m_Trigrams.end())
+				return;
+			if (!candidates || it->second.size() < candidates->size())
+				candidates = &it->second;
+		}
+
+		for (uint32_t id : *candidates)
+		{
+			const Entry& entry = m_Entries[id];
+			if (entry.References > 0 && entry.Name.find(lowercase) != std::string::npos)
+				matches[id] = true;
+		}
+	}
+
+	void EntityNameIndex::IndexTrigrams(uint32_t id)
+	{
+		const std::string& name = m_Entries[id].Name;
+		if (name.size() < 3)
+			return;
+
+		std::vector<uint32_t> trigrams;
+		trigrams.reserve(name.size() - 2);
+		for (size_t offset = 0; offset + 3 <= name.size(); offset++)
+			trigrams.push_back(Utils::GetTrigram(name, offset));
+
+		std::sort(trigrams.begin(), trigrams.end());
+		trigrams.erase(std::unique(trigrams.begin(), trigrams.end()), trigrams.end());
+
+		for (uint32_t trigram : trigrams)
+			m_Trigrams[trigram].push_back(id);
+	}
+
+	void EntityNameIndex::RebuildTrigrams()
+	{
+		m_Trigrams.clear();
+		for (uint32_t id = 0; id < m_Entries.size(); id++)
+			if (m_Entries[id].References > 0)
+				IndexTrigrams(id);
+		m_StaleEntries = 0;
+	}
+
+}
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace Dymatic {
+
+	// Case insensitive substring search over entity names. Entities with the same name share
+	// one entry, and entries are listed under every three character sequence they contain, so
+	// a query only compares the entries listed under its rarest sequence.
+	class EntityNameIndex
+	{
+	public:
+		// Adds a reference to the entry for name, creating it if needed
+		uint32_t Acquire(const std::string& name);
+		void Release(uint32_t id);
+		void Clear();
+
+		// Resizes matches to GetCapacity() and marks the entries whose name contains query
+		void Find(const std::string& query, std::vector<bool>& matches) const;
+
+		uint32_t GetCapacity() const { return (uint32_t)m_Entries.size(); }
+		uint32_t GetNameCount() const { return (uint32_t)m_Lookup.size(); }
+	private:
+		void IndexTrigrams(uint32_t id);
+		void RebuildTrigrams();
+	private:
+		struct Entry
+		{
+			std::string Name; // Lowercase
+			uint32_t References = 0;
+		};
+
+		std::vector<Entry> m_Entries;
+		std::vector<uint32_t> m_FreeEntries;
+		std::unordered_map<std::string, uint32_t> m_Lookup;
+
+		// Released entries stay listed until the lists are rebuilt, every candidate is compared anyway
+		std::unordered_map<uint32_t, std::vector<uint32_t>> m_Trigrams;
+		uint32_t m_StaleEntries = 0;
+	};
+
+}
@@ -6,6 +6,11 @@
 #include <glm/gtc/type_ptr.hpp>
 
 #include "Dymatic/Scene/Components.h"
+#include "Dymatic/Scene/Prefab.h"
+#include "Dymatic/Utils/PlatformUtils.h"
+#include "../Commands/CommandHistory.h"
+#include "../Commands/EntityCommand.h"
+#include <algorithm>
 #include <cstring>
 
 /* The Microsoft C++ compiler is non-compliant with the C++ standard and needs
@@ -17,26 +22,206 @@
 
 namespace Dymatic {
 
+	// A null before or after means the entity did not or does not exist
+	static void RecordEntityCommand(CommandHistory* history, const Ref<Scene>& scene, const EntitySnapshot* before, const EntitySnapshot* after)
+	{
+		if (history)
+			history->Push(CreateScope<EntityCommand>(scene, before, after));
+	}
+
 	SceneHierarchyPanel::SceneHierarchyPanel(const Ref<Scene>& context)
 	{
 		SetContext(context);
 	}
 
+	SceneHierarchyPanel::~SceneHierarchyPanel()
+	{
+		DisconnectSignals();
+	}
+
 	void SceneHierarchyPanel::SetContext(const Ref<Scene>& context)
 	{
+		DisconnectSignals();
 		m_Context = context;
 		m_SelectionContext = {};
+		ConnectSignals();
+
+		RebuildRows();
+	}
+
+	void SceneHierarchyPanel::OnEntityChanged(entt::registry&, entt::entity entity)
+	{
+		// Components are not all in place when the signal fires, so rows are updated next frame
+		m_PendingEntities.push_back(entity);
+	}
+
+	void SceneHierarchyPanel::ConnectSignals()
+	{
+		if (!m_Context)
+			return;
+
+		auto& registry = m_Context->m_Registry;
+		registry.on_construct<IDComponent>().connect<&SceneHierarchyPanel::OnEntityChanged>(*this);
+		registry.on_destroy<IDComponent>().connect<&SceneHierarchyPanel::OnEntityChanged>(*this);
+		registry.on_construct<TagComponent>().connect<&SceneHierarchyPanel::OnEntityChanged>(*this);
+		registry.on_update<TagComponent>().connect<&SceneHierarchyPanel::OnEntityChanged>(*this);
+		registry.on_destroy<TagComponent>().connect<&SceneHierarchyPanel::OnEntityChanged>(*this);
+		registry.on_construct<PrefabInstanceComponent>().connect<&SceneHierarchyPanel::OnEntityChanged>(*this);
+	}
+
+	void SceneHierarchyPanel::DisconnectSignals()
+	{
+		if (!m_Context)
+			return;
+
+		auto& registry = m_Context->m_Registry;
+		registry.on_construct<IDComponent>().disconnect(*this);
+		registry.on_destroy<IDComponent>().disconnect(*this);
+		registry.on_construct<TagComponent>().disconnect(*this);
+		registry.on_update<TagComponent>().disconnect(*this);
+		registry.on_destroy<TagComponent>().disconnect(*this);
+		registry.on_construct<PrefabInstanceComponent>().disconnect(*this);
+	}
+
+	void SceneHierarchyPanel::RebuildRows()
+	{
+		DY_PROFILE_FUNCTION();
+
+		m_Rows.clear();
+		m_RowLookup.clear();
+		m_DeadRows = 0;
+		m_PendingEntities.clear();
+		m_NameIndex.Clear();
+		m_VisibleRowsDirty = true;
+
+		if (!m_Context)
+			return;
+
+		auto& registry = m_Context->m_Registry;
+		const entt::entity* entities = registry.data<IDComponent>();
+		size_t count = registry.size<IDComponent>();
+
+		m_Rows.reserve(count);
+		m_RowLookup.reserve(count);
+		for (size_t i = 0; i < count; i++)
+		{
+			Entity entity{ entities[i], m_Context.get() };
+			const std::string& name = entity.HasEffectiveComponent<TagComponent>() ? entity.GetEffectiveComponent<TagComponent>().Tag : std::string();
+
+			m_RowLookup[entities[i]] = (uint32_t)m_Rows.size();
+			m_Rows.push_back({ entities[i], m_NameIndex.Acquire(name) });
+		}
+	}
+
+	void SceneHierarchyPanel::UpdateRows()
+	{
+		if (m_PendingEntities.empty())
+			return;
+
+		DY_PROFILE_FUNCTION();
+
+		auto& registry = m_Context->m_Registry;
+		for (entt::entity handle : m_PendingEntities)
+		{
+			auto it = m_RowLookup.find(handle);
+			if (!registry.valid(handle) || !registry.has<IDComponent>(handle))
+			{
+				if (it == m_RowLookup.end())
+					continue;
+
+				Row& row = m_Rows[it->second];
+				m_NameIndex.Release(row.NameID);
+				row.Handle = entt::null;
+				m_RowLookup.erase(it);
+				m_DeadRows++;
+				continue;
+			}
+
+			Entity entity{ handle, m_Context.get() };
+			const std::string& name = entity.HasEffectiveComponent<TagComponent>() ? entity.GetEffectiveComponent<TagComponent>().Tag : std::string();
+
+			// Acquired before the old name is released, so an unchanged name keeps its entry
+			uint32_t nameID = m_NameIndex.Acquire(name);
+			if (it == m_RowLookup.end())
+			{
+				m_RowLookup[handle] = (uint32_t)m_Rows.size();
+				m_Rows.push_back({ handle, nameID });
+			}
+			else
+			{
+				Row& row = m_Rows[it->second];
+				m_NameIndex.Release(row.NameID);
+				row.NameID = nameID;
+			}
+		}
+		m_PendingEntities.clear();
+
+		if (m_DeadRows > m_Rows.size() / 2)
+		{
+			m_Rows.erase(std::remove_if(m_Rows.begin(), m_Rows.end(), [](const Row& row) { return row.Handle == entt::null; }), m_Rows.end());
+			for (uint32_t i = 0; i < m_Rows.size(); i++)
+				m_RowLookup[m_Rows[i].Handle] = i;
+			m_DeadRows = 0;
+		}
+
+		m_VisibleRowsDirty = true;
+	}
+
+	void SceneHierarchyPanel::UpdateVisibleRows()
+	{
+		if (!m_VisibleRowsDirty)
+			return;
+
+		DY_PROFILE_FUNCTION();
+
+		m_VisibleRows.clear();
+		m_VisibleRowsDirty = false;
+
+		bool filtered = m_SearchBuffer[0] != '\0';
+		if (filtered)
+			m_NameIndex.Find(m_SearchBuffer, m_NameMatches);
+
+		for (uint32_t i = 0; i < m_Rows.size(); i++)
+		{
+			const Row& row = m_Rows[i];
+			if (row.Handle != entt::null && (!filtered || m_NameMatches[row.NameID]))
+				m_VisibleRows.push_back(i);
+		}
 	}
 
 	void SceneHierarchyPanel::OnImGuiRender()
 	{
 		ImGui::Begin("Scene Hierarchy");
 
-		m_Context->m_Registry.each([&](auto entityID)
+		UpdateRows();
+
+		ImGui::PushItemWidth(-1);
+		if (ImGui::InputTextWithHint("##Search", "Search", m_SearchBuffer, sizeof(m_SearchBuffer)))
+			m_VisibleRowsDirty = true;
+		ImGui::PopItemWidth();
+
+		UpdateVisibleRows();
+
+		// Only the rows in view are submitted, every row is one line high
+		ImGui::BeginChild("Entities");
+
+		ImGuiListClipper clipper;
+		clipper.Begin((int)m_VisibleRows.size());
+		while (clipper.Step())
 		{
-			Entity entity{ entityID , m_Context.get() };
-			DrawEntityNode(entity);
-		});
+			for (int i = clipper.DisplayStart; i < clipper.DisplayEnd; i++)
+			{
+				entt::entity handle = m_Rows[m_VisibleRows[i]].Handle;
+				// Destroyed earlier this frame
+				if (!m_Context->m_Registry.valid(handle))
+				{
+					ImGui::NewLine();
+					continue;
+				}
+				DrawEntityNode({ handle, m_Context.get() });
+			}
+		}
+		clipper.End();
 
 		if (ImGui::IsMouseDown(0) && ImGui::IsWindowHovered())
 			m_SelectionContext = {};
@@ -45,11 +230,32 @@ namespace Dymatic {
 		if (ImGui::BeginPopupContextWindow(0, 1, false))
 		{
 			if (ImGui::MenuItem("Create Empty Entity"))
-				m_Context->CreateEntity("Empty Entity");
+			{
+				EntitySnapshot after(m_Context->CreateEntity("Empty Entity"));
+				RecordEntityCommand(m_CommandHistory, m_Context, nullptr, &after);
+			}
+
+			if (ImGui::MenuItem("Instantiate Prefab..."))
+			{
+				std::optional<std::string> filepath = FileDialogs::OpenFile("Dymatic Prefab (*.dyprefab)\0*.dyprefab\0");
+				if (filepath)
+				{
+					if (Ref<Prefab> prefab = Prefab::Load(*filepath))
+					{
+						m_SelectionContext = m_Context->InstantiatePrefab(prefab);
+						EntitySnapshot after(m_SelectionContext);
+						RecordEntityCommand(m_CommandHistory, m_Context, nullptr, &after);
+					}
+					else
+						DY_CORE_ERROR("Could not load prefab '{0}'", *filepath);
+				}
+			}
 
 			ImGui::EndPopup();
 		}
 
+		ImGui::EndChild();
+
 		ImGui::End();
 
 		ImGui::Begin("Properties");
@@ -63,37 +269,71 @@ namespace Dymatic {
 
 	void SceneHierarchyPanel::DrawEntityNode(Entity entity)
 	{
-		auto& tag = entity.GetComponent<TagComponent>().Tag;
+		const auto& tag = entity.GetEffectiveComponent<TagComponent>().Tag;
 
-		ImGuiTreeNodeFlags flags = ((m_SelectionContext == entity) ? ImGuiTreeNodeFlags_Selected : 0) | ImGuiTreeNodeFlags_OpenOnArrow;
+		// Entities have no children yet, leaves keep every row the same height for the clipper
+		ImGuiTreeNodeFlags flags = ((m_SelectionContext == entity) ? ImGuiTreeNodeFlags_Selected : 0) | ImGuiTreeNodeFlags_Leaf | ImGuiTreeNodeFlags_NoTreePushOnOpen;
 		flags |= ImGuiTreeNodeFlags_SpanAvailWidth;
-		bool opened = ImGui::TreeNodeEx((void*)(uint64_t)(uint32_t)entity, flags, tag.c_str());
+		ImGui::TreeNodeEx((void*)(uint64_t)(uint32_t)entity, flags, tag.c_str());
 		if (ImGui::IsItemClicked())
 		{
 			m_SelectionContext = entity;
 		}
 
 		bool entityDeleted = false;
+		bool createPrefab = false;
 		if (ImGui::BeginPopupContextItem())
 		{
 			if (ImGui::MenuItem("Delete Entity"))
 				entityDeleted = true;
 
+			if (entity.HasComponent<PrefabInstanceComponent>())
+			{
+				if (ImGui::MenuItem("Instantiate Prefab"))
+				{
+					Entity instance = m_Context->InstantiatePrefab(entity.GetComponent<PrefabInstanceComponent>().Source);
+					instance.GetComponent<TransformComponent>() = entity.GetComponent<TransformComponent>();
+					EntitySnapshot after(instance);
+					RecordEntityCommand(m_CommandHistory, m_Context, nullptr, &after);
+				}
+
+				// Scenes saved afterwards reference the file instead of embedding the prefab
+				if (ImGui::MenuItem("Save Prefab As..."))
+				{
+					std::optional<std::string> filepath = FileDialogs::SaveFile("Dymatic Prefab (*.dyprefab)\0*.dyprefab\0");
+					if (filepath)
+						Prefab::Save(entity.GetComponent<PrefabInstanceComponent>().Source, *filepath);
+				}
+			}
+			else if (ImGui::MenuItem("Create Prefab"))
+				createPrefab = true;
+
 			ImGui::EndPopup();
 		}
 
-		if (opened)
+		// The entity is replaced by the first instance of its new prefab, which keeps the entity's
+		// UUID so everything referring to it still does
+		if (createPrefab)
 		{
-			ImGuiTreeNodeFlags flags = ImGuiTreeNodeFlags_OpenOnArrow | ImGuiTreeNodeFlags_SpanAvailWidth;
-			bool opened = ImGui::TreeNodeEx((void*)9817239, flags, tag.c_str());
-			if (opened)
-				ImGui::TreePop();
-			ImGui::TreePop();
-		}
+			Ref<Prefab> prefab = Prefab::Create(entity);
+			EntitySnapshot before(entity);
+			TransformComponent transform = entity.GetComponent<TransformComponent>();
+			bool selected = m_SelectionContext == entity;
 
-		if (entityDeleted)
+			m_Context->DestroyEntity(entity);
+			Entity instance = m_Context->InstantiatePrefabWithUUID(prefab, before.GetUUID());
+			instance.GetComponent<TransformComponent>() = transform;
+			if (selected)
+				m_SelectionContext = instance;
+
+			EntitySnapshot after(instance);
+			RecordEntityCommand(m_CommandHistory, m_Context, &before, &after);
+		}
+		else if (entityDeleted)
 		{
+			EntitySnapshot before(entity);
 			m_Context->DestroyEntity(entity);
+			RecordEntityCommand(m_CommandHistory, m_Context, &before, nullptr);
 			if (m_SelectionContext == entity)
 				m_SelectionContext = {};
 		}
@@ -165,11 +405,49 @@ namespace Dymatic {
 		ImGui::PopID();
 	}
 
+	// A null before or after means the entity did not or does not have the component
+	template<typename T>
+	static void RecordComponentCommand(CommandHistory* history, const Ref<Scene>& scene, Entity entity, const T* before, const T* after, bool mergeable = false)
+	{
+		if (history)
+			history->Push(CreateScope<ComponentCommand<T>>(scene, entity.GetUUID(), before, after), mergeable);
+	}
+
+	// Catches widgets that write without being marked as edited, like the Vec3 reset buttons
+	template<typename T>
+	static bool HasComponentChanged(bool widgetEdited, const T& before, const T& after)
+	{
+		if constexpr (std::is_trivially_copyable_v<T>)
+			return std::memcmp(&before, &after, sizeof(T)) != 0;
+		else
+			return widgetEdited;
+	}
+
 	template<typename T, typename UIFunction>
-	static void DrawComponent(const std::string& name, Entity entity, UIFunction uiFunction)
+	static void DrawComponent(const std::string& name, Entity entity, const Ref<Scene>& scene, CommandHistory* history, UIFunction uiFunction)
 	{
 		const ImGuiTreeNodeFlags treeNodeFlags = ImGuiTreeNodeFlags_DefaultOpen | ImGuiTreeNodeFlags_Framed | ImGuiTreeNodeFlags_SpanAvailWidth | ImGuiTreeNodeFlags_AllowItemOverlap | ImGuiTreeNodeFlags_FramePadding;
-		if (entity.HasComponent<T>())
+		if (!entity.HasComponent<T>() && entity.HasEffectiveComponent<T>())
+		{
+			// Shared by the entity's prefab, edit a copy and only override the component once it changes
+			T component = entity.GetEffectiveComponent<T>();
+
+			ImGui::Separator();
+			bool open = ImGui::TreeNodeEx((void*)typeid(T).hash_code(), treeNodeFlags, "%s (Prefab)", name.c_str());
+			if (open)
+			{
+				T shared = component;
+				bool editedBefore = GImGui->ActiveIdHasBeenEditedThisFrame;
+				uiFunction(component);
+				if (HasComponentChanged(!editedBefore && GImGui->ActiveIdHasBeenEditedThisFrame, shared, component))
+				{
+					entity.OverrideComponent<T>() = component;
+					RecordComponentCommand<T>(history, scene, entity, nullptr, &entity.GetComponent<T>(), true);
+				}
+				ImGui::TreePop();
+			}
+		}
+		else if (entity.HasComponent<T>())
 		{
 			auto& component = entity.GetComponent<T>();
 			ImVec2 contentRegionAvailable = ImGui::GetContentRegionAvail();
@@ -186,10 +464,13 @@ namespace Dymatic {
 				ImGui::OpenPopup("ComponentSettings");
 			}
 
+			// Removing an override goes back to the prefab's component
+			bool overridden = entity.HasComponent<PrefabInstanceComponent>() && entity.GetComponent<PrefabInstanceComponent>().Source->GetEntity().HasComponent<T>();
+
 			bool removeComponent = false;
 			if (ImGui::BeginPopup("ComponentSettings"))
 			{
-				if (ImGui::MenuItem("Remove component"))
+				if (ImGui::MenuItem(overridden ? "Revert to prefab" : "Remove component"))
 					removeComponent = true;
 
 				ImGui::EndPopup();
@@ -197,27 +478,39 @@ namespace Dymatic {
 
 			if (open)
 			{
+				T before = component;
+				bool editedBefore = GImGui->ActiveIdHasBeenEditedThisFrame;
 				uiFunction(component);
+				if (HasComponentChanged(!editedBefore && GImGui->ActiveIdHasBeenEditedThisFrame, before, component))
+					RecordComponentCommand<T>(history, scene, entity, &before, &component, true);
 				ImGui::TreePop();
 			}
 
 			if (removeComponent)
+			{
+				RecordComponentCommand<T>(history, scene, entity, &component, nullptr);
 				entity.RemoveComponent<T>();
+			}
 		}
 	}
 
 	void SceneHierarchyPanel::DrawComponents(Entity entity)
 	{
-		if (entity.HasComponent<TagComponent>())
+		if (entity.HasEffectiveComponent<TagComponent>())
 		{
-			auto& tag = entity.GetComponent<TagComponent>().Tag;
+			const auto& tag = entity.GetEffectiveComponent<TagComponent>().Tag;
 
 			char buffer[256];
 			memset(buffer, 0, sizeof(buffer));
 			std::strncpy(buffer, tag.c_str(), sizeof(buffer));
 			if (ImGui::InputText("##Tag", buffer, sizeof(buffer)))
 			{
-				tag = std::string(buffer);
+				bool owned = entity.HasComponent<TagComponent>();
+				TagComponent before = entity.GetEffectiveComponent<TagComponent>();
+
+				entity.OverrideComponent<TagComponent>();
+				entity.PatchComponent<TagComponent>([&](TagComponent& component) { component.Tag = std::string(buffer); });
+				RecordComponentCommand<TagComponent>(m_CommandHistory, m_Context, entity, owned ? &before : nullptr, &entity.GetComponent<TagComponent>(), true);
 			}
 		}
 
@@ -232,7 +525,7 @@ namespace Dymatic {
 			if (ImGui::MenuItem("Camera"))
 			{
 				if (!m_SelectionContext.HasComponent<CameraComponent>())
-					m_SelectionContext.AddComponent<CameraComponent>();
+					RecordComponentCommand<CameraComponent>(m_CommandHistory, m_Context, m_SelectionContext, nullptr, &m_SelectionContext.AddComponent<CameraComponent>());
 				else
 					DY_CORE_WARN("This entity already has the Camera Component!");
 				ImGui::CloseCurrentPopup();
@@ -241,27 +534,39 @@ namespace Dymatic {
 			if (ImGui::MenuItem("Sprite Renderer"))
 			{
 				if (!m_SelectionContext.HasComponent<SpriteRendererComponent>())
-					m_SelectionContext.AddComponent<SpriteRendererComponent>();
+					RecordComponentCommand<SpriteRendererComponent>(m_CommandHistory, m_Context, m_SelectionContext, nullptr, &m_SelectionContext.AddComponent<SpriteRendererComponent>());
 				else
 					DY_CORE_WARN("This entity already has the Sprite Renderer Component!");
 				ImGui::CloseCurrentPopup();
 			}
 
+			if (ImGui::MenuItem("Particle Emitter"))
+			{
+				if (!m_SelectionContext.HasComponent<ParticleEmitterComponent>())
+					RecordComponentCommand<ParticleEmitterComponent>(m_CommandHistory, m_Context, m_SelectionContext, nullptr, &m_SelectionContext.AddComponent<ParticleEmitterComponent>());
+				else
+					DY_CORE_WARN("This entity already has the Particle Emitter Component!");
+				ImGui::CloseCurrentPopup();
+			}
+
 			ImGui::EndPopup();
 		}
 
 		ImGui::PopItemWidth();
 
-		DrawComponent<TransformComponent>("Transform", entity, [](auto& component)
+		DrawComponent<TransformComponent>("Transform", entity, m_Context, m_CommandHistory, [](auto& component)
 		{
 			DrawVec3Control("Translation", component.Translation);
+			// Only write back on change, the degree round trip is not exact and would show up as an edit
 			glm::vec3 rotation = glm::degrees(component.Rotation);
+			glm::vec3 previousRotation = rotation;
 			DrawVec3Control("Rotation", rotation);
-			component.Rotation = glm::radians(rotation);
+			if (rotation != previousRotation)
+				component.Rotation = glm::radians(rotation);
 			DrawVec3Control("Scale", component.Scale, 1.0f);
 		});
 
-		DrawComponent<CameraComponent>("Camera", entity, [](auto& component)
+		DrawComponent<CameraComponent>("Camera", entity, m_Context, m_CommandHistory, [](auto& component)
 		{
 			auto& camera = component.Camera;
 
@@ -320,11 +625,34 @@ namespace Dymatic {
 			}
 		});
 
-		DrawComponent<SpriteRendererComponent>("Sprite Renderer", entity, [](auto& component)
+		DrawComponent<SpriteRendererComponent>("Sprite Renderer", entity, m_Context, m_CommandHistory, [](auto& component)
 		{
 			ImGui::ColorEdit4("Color", glm::value_ptr(component.Color));
 		});
 
+		DrawComponent<ParticleEmitterComponent>("Particle Emitter", entity, m_Context, m_CommandHistory, [](auto& component)
+		{
+			auto& props = component.Props;
+
+			ImGui::DragFloat("Emission Rate", &component.EmissionRate, 1.0f, 0.0f, 1000000.0f);
+			ImGui::DragScalar("Max Particles", ImGuiDataType_U32, &component.MaxParticles, 100.0f);
+			ImGui::DragFloat("Life Time", &props.LifeTime, 0.01f, 0.01f, 100.0f);
+
+			ImGui::DragFloat2("Velocity", glm::value_ptr(props.Velocity), 0.01f);
+			ImGui::DragFloat2("Velocity Variation", glm::value_ptr(props.VelocityVariation), 0.01f);
+			ImGui::DragFloat("Angular Velocity", &props.AngularVelocity, 0.01f);
+
+			ImGui::DragFloat("Size Begin", &props.SizeBegin, 0.01f, 0.0f, 100.0f);
+			ImGui::DragFloat("Size End", &props.SizeEnd, 0.01f, 0.0f, 100.0f);
+			ImGui::DragFloat("Size Variation", &props.SizeVariation, 0.01f, 0.0f, 100.0f);
+
+			ImGui::ColorEdit4("Color Begin", glm::value_ptr(props.ColorBegin));
+			ImGui::ColorEdit4("Color End", glm::value_ptr(props.ColorEnd));
+
+			if (component.System)
+				ImGui::Text("Live Particles: %d", component.System->GetParticleCount());
+		});
+
 	}
 
 }
\ No newline at end of file
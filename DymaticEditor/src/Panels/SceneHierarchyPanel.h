@@ -4,25 +4,71 @@
 #include "Dymatic/Scene/Scene.h"
 #include "Dymatic/Scene/Entity.h"
 
+#include "EntityNameIndex.h"
+
+#include <unordered_map>
+#include <vector>
+
 namespace Dymatic {
 
+	class CommandHistory;
+
 	class SceneHierarchyPanel
 	{
 	public:
 		SceneHierarchyPanel() = default;
 		SceneHierarchyPanel(const Ref<Scene>& scene);
+		~SceneHierarchyPanel();
+
+		// Registry signals are bound to this panel
+		SceneHierarchyPanel(const SceneHierarchyPanel&) = delete;
+		SceneHierarchyPanel& operator=(const SceneHierarchyPanel&) = delete;
 
 		void SetContext(const Ref<Scene>& scene);
+		// Component edits are recorded here, nothing is recorded while this is null
+		void SetCommandHistory(CommandHistory* history) { m_CommandHistory = history; }
 
 		void OnImGuiRender();
 
 		Entity GetSelectedEntity() const { return m_SelectionContext; }
+		void SetSelectedEntity(Entity entity) { m_SelectionContext = entity; }
 	private:
+		void OnEntityChanged(entt::registry&, entt::entity entity);
+		void ConnectSignals();
+		void DisconnectSignals();
+
+		void RebuildRows();
+		void UpdateRows();
+		void UpdateVisibleRows();
+
 		void DrawEntityNode(Entity entity);
 		void DrawComponents(Entity entity);
 	private:
 		Ref<Scene> m_Context;
 		Entity m_SelectionContext;
+		CommandHistory* m_CommandHistory = nullptr;
+
+		// One row per entity, kept up to date from registry signals instead of walking the
+		// registry every frame. Destroyed entities leave a null row until the rows are compacted.
+		struct Row
+		{
+			entt::entity Handle;
+			uint32_t NameID;
+		};
+
+		std::vector<Row> m_Rows;
+		std::unordered_map<entt::entity, uint32_t> m_RowLookup;
+		uint32_t m_DeadRows = 0;
+		// Entities that were created, destroyed or renamed since the last frame
+		std::vector<entt::entity> m_PendingEntities;
+
+		EntityNameIndex m_NameIndex;
+		std::vector<bool> m_NameMatches;
+		char m_SearchBuffer[256] = {};
+
+		// Indices into m_Rows that pass the search, rebuilt only when rows or the search change
+		std::vector<uint32_t> m_VisibleRows;
+		bool m_VisibleRowsDirty = true;
 	};
 
 }
\ No newline at end of file
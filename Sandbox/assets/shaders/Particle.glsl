@@ -0,0 +1,62 @@
+// Draws one instance per GPUParticleSystem slot, dead particles are moved outside the clip volume
+
+#type vertex
+#version 450 core
+
+layout(location = 0) in vec2 a_Corner;
+
+layout(std140, binding = 0) uniform Camera
+{
+	mat4 u_ViewProjection;
+};
+
+struct Particle
+{
+	vec4 Color;
+	vec4 ColorRate;
+	vec2 Position;
+	vec2 Velocity;
+	float Rotation;
+	float AngularVelocity;
+	float Life;
+	float Size;
+	float SizeRate;
+};
+
+layout(std430, binding = 0) readonly buffer Particles
+{
+	Particle u_Particles[];
+};
+
+uniform float u_Depth;
+
+out vec4 v_Color;
+
+void main()
+{
+	Particle particle = u_Particles[gl_InstanceID];
+	if (particle.Life <= 0.0)
+	{
+		v_Color = vec4(0.0);
+		gl_Position = vec4(2.0, 2.0, 2.0, 1.0);
+		return;
+	}
+
+	float c = cos(particle.Rotation), s = sin(particle.Rotation);
+	vec2 offset = mat2(c, s, -s, c) * (a_Corner * particle.Size);
+
+	v_Color = particle.Color;
+	gl_Position = u_ViewProjection * vec4(particle.Position + offset, u_Depth, 1.0);
+}
+
+#type fragment
+#version 450 core
+
+layout(location = 0) out vec4 color;
+
+in vec4 v_Color;
+
+void main()
+{
+	color = v_Color;
+}
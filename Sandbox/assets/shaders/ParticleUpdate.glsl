@@ -0,0 +1,46 @@
+// Advances every live particle of a GPUParticleSystem, GPUParticleSystem::Simulate is the CPU reference
+
+#type compute
+#version 450 core
+
+layout(local_size_x = 256) in;
+
+struct Particle
+{
+	vec4 Color;
+	vec4 ColorRate;
+	vec2 Position;
+	vec2 Velocity;
+	float Rotation;
+	float AngularVelocity;
+	float Life;
+	float Size;
+	float SizeRate;
+};
+
+layout(std430, binding = 0) buffer Particles
+{
+	Particle u_Particles[];
+};
+
+uniform float u_DeltaTime;
+uniform int u_Count;
+
+void main()
+{
+	int index = int(gl_GlobalInvocationID.x);
+	if (index >= u_Count)
+		return;
+
+	Particle particle = u_Particles[index];
+	if (particle.Life <= 0.0)
+		return;
+
+	particle.Life -= u_DeltaTime;
+	particle.Position += particle.Velocity * u_DeltaTime;
+	particle.Rotation += particle.AngularVelocity * u_DeltaTime;
+	particle.Size += particle.SizeRate * u_DeltaTime;
+	particle.Color += particle.ColorRate * u_DeltaTime;
+
+	u_Particles[index] = particle;
+}
@@ -30,6 +30,20 @@ project "Sandbox"
 	filter "system:windows"
 		systemversion "latest"
 
+	filter "system:linux"
+		-- Static libraries do not carry their dependencies on Linux, the executable has to list them
+		links
+		{
+			"GLFW",
+			"Glad",
+			"ImGui",
+			"yaml-cpp",
+			"GL",
+			"X11",
+			"pthread",
+			"dl"
+		}
+
 	filter "configurations:Debug"
 		defines "DY_DEBUG"
 		runtime "Debug"
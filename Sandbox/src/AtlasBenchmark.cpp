@@ -0,0 +1,106 @@
+#include "AtlasBenchmark.h"
+
+#include <imgui/imgui.h>
+
+#include <random>
+
+AtlasBenchmark::AtlasBenchmark()
+	: Layer("AtlasBenchmark"), m_CameraController(1280.0f / 720.0f)
+{
+}
+
+void AtlasBenchmark::OnAttach()
+{
+	DY_PROFILE_FUNCTION();
+
+	std::mt19937 random(1234);
+	std::uniform_int_distribution<uint32_t> sizeDistribution(8, 48);
+	std::uniform_int_distribution<uint32_t> colorDistribution(0, 255);
+
+	m_Atlas = Dymatic::TextureAtlas::Create();
+
+	float atlasMillis = 0.0f;
+	std::vector<uint32_t> pixels;
+	for (uint32_t i = 0; i < SpriteCount; i++)
+	{
+		// Every sprite gets its own size, colors and stripe pattern
+		uint32_t width = sizeDistribution(random), height = sizeDistribution(random);
+		uint32_t colorA = 0xff000000 | (colorDistribution(random) << 16) | (colorDistribution(random) << 8) | colorDistribution(random);
+		uint32_t colorB = 0xff000000 | (colorDistribution(random) << 16) | (colorDistribution(random) << 8) | colorDistribution(random);
+		uint32_t stripe = 1 + i % 7;
+
+		pixels.resize(width * height);
+		for (uint32_t y = 0; y < height; y++)
+			for (uint32_t x = 0; x < width; x++)
+				pixels[y * width + x] = ((x + y) / stripe) % 2 ? colorA : colorB;
+
+		auto texture = Dymatic::Texture2D::Create(width, height);
+		texture->SetData(pixels.data(), width * height * 4);
+		m_Textures.push_back(texture);
+
+		Dymatic::Timer timer;
+		m_Sprites.push_back(m_Atlas->Add(pixels.data(), width, height));
+		atlasMillis += timer.ElapsedMillis();
+	}
+	m_AtlasBuildMillis = atlasMillis;
+
+	DY_INFO("Packed {0} sprites into {1} atlas pages in {2}ms, occupancy {3}%", SpriteCount, m_Atlas->GetPageCount(), m_AtlasBuildMillis, m_Atlas->GetOccupancy() * 100.0f);
+}
+
+void AtlasBenchmark::OnDetach()
+{
+	DY_PROFILE_FUNCTION();
+
+	m_Sprites.clear();
+	m_Textures.clear();
+	m_Atlas = nullptr;
+}
+
+void AtlasBenchmark::OnUpdate(Dymatic::Timestep ts)
+{
+	DY_PROFILE_FUNCTION();
+
+	m_CameraController.OnUpdate(ts);
+
+	Dymatic::Renderer2D::ResetStats();
+	Dymatic::RenderCommand::SetClearColor({ 0.1f, 0.1f, 0.1f, 1 });
+	Dymatic::RenderCommand::Clear();
+
+	const uint32_t columns = 40;
+	const float spacing = 0.1f;
+	Dymatic::Renderer2D::BeginScene(m_CameraController.GetCamera());
+	for (uint32_t i = 0; i < SpriteCount; i++)
+	{
+		glm::vec2 position = { -2.0f + (i % columns) * spacing, 1.2f - (i / columns) * spacing };
+		if (m_UseAtlas)
+			Dymatic::Renderer2D::DrawQuad(position, { 0.09f, 0.09f }, m_Sprites[i]);
+		else
+			Dymatic::Renderer2D::DrawQuad(position, { 0.09f, 0.09f }, m_Textures[i]);
+	}
+	Dymatic::Renderer2D::EndScene();
+
+	(m_UseAtlas ? m_AtlasDrawCalls : m_SeparateDrawCalls) = Dymatic::Renderer2D::GetStats().DrawCalls;
+}
+
+void AtlasBenchmark::OnImGuiRender()
+{
+	DY_PROFILE_FUNCTION();
+
+	ImGui::Begin("Atlas Benchmark");
+	ImGui::Checkbox("Use Atlas", &m_UseAtlas);
+	ImGui::Text("Sprites: %d", SpriteCount);
+	ImGui::Text("Draw Calls (separate textures): %d", m_SeparateDrawCalls);
+	ImGui::Text("Draw Calls (atlas): %d", m_AtlasDrawCalls);
+	ImGui::Separator();
+	ImGui::Text("Atlas Pages: %d", m_Atlas->GetPageCount());
+	ImGui::Text("Atlas Occupancy: %.1f%%", m_Atlas->GetOccupancy() * 100.0f);
+	ImGui::Text("Atlas Build: %.2fms", m_AtlasBuildMillis);
+	if (ImGui::Button("Repack"))
+		m_Atlas->Repack();
+	ImGui::End();
+}
+
+void AtlasBenchmark::OnEvent(Dymatic::Event& e)
+{
+	m_CameraController.OnEvent(e);
+}
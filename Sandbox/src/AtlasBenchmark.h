@@ -0,0 +1,31 @@
+#pragma once
+
+#include "Dymatic.h"
+
+// Draws 1,000 distinct generated sprites either as separate textures or packed into a
+// TextureAtlas and reports draw calls and atlas occupancy for both.
+class AtlasBenchmark : public Dymatic::Layer
+{
+public:
+	AtlasBenchmark();
+	virtual ~AtlasBenchmark() = default;
+
+	virtual void OnAttach() override;
+	virtual void OnDetach() override;
+
+	void OnUpdate(Dymatic::Timestep ts) override;
+	virtual void OnImGuiRender() override;
+	void OnEvent(Dymatic::Event& e) override;
+private:
+	Dymatic::OrthographicCameraController m_CameraController;
+
+	static const uint32_t SpriteCount = 1000;
+
+	std::vector<Dymatic::Ref<Dymatic::Texture2D>> m_Textures;
+	Dymatic::Ref<Dymatic::TextureAtlas> m_Atlas;
+	std::vector<Dymatic::Ref<Dymatic::SubTexture2D>> m_Sprites;
+
+	bool m_UseAtlas = true;
+	uint32_t m_SeparateDrawCalls = 0, m_AtlasDrawCalls = 0;
+	float m_AtlasBuildMillis = 0.0f;
+};
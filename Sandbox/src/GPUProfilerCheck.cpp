@@ -0,0 +1,40 @@
+#include "GPUProfilerCheck.h"
+
+#include "Dymatic/Renderer/GPUProfiler.h"
+#include "Dymatic/Renderer/RenderCommand.h"
+
+#include <cstring>
+
+static const char* s_ScopeNames[] = { "Renderer2D::Flush", "Framebuffer Pass" };
+
+bool GPUProfilerCheck::Run()
+{
+	Dymatic::RendererAPI::API previousAPI = Dymatic::RendererAPI::GetAPI();
+	Dymatic::RenderCommand::SetAPI(Dymatic::RendererAPI::API::None);
+	Dymatic::GPUProfiler::Init();
+
+	// Results of a frame are read when BeginFrame comes back to its slot, frames in flight later
+	bool resolved = false;
+	for (int frame = 0; frame < 8 && !resolved; frame++)
+	{
+		Dymatic::GPUProfiler::BeginFrame();
+		resolved = !Dymatic::GPUProfiler::GetResults().empty();
+
+		for (const char* name : s_ScopeNames)
+			Dymatic::GPUProfilerScope scope(name);
+	}
+
+	const auto& results = Dymatic::GPUProfiler::GetResults();
+	bool passed = resolved && results.size() == 2;
+	for (size_t i = 0; passed && i < results.size(); i++)
+		passed = std::strcmp(results[i].Name, s_ScopeNames[i]) == 0 && results[i].Milliseconds == 0.0f;
+
+	if (passed)
+		DY_INFO("GPUProfiler check passed, {0} scopes resolved on the null backend", results.size());
+	else
+		DY_ERROR("GPUProfiler check failed, {0} scopes resolved on the null backend", results.size());
+
+	Dymatic::GPUProfiler::Shutdown();
+	Dymatic::RenderCommand::SetAPI(previousAPI);
+	return passed;
+}
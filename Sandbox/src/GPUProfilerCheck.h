@@ -0,0 +1,12 @@
+#pragma once
+
+#include "Dymatic.h"
+
+// Runs GPUProfiler on the null renderer backend, so it needs no window or context. Records two
+// scopes per frame until the query ring wraps, then checks that the oldest frame resolves with
+// every scope named and timed at zero. Must run before the application initializes the renderer.
+class GPUProfilerCheck
+{
+public:
+	static bool Run();
+};
@@ -0,0 +1,100 @@
+#include "LogBenchmark.h"
+
+#include "Dymatic/Scene/SceneSerializer.h"
+
+#include <imgui/imgui.h>
+
+#include <filesystem>
+
+static const char* s_ModeNames[] = { "Synchronous", "Async", "Async Binary" };
+
+LogBenchmark::LogBenchmark()
+	: Layer("LogBenchmark")
+{
+}
+
+void LogBenchmark::OnAttach()
+{
+	DY_PROFILE_FUNCTION();
+
+	if (std::filesystem::exists(m_ScenePath))
+		return;
+
+	Dymatic::Ref<Dymatic::Scene> scene = Dymatic::CreateRef<Dymatic::Scene>();
+	for (uint32_t i = 0; i < EntityCount; i++)
+	{
+		Dymatic::Entity entity = scene->CreateEntity("Entity " + std::to_string(i));
+		entity.GetComponent<Dymatic::TransformComponent>().Translation = { (float)(i % 1000), (float)(i / 1000), 0.0f };
+	}
+
+	std::filesystem::create_directories(std::filesystem::path(m_ScenePath).parent_path());
+	Dymatic::SceneSerializer serializer(scene);
+	serializer.Serialize(m_ScenePath);
+}
+
+void LogBenchmark::Run()
+{
+	DY_PROFILE_FUNCTION();
+
+	Dymatic::Timer timer;
+	Dymatic::Ref<Dymatic::Scene> scene = Dymatic::CreateRef<Dymatic::Scene>();
+	Dymatic::SceneSerializer serializer(scene);
+	serializer.Deserialize(m_ScenePath);
+	m_DeserializeMillis = timer.ElapsedMillis();
+
+	// The arguments SceneSerializer::Deserialize traces for each entity
+	std::vector<uint64_t> ids(EntityCount);
+	std::vector<std::string> names(EntityCount);
+	for (uint32_t i = 0; i < EntityCount; i++)
+	{
+		ids[i] = Dymatic::UUID();
+		names[i] = "Entity " + std::to_string(i);
+	}
+
+	for (int mode = 0; mode < 3; mode++)
+	{
+		Dymatic::Ref<spdlog::logger> logger = Dymatic::Log::CreateLogger("Benchmark", (Dymatic::LogMode)mode, m_LogPath, false);
+		Result& result = m_Results[mode];
+
+		timer.Reset();
+		for (uint32_t i = 0; i < EntityCount; i++)
+			logger->trace("Deserialized entity with ID = {0}, name = {1}", ids[i], names[i]);
+		result.TraceMillis = timer.ElapsedMillis();
+		logger->flush();
+		result.TraceWrittenMillis = timer.ElapsedMillis();
+
+		timer.Reset();
+		for (uint32_t i = 0; i < EntityCount; i++)
+			DY_LOG_RATE_LIMITED(logger, spdlog::level::trace, 100, "Deserialized entity with ID = {0}, name = {1}", ids[i], names[i]);
+		result.LimitedMillis = timer.ElapsedMillis();
+		logger->flush();
+		result.LimitedWrittenMillis = timer.ElapsedMillis();
+	}
+
+	for (int mode = 0; mode < 3; mode++)
+	{
+		const Result& result = m_Results[mode];
+		DY_INFO("{0}: {1} entity traces {2}ms ({3}ms until written), rate limited {4}ms ({5}ms until written)", s_ModeNames[mode], EntityCount,
+			result.TraceMillis, result.TraceWrittenMillis, result.LimitedMillis, result.LimitedWrittenMillis);
+	}
+	DY_INFO("Deserialize with rate limited entity traces: {0}ms", m_DeserializeMillis);
+}
+
+void LogBenchmark::OnImGuiRender()
+{
+	DY_PROFILE_FUNCTION();
+
+	ImGui::Begin("Log Benchmark");
+	ImGui::Text("Scene: %d entities, one trace each", EntityCount);
+	if (ImGui::Button("Run"))
+		Run();
+
+	ImGui::Text("Deserialize with rate limited traces: %.2fms", m_DeserializeMillis);
+	for (int mode = 0; mode < 3; mode++)
+	{
+		const Result& result = m_Results[mode];
+		ImGui::Text("%s: traces %.2fms (%.2fms until written), rate limited %.2fms (%.2fms)", s_ModeNames[mode],
+			result.TraceMillis, result.TraceWrittenMillis, result.LimitedMillis, result.LimitedWrittenMillis);
+	}
+	ImGui::End();
+}
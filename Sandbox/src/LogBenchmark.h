@@ -0,0 +1,35 @@
+#pragma once
+
+#include "Dymatic.h"
+
+// Deserializes a 100,000 entity scene, then logs one trace per entity with a benchmark logger in
+// each LogMode. The traces run unthrottled, as SceneSerializer::Deserialize logged them before,
+// and through the rate limit it uses now. Reports the time spent on the calling thread and until
+// everything was written. The engine loggers are left alone, other threads keep logging to them.
+class LogBenchmark : public Dymatic::Layer
+{
+public:
+	LogBenchmark();
+	virtual ~LogBenchmark() = default;
+
+	virtual void OnAttach() override;
+
+	virtual void OnImGuiRender() override;
+private:
+	void Run();
+private:
+	static const uint32_t EntityCount = 100000;
+
+	struct Result
+	{
+		float TraceMillis = 0.0f;
+		float TraceWrittenMillis = 0.0f;
+		float LimitedMillis = 0.0f;
+		float LimitedWrittenMillis = 0.0f;
+	};
+
+	std::string m_ScenePath = "assets/cache/LogBenchmark.dymatic";
+	std::string m_LogPath = "assets/cache/LogBenchmark";
+	float m_DeserializeMillis = 0.0f;
+	Result m_Results[3];
+};
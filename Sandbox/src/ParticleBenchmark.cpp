@@ -0,0 +1,230 @@
+#include "ParticleBenchmark.h"
+
+#include <imgui/imgui.h>
+
+static const char* s_ModeNames[] = { "Engine", "Sandbox", "GPU" };
+
+ParticleBenchmark::ParticleBenchmark()
+	: Layer("ParticleBenchmark"), m_CameraController(1280.0f / 720.0f)
+{
+}
+
+void ParticleBenchmark::OnAttach()
+{
+	DY_PROFILE_FUNCTION();
+
+	m_EngineSystem = Dymatic::CreateScope<Dymatic::ParticleSystem>(ParticleCount);
+	m_SandboxSystem = Dymatic::CreateScope<ParticleSystem>(ParticleCount);
+	m_GPUSystem = Dymatic::CreateScope<Dymatic::GPUParticleSystem>(ParticleCount);
+
+	m_Props.ColorBegin = { 254 / 255.0f, 212 / 255.0f, 123 / 255.0f, 1.0f };
+	m_Props.ColorEnd = { 254 / 255.0f, 109 / 255.0f, 41 / 255.0f, 0.0f };
+	m_Props.SizeBegin = 0.05f, m_Props.SizeVariation = 0.03f, m_Props.SizeEnd = 0.0f;
+	m_Props.LifeTime = 2.0f;
+	m_Props.Velocity = { 0.0f, 0.0f };
+	m_Props.VelocityVariation = { 3.0f, 3.0f };
+	m_Props.AngularVelocity = 1.0f;
+	m_Props.Position = { 0.0f, 0.0f };
+
+	VerifyReference();
+}
+
+void ParticleBenchmark::OnDetach()
+{
+	DY_PROFILE_FUNCTION();
+
+	m_EngineSystem = nullptr;
+	m_SandboxSystem = nullptr;
+	m_GPUSystem = nullptr;
+}
+
+void ParticleBenchmark::OnUpdate(Dymatic::Timestep ts)
+{
+	DY_PROFILE_FUNCTION();
+
+	m_CameraController.OnUpdate(ts);
+
+	Dymatic::Renderer2D::ResetStats();
+	Dymatic::RenderCommand::SetClearColor({ 0.1f, 0.1f, 0.1f, 1 });
+	Dymatic::RenderCommand::Clear();
+
+	// Emit at the rate that keeps ParticleCount alive once the first lifetime has passed
+	float emit = ParticleCount * ts / m_Props.LifeTime + m_EmitRemainder;
+	uint32_t emitCount = (uint32_t)emit;
+	m_EmitRemainder = emit - emitCount;
+
+	Result& result = m_Results[(int)m_Mode];
+	float updateMillis, renderMillis;
+	if (m_Mode == Mode::Engine)
+	{
+		Dymatic::Timer timer;
+		m_EngineSystem->Emit(m_Props, emitCount);
+		m_EngineSystem->OnUpdate(ts);
+		updateMillis = timer.ElapsedMillis();
+
+		timer.Reset();
+		Dymatic::Renderer2D::BeginScene(m_CameraController.GetCamera());
+		m_EngineSystem->OnRender(0.2f);
+		Dymatic::Renderer2D::EndScene();
+		renderMillis = timer.ElapsedMillis();
+	}
+	else if (m_Mode == Mode::GPU)
+	{
+		// Only measures issuing the work, the GPU side shows up in the GPU profiler
+		Dymatic::Timer timer;
+		m_GPUSystem->Emit(m_Props, emitCount);
+		m_GPUSystem->OnUpdate(ts);
+		updateMillis = timer.ElapsedMillis();
+
+		timer.Reset();
+		Dymatic::Renderer2D::BeginScene(m_CameraController.GetCamera());
+		if (m_GPUSystem->IsUsingCompute())
+		{
+			Dymatic::Renderer2D::EndScene();
+			m_GPUSystem->OnRender(0.2f);
+		}
+		else
+		{
+			m_GPUSystem->OnRender(0.2f);
+			Dymatic::Renderer2D::EndScene();
+		}
+		renderMillis = timer.ElapsedMillis();
+	}
+	else
+	{
+		::ParticleProps props;
+		props.Position = m_Props.Position;
+		props.Velocity = m_Props.Velocity, props.VelocityVariation = m_Props.VelocityVariation;
+		props.ColorBegin = m_Props.ColorBegin, props.ColorEnd = m_Props.ColorEnd;
+		props.SizeBegin = m_Props.SizeBegin, props.SizeEnd = m_Props.SizeEnd, props.SizeVariation = m_Props.SizeVariation;
+		props.LifeTime = m_Props.LifeTime;
+
+		Dymatic::Timer timer;
+		for (uint32_t i = 0; i < emitCount; i++)
+			m_SandboxSystem->Emit(props);
+		m_SandboxSystem->OnUpdate(ts);
+		updateMillis = timer.ElapsedMillis();
+
+		timer.Reset();
+		m_SandboxSystem->OnRender(m_CameraController.GetCamera());
+		renderMillis = timer.ElapsedMillis();
+	}
+
+	// Smooth the readout, single frames vary too much to compare
+	result.UpdateMillis = glm::mix(result.UpdateMillis, updateMillis, 0.05f);
+	result.RenderMillis = glm::mix(result.RenderMillis, renderMillis, 0.05f);
+}
+
+void ParticleBenchmark::OnImGuiRender()
+{
+	DY_PROFILE_FUNCTION();
+
+	ImGui::Begin("Particle Benchmark");
+	for (int i = 0; i < 3; i++)
+	{
+		if (ImGui::RadioButton(s_ModeNames[i], m_Mode == (Mode)i))
+			m_Mode = (Mode)i;
+		ImGui::SameLine();
+	}
+	ImGui::NewLine();
+	ImGui::Text("Live Particles (engine): %d", m_EngineSystem->GetParticleCount());
+	ImGui::Text("Quads Drawn: %d", Dymatic::Renderer2D::GetStats().QuadCount);
+	ImGui::Separator();
+	for (int i = 0; i < 3; i++)
+		ImGui::Text("%s: update %.2fms, render %.2fms", s_ModeNames[i], m_Results[i].UpdateMillis, m_Results[i].RenderMillis);
+	ImGui::Separator();
+	ImGui::Text("GPU System: %s", m_GPUSystem->IsUsingCompute() ? "compute shader" : "CPU fallback");
+	ImGui::Text("CPU Reference vs Engine: max difference %g", m_ReferenceMaxError);
+	if (m_GPUSystem->IsUsingCompute())
+	{
+		if (ImGui::Button("Verify Compute Against CPU Reference"))
+			VerifyCompute();
+		if (m_Verified)
+			ImGui::Text("Compute Max Difference: %g", m_VerifyMaxError);
+	}
+	ImGui::End();
+}
+
+static float MaxDifference(const Dymatic::GPUParticle& a, const Dymatic::ParticleState& b)
+{
+	float error = glm::max(glm::abs(a.Life - b.Life), glm::abs(a.Rotation - b.Rotation));
+	error = glm::max(error, glm::abs(a.Size - b.Size));
+	error = glm::max(error, glm::max(glm::abs(a.Position.x - b.Position.x), glm::abs(a.Position.y - b.Position.y)));
+	error = glm::max(error, glm::max(glm::abs(a.Velocity.x - b.Velocity.x), glm::abs(a.Velocity.y - b.Velocity.y)));
+	for (int channel = 0; channel < 4; channel++)
+		error = glm::max(error, glm::abs(a.Color[channel] - b.Color[channel]));
+	return error;
+}
+
+void ParticleBenchmark::VerifyReference()
+{
+	DY_PROFILE_FUNCTION();
+
+	// Runs GPUParticleSystem's CPU path, which creates no GPU resources, next to the engine's
+	// ParticleSystem with the same seed. Nothing dies within the simulated second, so both keep
+	// their particles in emission order and slot i of one is particle i of the other.
+	const uint32_t steps = 60, perStep = 100;
+	const float dt = 1.0f / 60.0f;
+
+	Dymatic::ParticleProps props = m_Props;
+	props.LifeTime = 2.0f;
+
+	Dymatic::GPUParticleSystem reference(steps * perStep, 7, false);
+	Dymatic::ParticleSystem engine(steps * perStep, 7);
+	for (uint32_t step = 0; step < steps; step++)
+	{
+		reference.Emit(props, perStep);
+		reference.OnUpdate(dt);
+		engine.Emit(props, perStep);
+		engine.OnUpdate(dt);
+	}
+
+	std::vector<Dymatic::GPUParticle> particles;
+	reference.GetParticles(particles);
+	DY_ASSERT(engine.GetParticleCount() == particles.size(), "Particles died during the reference check!");
+
+	float maxError = 0.0f;
+	for (uint32_t i = 0; i < engine.GetParticleCount(); i++)
+		maxError = glm::max(maxError, MaxDifference(particles[i], engine.GetParticle(i)));
+
+	m_ReferenceMaxError = maxError;
+	if (maxError > 1e-4f)
+		DY_ERROR("GPUParticleSystem::Simulate differs from ParticleSystem by {0}", maxError);
+	else
+		DY_INFO("GPUParticleSystem::Simulate matches ParticleSystem, max difference {0}", maxError);
+}
+
+void ParticleBenchmark::VerifyCompute()
+{
+	DY_PROFILE_FUNCTION();
+
+	// Advance the current GPU state by one step on both sides and compare every slot
+	const float dt = 1.0f / 60.0f;
+	std::vector<Dymatic::GPUParticle> expected, actual;
+	m_GPUSystem->GetParticles(expected);
+	m_GPUSystem->OnUpdate(dt);
+	m_GPUSystem->GetParticles(actual);
+	Dymatic::GPUParticleSystem::Simulate(expected.data(), (uint32_t)expected.size(), dt);
+
+	float maxError = 0.0f;
+	for (size_t i = 0; i < expected.size(); i++)
+	{
+		const auto& a = expected[i];
+		const auto& b = actual[i];
+		float error = glm::max(glm::abs(a.Life - b.Life), glm::abs(a.Rotation - b.Rotation));
+		error = glm::max(error, glm::abs(a.Size - b.Size));
+		error = glm::max(error, glm::max(glm::abs(a.Position.x - b.Position.x), glm::abs(a.Position.y - b.Position.y)));
+		for (int channel = 0; channel < 4; channel++)
+			error = glm::max(error, glm::abs(a.Color[channel] - b.Color[channel]));
+		maxError = glm::max(maxError, error);
+	}
+
+	m_Verified = true;
+	m_VerifyMaxError = maxError;
+	DY_INFO("GPU particle update differs from the CPU reference by at most {0}", maxError);
+}
+
+void ParticleBenchmark::OnEvent(Dymatic::Event& e)
+{
+	m_CameraController.OnEvent(e);
+}
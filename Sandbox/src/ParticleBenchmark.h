@@ -0,0 +1,51 @@
+#pragma once
+
+#include "Dymatic.h"
+
+#include "ParticleSystem.h"
+
+// Keeps 1,000,000 particles alive and compares the engine's Dymatic::ParticleSystem and
+// Dymatic::GPUParticleSystem with the array of structs ParticleSystem this Sandbox started out
+// with, timing update and submission. On attach the GPU system's CPU reference is checked against
+// the engine's ParticleSystem without touching the GPU, and the compute path can be checked
+// against that reference.
+class ParticleBenchmark : public Dymatic::Layer
+{
+public:
+	ParticleBenchmark();
+	virtual ~ParticleBenchmark() = default;
+
+	virtual void OnAttach() override;
+	virtual void OnDetach() override;
+
+	void OnUpdate(Dymatic::Timestep ts) override;
+	virtual void OnImGuiRender() override;
+	void OnEvent(Dymatic::Event& e) override;
+private:
+	void VerifyReference();
+	void VerifyCompute();
+private:
+	Dymatic::OrthographicCameraController m_CameraController;
+
+	static const uint32_t ParticleCount = 1000000;
+
+	struct Result
+	{
+		float UpdateMillis = 0.0f;
+		float RenderMillis = 0.0f;
+	};
+
+	Dymatic::Scope<Dymatic::ParticleSystem> m_EngineSystem;
+	Dymatic::Scope<ParticleSystem> m_SandboxSystem;
+	Dymatic::Scope<Dymatic::GPUParticleSystem> m_GPUSystem;
+	Dymatic::ParticleProps m_Props;
+
+	enum class Mode { Engine = 0, Sandbox = 1, GPU = 2 };
+	Mode m_Mode = Mode::Engine;
+	float m_EmitRemainder = 0.0f;
+	Result m_Results[3];
+
+	float m_ReferenceMaxError = 0.0f;
+	bool m_Verified = false;
+	float m_VerifyMaxError = 0.0f;
+};
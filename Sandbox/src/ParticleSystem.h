@@ -2,6 +2,8 @@
 
 #include <Dymatic.h>
 
+// Array of structs particle pool kept as the baseline for ParticleBenchmark, new code should use Dymatic::ParticleSystem
+
 struct ParticleProps
 {
 	glm::vec2 Position;
@@ -0,0 +1,100 @@
+#include "PickingBenchmark.h"
+
+#include <imgui/imgui.h>
+
+#include <random>
+
+PickingBenchmark::PickingBenchmark()
+	: Layer("PickingBenchmark")
+{
+}
+
+// Closest sprite under a ray travelling down the z axis, testing every sprite
+static Dymatic::Entity PickBruteForce(const std::vector<Dymatic::Entity>& sprites, const glm::vec2& point)
+{
+	Dymatic::Entity closest;
+	float closestZ = -std::numeric_limits<float>::max();
+
+	for (Dymatic::Entity sprite : sprites)
+	{
+		const auto& transform = sprite.GetComponent<Dymatic::TransformComponent>();
+		glm::vec4 local = glm::inverse(transform.GetTransform()) * glm::vec4(point, transform.Translation.z, 1.0f);
+		if (std::abs(local.x) <= 0.5f && std::abs(local.y) <= 0.5f && transform.Translation.z > closestZ)
+		{
+			closest = sprite;
+			closestZ = transform.Translation.z;
+		}
+	}
+	return closest;
+}
+
+void PickingBenchmark::Run()
+{
+	DY_PROFILE_FUNCTION();
+
+	const float worldSize = 1000.0f;
+
+	std::mt19937 random(1234);
+	std::uniform_real_distribution<float> position(0.0f, worldSize);
+	std::uniform_real_distribution<float> scale(0.5f, 4.0f);
+	std::uniform_real_distribution<float> angle(0.0f, glm::two_pi<float>());
+	std::uniform_real_distribution<float> depth(-1.0f, 1.0f);
+
+	Dymatic::Scene scene;
+	std::vector<Dymatic::Entity> sprites;
+	sprites.reserve(SpriteCount);
+	for (uint32_t i = 0; i < SpriteCount; i++)
+	{
+		Dymatic::Entity entity = scene.CreateEntity();
+		auto& transform = entity.GetComponent<Dymatic::TransformComponent>();
+		transform.Translation = { position(random), position(random), depth(random) };
+		transform.Rotation = { 0.0f, 0.0f, angle(random) };
+		transform.Scale = { scale(random), scale(random), 1.0f };
+		entity.AddComponent<Dymatic::SpriteRendererComponent>();
+		sprites.push_back(entity);
+	}
+
+	std::vector<glm::vec2> points(PickCount);
+	for (auto& point : points)
+		point = { position(random), position(random) };
+
+	Dymatic::SpriteGrid grid;
+	Dymatic::Timer timer;
+	grid.Build(&scene);
+	m_BuildMillis = timer.ElapsedMillis();
+
+	std::vector<Dymatic::Entity> gridHits(PickCount);
+	timer.Reset();
+	for (uint32_t i = 0; i < PickCount; i++)
+		gridHits[i] = grid.Raycast({ points[i], 10.0f }, { 0.0f, 0.0f, -1.0f });
+	m_GridMicros = timer.ElapsedMillis() * 1000.0f / PickCount;
+
+	std::vector<Dymatic::Entity> bruteForceHits(PickCount);
+	timer.Reset();
+	for (uint32_t i = 0; i < PickCount; i++)
+		bruteForceHits[i] = PickBruteForce(sprites, points[i]);
+	m_BruteForceMicros = timer.ElapsedMillis() * 1000.0f / PickCount;
+
+	m_Mismatches = 0;
+	for (uint32_t i = 0; i < PickCount; i++)
+		if (gridHits[i] != bruteForceHits[i])
+			m_Mismatches++;
+
+	DY_INFO("Sprite grid built in {0}ms, {1}us per pick, brute force {2}us per pick, {3} mismatches", m_BuildMillis, m_GridMicros, m_BruteForceMicros, m_Mismatches);
+}
+
+void PickingBenchmark::OnImGuiRender()
+{
+	DY_PROFILE_FUNCTION();
+
+	ImGui::Begin("Picking Benchmark");
+	ImGui::Text("%d sprites, %d picks", SpriteCount, PickCount);
+	if (ImGui::Button("Run"))
+		Run();
+
+	ImGui::Text("Grid build: %.2fms", m_BuildMillis);
+	ImGui::Text("Grid: %.2fus per pick", m_GridMicros);
+	ImGui::Text("Brute force: %.2fus per pick", m_BruteForceMicros);
+	ImGui::Text("Mismatches: %d", m_Mismatches);
+	ImGui::End();
+}
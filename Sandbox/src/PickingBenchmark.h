@@ -0,0 +1,24 @@
+#pragma once
+
+#include "Dymatic.h"
+
+// Scatters 100,000 sprites and picks random points straight down the z axis, once through a
+// SpriteGrid and once by testing every sprite, then compares the average time per pick.
+class PickingBenchmark : public Dymatic::Layer
+{
+public:
+	PickingBenchmark();
+	virtual ~PickingBenchmark() = default;
+
+	virtual void OnImGuiRender() override;
+private:
+	void Run();
+private:
+	static const uint32_t SpriteCount = 100000;
+	static const uint32_t PickCount = 1000;
+
+	float m_BuildMillis = 0.0f;
+	float m_GridMicros = 0.0f;
+	float m_BruteForceMicros = 0.0f;
+	uint32_t m_Mismatches = 0;
+};
@@ -0,0 +1,98 @@
+#include "PrefabBenchmark.h"
+
+#include "Dymatic/Scene/SceneSerializer.h"
+
+#include <imgui/imgui.h>
+
+#include <filesystem>
+
+static const char* s_ModeNames[] = { "Full Copies", "Prefab Instances" };
+
+PrefabBenchmark::PrefabBenchmark()
+	: Layer("PrefabBenchmark")
+{
+}
+
+// Components stored on the entity itself, anything shared through a prefab is not counted
+static size_t GetOwnedComponentBytes(Dymatic::Entity entity)
+{
+	size_t bytes = sizeof(Dymatic::IDComponent);
+	if (entity.HasComponent<Dymatic::TagComponent>())
+		bytes += sizeof(Dymatic::TagComponent) + entity.GetComponent<Dymatic::TagComponent>().Tag.capacity();
+	if (entity.HasComponent<Dymatic::TransformComponent>())
+		bytes += sizeof(Dymatic::TransformComponent);
+	if (entity.HasComponent<Dymatic::SpriteRendererComponent>())
+		bytes += sizeof(Dymatic::SpriteRendererComponent);
+	if (entity.HasComponent<Dymatic::PrefabInstanceComponent>())
+		bytes += sizeof(Dymatic::PrefabInstanceComponent);
+	return bytes;
+}
+
+void PrefabBenchmark::Run()
+{
+	DY_PROFILE_FUNCTION();
+
+	const std::string enemyName = "Enemy Grunt With A Long Descriptive Name";
+	const glm::vec4 enemyColor = { 0.8f, 0.2f, 0.3f, 1.0f };
+
+	std::vector<glm::vec3> translations(EnemyCount);
+	for (uint32_t i = 0; i < EnemyCount; i++)
+		translations[i] = { (float)(i % 100), (float)(i / 100), 0.0f };
+
+	std::filesystem::create_directories("assets/cache");
+
+	for (int mode = 0; mode < 2; mode++)
+	{
+		Result& result = m_Results[mode];
+		Dymatic::Ref<Dymatic::Scene> scene = Dymatic::CreateRef<Dymatic::Scene>();
+		std::vector<Dymatic::Entity> enemies;
+
+		Dymatic::Timer timer;
+		if (mode == 0)
+		{
+			enemies.reserve(EnemyCount);
+			for (uint32_t i = 0; i < EnemyCount; i++)
+			{
+				Dymatic::Entity enemy = scene->CreateEntity(enemyName);
+				enemy.GetComponent<Dymatic::TransformComponent>().Translation = translations[i];
+				enemy.AddComponent<Dymatic::SpriteRendererComponent>(enemyColor);
+				enemies.push_back(enemy);
+			}
+		}
+		else
+		{
+			Dymatic::Ref<Dymatic::Prefab> prefab = Dymatic::CreateRef<Dymatic::Prefab>(enemyName);
+			prefab->GetEntity().AddComponent<Dymatic::SpriteRendererComponent>(enemyColor);
+			enemies = scene->InstantiatePrefab(prefab, translations);
+		}
+		result.CreateMillis = timer.ElapsedMillis();
+
+		result.ComponentBytes = 0;
+		for (Dymatic::Entity enemy : enemies)
+			result.ComponentBytes += GetOwnedComponentBytes(enemy);
+
+		std::string path = std::string("assets/cache/PrefabBenchmark") + std::to_string(mode) + ".dymatic";
+		Dymatic::SceneSerializer serializer(scene);
+		serializer.Serialize(path);
+		result.FileBytes = (size_t)std::filesystem::file_size(path);
+
+		DY_INFO("{0}: created in {1}ms, {2} KB of components, {3} KB scene file", s_ModeNames[mode], result.CreateMillis, result.ComponentBytes / 1024, result.FileBytes / 1024);
+	}
+}
+
+void PrefabBenchmark::OnImGuiRender()
+{
+	DY_PROFILE_FUNCTION();
+
+	ImGui::Begin("Prefab Benchmark");
+	ImGui::Text("%d enemies", EnemyCount);
+	if (ImGui::Button("Run"))
+		Run();
+
+	for (int mode = 0; mode < 2; mode++)
+	{
+		const Result& result = m_Results[mode];
+		ImGui::Text("%s: created in %.2fms, components %.1f KB, scene file %.1f KB", s_ModeNames[mode], result.CreateMillis, result.ComponentBytes / 1024.0f, result.FileBytes / 1024.0f);
+	}
+	ImGui::End();
+}
@@ -0,0 +1,27 @@
+#pragma once
+
+#include "Dymatic.h"
+
+// Builds 10,000 identical enemies once as independent entities and once as instances of a
+// prefab, then compares the component memory they own and the size of the saved scene.
+class PrefabBenchmark : public Dymatic::Layer
+{
+public:
+	PrefabBenchmark();
+	virtual ~PrefabBenchmark() = default;
+
+	virtual void OnImGuiRender() override;
+private:
+	void Run();
+private:
+	static const uint32_t EnemyCount = 10000;
+
+	struct Result
+	{
+		float CreateMillis = 0.0f;
+		size_t ComponentBytes = 0;
+		size_t FileBytes = 0;
+	};
+
+	Result m_Results[2];
+};
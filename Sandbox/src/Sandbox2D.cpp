@@ -16,7 +16,7 @@ void Sandbox2D::OnAttach()
 {
 	DY_PROFILE_FUNCTION();
 
-	m_CheckerboardTexture = Dymatic::Texture2D::Create("assets/textures/Checkerboard.png");
+	m_CheckerboardTexture = Dymatic::AssetManager::GetTexture("assets/textures/Checkerboard.png");
 }
 
 void Sandbox2D::OnDetach()
@@ -2,8 +2,6 @@
 
 #include "Dymatic.h"
 
-#include "ParticleSystem.h"
-
 class Sandbox2D : public Dymatic::Layer
 {
 public:
@@ -27,6 +25,6 @@ private:
 
 	glm::vec4 m_SquareColor = { 0.2f, 0.3f, 0.8f, 1.0f };
 
-	ParticleSystem m_ParticleSystem;
-	ParticleProps m_Particle;
+	Dymatic::ParticleSystem m_ParticleSystem;
+	Dymatic::ParticleProps m_Particle;
 };
@@ -9,6 +9,15 @@
 #include "glm/gtc/type_ptr.hpp"
 
 #include "Sandbox2D.h"
+#include "TextureLoadBenchmark.h"
+#include "AtlasBenchmark.h"
+#include "ShaderCompileBenchmark.h"
+#include "LogBenchmark.h"
+#include "ParticleBenchmark.h"
+#include "SceneCopyBenchmark.h"
+#include "PrefabBenchmark.h"
+#include "PickingBenchmark.h"
+#include "GPUProfilerCheck.h"
 
 
 
@@ -143,8 +152,8 @@ public:
 
 		//asset files need to have ../../../Sandbox/ added to work externally (out of VS debug mode)
 
-		m_Texture = Dymatic::Texture2D::Create("assets/textures/Checkerboard.png");
-		m_DymaticLogoTexture = Dymatic::Texture2D::Create("assets/textures/DymaticLogo.png");
+		m_Texture = Dymatic::AssetManager::GetTexture("assets/textures/Checkerboard.png");
+		m_DymaticLogoTexture = Dymatic::AssetManager::GetTexture("assets/textures/DymaticLogo.png");
 			
 		std::dynamic_pointer_cast<Dymatic::OpenGLShader>(textureShader)->Bind();
 		std::dynamic_pointer_cast<Dymatic::OpenGLShader>(textureShader)->UploadUniformInt("u_Texture", 0);
@@ -224,6 +233,14 @@ public:
 	{
 		//PushLayer(new ExampleLayer());
 		PushLayer(new Sandbox2D());
+		//PushLayer(new TextureLoadBenchmark());
+		//PushLayer(new AtlasBenchmark());
+		//PushLayer(new ShaderCompileBenchmark());
+		//PushLayer(new LogBenchmark());
+		//PushLayer(new ParticleBenchmark());
+		//PushLayer(new SceneCopyBenchmark());
+		//PushLayer(new PrefabBenchmark());
+		//PushLayer(new PickingBenchmark());
 	}
 
 	~Sandbox()
@@ -235,5 +252,8 @@ public:
 
 Dymatic::Application* Dymatic::CreateApplication()
 {
+	// Headless checks run before the application initializes the renderer
+	//GPUProfilerCheck::Run();
+
 	return new Sandbox();
 }
\ No newline at end of file
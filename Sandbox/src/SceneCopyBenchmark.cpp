@@ -0,0 +1,100 @@
+#include "SceneCopyBenchmark.h"
+
+#include <imgui/imgui.h>
+
+const uint32_t SceneCopyBenchmark::EntityCounts[SceneCopyBenchmark::SizeCount] = { 1000, 10000, 100000 };
+
+SceneCopyBenchmark::SceneCopyBenchmark()
+	: Layer("SceneCopyBenchmark")
+{
+}
+
+static Dymatic::Ref<Dymatic::Scene> CreateBenchmarkScene(uint32_t entityCount)
+{
+	Dymatic::Ref<Dymatic::Scene> scene = Dymatic::CreateRef<Dymatic::Scene>();
+	for (uint32_t i = 0; i < entityCount; i++)
+	{
+		Dymatic::Entity entity = scene->CreateEntity("Entity " + std::to_string(i));
+		entity.GetComponent<Dymatic::TransformComponent>().Translation = { (float)(i % 1000), (float)(i / 1000), 0.0f };
+		entity.AddComponent<Dymatic::SpriteRendererComponent>(glm::vec4{ (i % 255) / 255.0f, 0.5f, 0.5f, 1.0f });
+	}
+
+	auto camera = scene->CreateEntity("Camera");
+	camera.AddComponent<Dymatic::CameraComponent>();
+	return scene;
+}
+
+// What play mode would do without Scene::Copy, every component is added one at a time
+static Dymatic::Ref<Dymatic::Scene> CopyPerEntity(Dymatic::Ref<Dymatic::Scene> scene, const std::vector<Dymatic::UUID>& ids)
+{
+	Dymatic::Ref<Dymatic::Scene> newScene = Dymatic::CreateRef<Dymatic::Scene>();
+	for (Dymatic::UUID id : ids)
+	{
+		Dymatic::Entity src = scene->GetEntityByUUID(id);
+		Dymatic::Entity dst = newScene->CreateEntityWithUUID(id, src.GetComponent<Dymatic::TagComponent>().Tag);
+		dst.GetComponent<Dymatic::TransformComponent>() = src.GetComponent<Dymatic::TransformComponent>();
+		if (src.HasComponent<Dymatic::SpriteRendererComponent>())
+			dst.AddComponent<Dymatic::SpriteRendererComponent>(src.GetComponent<Dymatic::SpriteRendererComponent>());
+		if (src.HasComponent<Dymatic::CameraComponent>())
+			dst.AddComponent<Dymatic::CameraComponent>(src.GetComponent<Dymatic::CameraComponent>());
+	}
+	return newScene;
+}
+
+void SceneCopyBenchmark::Run()
+{
+	DY_PROFILE_FUNCTION();
+
+	for (int size = 0; size < SizeCount; size++)
+	{
+		uint32_t entityCount = EntityCounts[size];
+		Dymatic::Ref<Dymatic::Scene> scene = CreateBenchmarkScene(entityCount);
+
+		std::vector<Dymatic::UUID> ids;
+		ids.reserve(entityCount + 1);
+		for (uint32_t i = 0; i <= entityCount; i++)
+			ids.push_back(Dymatic::Entity{ (entt::entity)i, scene.get() }.GetUUID());
+
+		Result& result = m_Results[size];
+
+		Dymatic::Timer timer;
+		Dymatic::Ref<Dymatic::Scene> bulkCopy = Dymatic::Scene::Copy(scene);
+		result.BulkMillis = timer.ElapsedMillis();
+
+		timer.Reset();
+		Dymatic::Ref<Dymatic::Scene> perEntityCopy = CopyPerEntity(scene, ids);
+		result.PerEntityMillis = timer.ElapsedMillis();
+
+		// Spot check that the bulk copy resolves every UUID to the same data
+		result.Matches = true;
+		for (uint32_t i = 0; i <= entityCount; i += 97)
+		{
+			Dymatic::Entity original = scene->GetEntityByUUID(ids[i]);
+			Dymatic::Entity copy = bulkCopy->GetEntityByUUID(ids[i]);
+			if (!copy || copy.GetComponent<Dymatic::TagComponent>().Tag != original.GetComponent<Dymatic::TagComponent>().Tag
+				|| copy.GetComponent<Dymatic::TransformComponent>().Translation != original.GetComponent<Dymatic::TransformComponent>().Translation)
+			{
+				result.Matches = false;
+				break;
+			}
+		}
+
+		DY_INFO("Scene copy, {0} entities: bulk {1}ms, per entity {2}ms", entityCount, result.BulkMillis, result.PerEntityMillis);
+	}
+}
+
+void SceneCopyBenchmark::OnImGuiRender()
+{
+	DY_PROFILE_FUNCTION();
+
+	ImGui::Begin("Scene Copy Benchmark");
+	if (ImGui::Button("Run"))
+		Run();
+
+	for (int size = 0; size < SizeCount; size++)
+	{
+		const Result& result = m_Results[size];
+		ImGui::Text("%d entities: bulk %.2fms, per entity %.2fms%s", EntityCounts[size], result.BulkMillis, result.PerEntityMillis, result.Matches ? "" : " (mismatch)");
+	}
+	ImGui::End();
+}
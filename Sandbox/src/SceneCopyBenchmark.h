@@ -0,0 +1,28 @@
+#pragma once
+
+#include "Dymatic.h"
+
+// Copies scenes of 1,000, 10,000 and 100,000 sprite entities with Scene::Copy, which clones
+// component pools in bulk, and with a per entity copy through Entity::AddComponent.
+class SceneCopyBenchmark : public Dymatic::Layer
+{
+public:
+	SceneCopyBenchmark();
+	virtual ~SceneCopyBenchmark() = default;
+
+	virtual void OnImGuiRender() override;
+private:
+	void Run();
+private:
+	static const int SizeCount = 3;
+	static const uint32_t EntityCounts[SizeCount];
+
+	struct Result
+	{
+		float BulkMillis = 0.0f;
+		float PerEntityMillis = 0.0f;
+		bool Matches = true;
+	};
+
+	Result m_Results[SizeCount];
+};
@@ -0,0 +1,149 @@
+#include "ShaderCompileBenchmark.h"
+
+#include <imgui/imgui.h>
+
+#include <fstream>
+#include <sstream>
+#include <chrono>
+#include <filesystem>
+
+ShaderCompileBenchmark::ShaderCompileBenchmark()
+	: Layer("ShaderCompileBenchmark")
+{
+}
+
+void ShaderCompileBenchmark::OnAttach()
+{
+	DY_PROFILE_FUNCTION();
+
+	std::ifstream in("assets/shaders/Texture.glsl");
+	std::stringstream stream;
+	stream << in.rdbuf();
+	std::string source = stream.str();
+
+	// Split the combined file at its stage markers
+	size_t fragment = source.find("#type fragment");
+	DY_ASSERT(fragment != std::string::npos, "Texture.glsl has no fragment stage!");
+	m_VertexSource = source.substr(source.find('\n') + 1, fragment - source.find('\n') - 1);
+	m_FragmentSource = source.substr(source.find('\n', fragment) + 1);
+
+	// The variants are thrown away after each run, caching them would only time the disk writes
+	// and fill the cache with binaries nobody loads again
+	m_BinaryCacheWasEnabled = Dymatic::Shader::IsBinaryCacheEnabled();
+	Dymatic::Shader::SetBinaryCacheEnabled(false);
+	RemoveCachedVariants();
+}
+
+void ShaderCompileBenchmark::OnDetach()
+{
+	DY_PROFILE_FUNCTION();
+
+	m_Shaders.clear();
+	Dymatic::Shader::SetBinaryCacheEnabled(m_BinaryCacheWasEnabled);
+}
+
+void ShaderCompileBenchmark::RemoveCachedVariants()
+{
+	// Left behind by runs from before the cache could be turned off
+	std::error_code error;
+	for (auto& entry : std::filesystem::directory_iterator("assets/cache/shader/opengl", error))
+	{
+		if (entry.path().filename().string().rfind("CompileBenchmark", 0) == 0)
+			std::filesystem::remove(entry.path(), error);
+	}
+}
+
+void ShaderCompileBenchmark::GenerateVariants()
+{
+	// Unique defines per run keep driver caches from hiding the compile cost
+	m_RunIndex++;
+	uint64_t launch = (uint64_t)std::chrono::system_clock::now().time_since_epoch().count();
+	m_VariantDefines.clear();
+	for (uint32_t i = 0; i < ShaderCount; i++)
+	{
+		std::stringstream defines;
+		defines << "#define VARIANT " << i << "\n#define RUN " << m_RunIndex << " // " << launch << "\n";
+		m_VariantDefines.push_back(defines.str());
+	}
+}
+
+static std::string InjectDefines(const std::string& source, const std::string& defines)
+{
+	// Defines have to follow the #version line
+	size_t versionEnd = source.find('\n', source.find("#version")) + 1;
+	return source.substr(0, versionEnd) + defines + source.substr(versionEnd);
+}
+
+void ShaderCompileBenchmark::RunSerial()
+{
+	DY_PROFILE_FUNCTION();
+
+	GenerateVariants();
+	m_Shaders.clear();
+
+	Dymatic::Timer timer;
+	for (uint32_t i = 0; i < ShaderCount; i++)
+	{
+		std::string name = "CompileBenchmark" + std::to_string(i);
+		m_Shaders.push_back(Dymatic::Shader::Create(name, InjectDefines(m_VertexSource, m_VariantDefines[i]), InjectDefines(m_FragmentSource, m_VariantDefines[i])));
+	}
+	m_SerialMillis = timer.ElapsedMillis();
+
+	DY_INFO("Serial compilation of {0} shaders: {1}ms", ShaderCount, m_SerialMillis);
+}
+
+void ShaderCompileBenchmark::StartBatch()
+{
+	DY_PROFILE_FUNCTION();
+
+	GenerateVariants();
+	m_Shaders.clear();
+
+	m_BatchTimer.Reset();
+	for (uint32_t i = 0; i < ShaderCount; i++)
+	{
+		std::string name = "CompileBenchmark" + std::to_string(i);
+		m_Shaders.push_back(Dymatic::Shader::CreateAsync(name, InjectDefines(m_VertexSource, m_VariantDefines[i]), InjectDefines(m_FragmentSource, m_VariantDefines[i])));
+	}
+	m_BatchIssueMillis = m_BatchTimer.ElapsedMillis();
+	m_BatchFrames = 0;
+	m_BatchRunning = true;
+}
+
+void ShaderCompileBenchmark::OnUpdate(Dymatic::Timestep)
+{
+	DY_PROFILE_FUNCTION();
+
+	if (!m_BatchRunning)
+		return;
+
+	m_BatchFrames++;
+
+	bool ready = true;
+	for (auto& shader : m_Shaders)
+		ready &= shader->IsReady();
+
+	if (ready)
+	{
+		m_BatchRunning = false;
+		m_BatchMillis = m_BatchTimer.ElapsedMillis();
+		DY_INFO("Batch compilation of {0} shaders: {1}ms over {2} frames ({3}ms to issue)", ShaderCount, m_BatchMillis, m_BatchFrames, m_BatchIssueMillis);
+	}
+}
+
+void ShaderCompileBenchmark::OnImGuiRender()
+{
+	DY_PROFILE_FUNCTION();
+
+	ImGui::Begin("Shader Compile Benchmark");
+	ImGui::Text("Shaders: %d", ShaderCount);
+	if (ImGui::Button("Compile Serial") && !m_BatchRunning)
+		RunSerial();
+	ImGui::SameLine();
+	if (ImGui::Button("Compile Batch") && !m_BatchRunning)
+		StartBatch();
+
+	ImGui::Text("Serial: %.2fms", m_SerialMillis);
+	ImGui::Text("Batch: %.2fms over %d frames (%.2fms to issue)", m_BatchMillis, m_BatchFrames, m_BatchIssueMillis);
+	ImGui::End();
+}
@@ -0,0 +1,40 @@
+#pragma once
+
+#include "Dymatic.h"
+
+// Compiles 40 variants of Texture.glsl one after another and as one batch through
+// Shader::CreateAsync, reporting total time and how many frames the batch was spread over.
+// The program binary cache is off while attached, so every run measures compilation.
+class ShaderCompileBenchmark : public Dymatic::Layer
+{
+public:
+	ShaderCompileBenchmark();
+	virtual ~ShaderCompileBenchmark() = default;
+
+	virtual void OnAttach() override;
+	virtual void OnDetach() override;
+
+	void OnUpdate(Dymatic::Timestep ts) override;
+	virtual void OnImGuiRender() override;
+private:
+	void GenerateVariants();
+	void RunSerial();
+	void StartBatch();
+	void RemoveCachedVariants();
+private:
+	static const uint32_t ShaderCount = 40;
+
+	std::string m_VertexSource, m_FragmentSource;
+	std::vector<std::string> m_VariantDefines;
+	uint32_t m_RunIndex = 0;
+	bool m_BinaryCacheWasEnabled = true;
+
+	std::vector<Dymatic::Ref<Dymatic::Shader>> m_Shaders;
+
+	float m_SerialMillis = 0.0f;
+
+	bool m_BatchRunning = false;
+	Dymatic::Timer m_BatchTimer;
+	float m_BatchIssueMillis = 0.0f, m_BatchMillis = 0.0f;
+	uint32_t m_BatchFrames = 0;
+};
@@ -0,0 +1,106 @@
+#include "TextureLoadBenchmark.h"
+
+#include <imgui/imgui.h>
+
+static const char* s_BenchmarkTexturePath = "assets/textures/Checkerboard.png";
+
+TextureLoadBenchmark::TextureLoadBenchmark()
+	: Layer("TextureLoadBenchmark"), m_CameraController(1280.0f / 720.0f)
+{
+}
+
+void TextureLoadBenchmark::OnAttach()
+{
+	DY_PROFILE_FUNCTION();
+}
+
+void TextureLoadBenchmark::OnDetach()
+{
+	DY_PROFILE_FUNCTION();
+
+	m_Textures.clear();
+}
+
+void TextureLoadBenchmark::RunSerial()
+{
+	DY_PROFILE_FUNCTION();
+
+	m_Textures.clear();
+
+	Dymatic::Timer timer;
+	for (int i = 0; i < m_TextureCount; i++)
+		m_Textures.push_back(Dymatic::Texture2D::Create(s_BenchmarkTexturePath));
+	m_SerialMillis = timer.ElapsedMillis();
+
+	DY_INFO("Serial load of {0} textures: {1}ms", m_TextureCount, m_SerialMillis);
+}
+
+void TextureLoadBenchmark::StartAsync()
+{
+	DY_PROFILE_FUNCTION();
+
+	m_Textures.clear();
+	m_AsyncLoadedCount = 0;
+	m_AsyncWorstFrameMillis = 0.0f;
+	m_AsyncRunning = true;
+	m_AsyncTimer.Reset();
+
+	// Callbacks run on the render thread from Texture2D::ProcessAsyncLoads
+	for (int i = 0; i < m_TextureCount; i++)
+		m_Textures.push_back(Dymatic::Texture2D::CreateAsync(s_BenchmarkTexturePath, [this](const Dymatic::Ref<Dymatic::Texture2D>&) { m_AsyncLoadedCount++; }));
+}
+
+void TextureLoadBenchmark::OnUpdate(Dymatic::Timestep ts)
+{
+	DY_PROFILE_FUNCTION();
+
+	m_CameraController.OnUpdate(ts);
+
+	if (m_AsyncRunning)
+	{
+		m_AsyncWorstFrameMillis = std::max(m_AsyncWorstFrameMillis, ts.GetMilliseconds());
+		if (m_AsyncLoadedCount == (uint32_t)m_Textures.size())
+		{
+			m_AsyncRunning = false;
+			m_AsyncMillis = m_AsyncTimer.ElapsedMillis();
+			DY_INFO("Async load of {0} textures: {1}ms (worst frame {2}ms)", m_TextureCount, m_AsyncMillis, m_AsyncWorstFrameMillis);
+		}
+	}
+
+	Dymatic::RenderCommand::SetClearColor({ 0.1f, 0.1f, 0.1f, 1 });
+	Dymatic::RenderCommand::Clear();
+
+	// Textures that are not uploaded yet are drawn as white quads
+	Dymatic::Renderer2D::BeginScene(m_CameraController.GetCamera());
+	const int columns = 25;
+	for (size_t i = 0; i < m_Textures.size(); i++)
+	{
+		glm::vec2 position = { -2.5f + (i % columns) * 0.2f, 1.5f - (i / columns) * 0.2f };
+		Dymatic::Renderer2D::DrawQuad(position, { 0.18f, 0.18f }, m_Textures[i]);
+	}
+	Dymatic::Renderer2D::EndScene();
+}
+
+void TextureLoadBenchmark::OnImGuiRender()
+{
+	DY_PROFILE_FUNCTION();
+
+	ImGui::Begin("Texture Load Benchmark");
+	ImGui::DragInt("Texture Count", &m_TextureCount, 1.0f, 1, 5000);
+	if (ImGui::Button("Load Serial"))
+		RunSerial();
+	ImGui::SameLine();
+	if (ImGui::Button("Load Async") && !m_AsyncRunning)
+		StartAsync();
+
+	ImGui::Text("Worker Threads: %d", Dymatic::JobSystem::GetWorkerCount());
+	ImGui::Text("Serial: %.2fms", m_SerialMillis);
+	ImGui::Text("Async: %.2fms (worst frame %.2fms)", m_AsyncMillis, m_AsyncWorstFrameMillis);
+	ImGui::Text("Pending: %d", Dymatic::Texture2D::GetPendingAsyncLoads());
+	ImGui::End();
+}
+
+void TextureLoadBenchmark::OnEvent(Dymatic::Event& e)
+{
+	m_CameraController.OnEvent(e);
+}
@@ -0,0 +1,35 @@
+#pragma once
+
+#include "Dymatic.h"
+
+// Loads the same set of images synchronously and through Texture2D::CreateAsync
+// and reports total load time and the worst frame time seen while loading.
+class TextureLoadBenchmark : public Dymatic::Layer
+{
+public:
+	TextureLoadBenchmark();
+	virtual ~TextureLoadBenchmark() = default;
+
+	virtual void OnAttach() override;
+	virtual void OnDetach() override;
+
+	void OnUpdate(Dymatic::Timestep ts) override;
+	virtual void OnImGuiRender() override;
+	void OnEvent(Dymatic::Event& e) override;
+private:
+	void RunSerial();
+	void StartAsync();
+private:
+	Dymatic::OrthographicCameraController m_CameraController;
+
+	std::vector<Dymatic::Ref<Dymatic::Texture2D>> m_Textures;
+	int m_TextureCount = 500;
+
+	float m_SerialMillis = 0.0f;
+
+	bool m_AsyncRunning = false;
+	Dymatic::Timer m_AsyncTimer;
+	float m_AsyncMillis = 0.0f;
+	float m_AsyncWorstFrameMillis = 0.0f;
+	uint32_t m_AsyncLoadedCount = 0;
+};